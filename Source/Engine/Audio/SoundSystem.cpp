@@ -11,16 +11,28 @@
 #include "SoundSystem.h"
 #include "SoundLibrary.h"
 #include "Engine/GlowEngine.h"
+#include "Engine/Platform/Platform.h"
 #include "fmod/fmod.hpp"
 
 // setup FMOD 
 Audio::SoundSystem::SoundSystem() : System("Audio System")
 {
+  // fmod only needs its update calls to not overlap, so this can run next to the main thread systems
+  writesResource(Systems::Resource::Audio);
+  SetMainThreadOnly(false);
+
   lib = engine->getSoundLibrary();
   musicChannel = nullptr;
   soundChannel = nullptr;
 
   FMOD_RESULT result = FMOD::System_Create(&system);
+
+  // headless runs still play sounds so channels behave the same, they just go nowhere
+  if (Platform::IsHeadless())
+  {
+    system->setOutput(FMOD_OUTPUTTYPE_NOSOUND);
+  }
+
   result = system->init(512, FMOD_INIT_NORMAL, nullptr);
 
   // create FMOD sound objects from the library automagically
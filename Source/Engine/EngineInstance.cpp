@@ -9,6 +9,7 @@
 #include "stdafx.h"
 #include "EngineInstance.h"
 #include "GlowEngine.h"
+#include "WorldContext.h"
 
 Engine::GlowEngine* EngineInstance::engine = nullptr;
 
@@ -27,15 +28,27 @@ void EngineInstance::setup(Engine::GlowEngine* newEngine)
 
 bool EngineInstance::IsPlaying()
 {
-  return EngineInstance::getEngine()->isPlaying();
+  return Engine::WorldContext::Current() || EngineInstance::getEngine()->isPlaying();
 }
 
 bool EngineInstance::IsPaused()
 {
-  return EngineInstance::getEngine()->IsPaused();
+  return !Engine::WorldContext::Current() && EngineInstance::getEngine()->IsPaused();
 }
 
 bool EngineInstance::GameWindowIsFocused()
 {
   return EngineInstance::getEngine()->GameWindowIsFocused();
 }
+
+float EngineInstance::GetDeltaTime()
+{
+  Engine::WorldContext* world = Engine::WorldContext::Current();
+  return world ? world->getDeltaTime() : EngineInstance::getEngine()->getDeltaTime();
+}
+
+// worlds update on the thread stepping them, so they have none
+Jobs::JobSystem* EngineInstance::GetJobSystem()
+{
+  return Engine::WorldContext::Current() ? nullptr : EngineInstance::getEngine()->getJobSystem();
+}
@@ -15,6 +15,11 @@ namespace Engine
   class GlowEngine;
 }
 
+namespace Jobs
+{
+  class JobSystem;
+}
+
 class EngineInstance
 {
 
@@ -23,10 +28,15 @@ class EngineInstance
     static Engine::GlowEngine* getEngine();
     static void setup(Engine::GlowEngine* engine);
 
+    // a world stepping on this thread is always playing, see Engine::WorldContext
     static bool IsPlaying();
     static bool IsPaused();
     static bool GameWindowIsFocused();
 
+    // the fixed step and job system of whatever is stepping on this thread, a world or the engine
+    static float GetDeltaTime();
+    static Jobs::JobSystem* GetJobSystem();
+
   private:
 
     static Engine::GlowEngine* engine;
@@ -32,11 +32,16 @@ void Entities::Actor::init()
 {
   engine = EngineInstance::getEngine();
   renderer = engine->getRenderer();
-  addComponent(new Components::BoxCollider({1,1,1},false));
-  addComponent(physics = new Components::Physics());
-  addComponent(transform = new Components::Transform());
-  addComponent(sprite = new Components::Sprite3D());
-  sprite->setModel("Cube");
+
+  // copies of an archetype keep its components, an actor only adds the ones it is missing
+  if (!get<Components::Collider>())
+    addComponent(new Components::BoxCollider({1,1,1},false));
+  if (!physics)
+    addComponent(new Components::Physics());
+  if (!transform)
+    addComponent(new Components::Transform());
+  if (!sprite)
+    addComponent(new Components::Sprite3D());
 }
 
 // ** Physics ** //
@@ -59,7 +64,7 @@ void Entities::Actor::setAnchored(bool val)
 // set the model
 void Entities::Actor::setModel(std::string name)
 {
-  sprite->setModel(name);
+  get<Components::Sprite3D>()->setModel(name);
 }
 
 // ** Textures ** //
@@ -90,7 +95,7 @@ void Entities::Actor::setLightSize(float size)
 
 void Entities::Actor::setHitboxSize(Vector3D size)
 {
-  Components::BoxCollider* collider = reinterpret_cast<Components::BoxCollider*>(getComponentOfType(Collider, this));
+  Components::BoxCollider* collider = get<Components::BoxCollider>();
 
   if (collider)
   {
@@ -101,7 +106,7 @@ void Entities::Actor::setHitboxSize(Vector3D size)
 
 void Entities::Actor::setStatic(bool val)
 {
-  Components::Collider* collider = getComponentOfType(Collider, this);
+  Components::Collider* collider = get<Components::Collider>();
 
   if (collider)
   {
@@ -111,7 +116,7 @@ void Entities::Actor::setStatic(bool val)
 
 Vector3D Entities::Actor::getHitboxSize()
 {
-  Components::BoxCollider* collider = reinterpret_cast<Components::BoxCollider*>(getComponentOfType(Collider, this));
+  Components::BoxCollider* collider = get<Components::BoxCollider>();
 
   if (collider)
   {
@@ -125,7 +130,12 @@ void Entities::Actor::createPointLight()
 {
   light = new PointLight();
   updatePointLight((getPosition() + Vector3D{0,20,0}), 50, { 2.5,1.5,1,1 });
-  renderer->addPointLight(light);
+
+  // headless there's nothing to light, the light still keeps its settings
+  if (renderer)
+  {
+    renderer->addPointLight(light);
+  }
 }
 
 // create a new pointlight data struct and add it to the renderer's list of lights
@@ -134,7 +144,11 @@ void Entities::Actor::updatePointLight(Vector3D pos, float size, DirectX::XMFLOA
   light->pointLight.color = color;
   light->pointLight.position = { pos.x,pos.y,pos.z };
   light->pointLight.size = size;
-  renderer->updatePointLight(light);
+
+  if (renderer)
+  {
+    renderer->updatePointLight(light);
+  }
 }
 
 
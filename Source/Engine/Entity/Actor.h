@@ -51,9 +51,6 @@ namespace Entities
     void updatePointLight(Vector3D pos, float size, DirectX::XMFLOAT4 color);
     void setLightSize(float size);
 
-    // ** General ** //
-    void setName(std::string name) { this->name = name; }
-
     // ** Collision ** //
     void setHitboxSize(Vector3D size);
     void setStatic(bool val);
@@ -22,14 +22,14 @@ Components::BoundingBox::BoundingBox()
 
 void Components::BoundingBox::update()
 {
-  if (!parent->sprite)
+  if (!parent->sprite || !parent->sprite->getModel())
     return;
 
   // update our bounding box to be the mesh
-  Components::Transform transform = *parent->transform;
+  const Components::Transform& transform = *parent->transform;
 
   // Find the model in the map
-  const std::vector<Vertex> vertices = parent->sprite->getModel()->allVertices;
+  const std::vector<Vertex>& vertices = parent->sprite->getModel()->allVertices;
 
   if (vertices.empty())
     return;
@@ -47,8 +47,8 @@ void Components::BoundingBox::update()
     if (vertex.z > max.z) max.z = vertex.z;
   }
 
-  min = min + transform.getPosition() - transform.getScale();
-  max = max + transform.getPosition() + transform.getScale();
+  min = min + transform.getWorldPosition() - transform.getScale();
+  max = max + transform.getWorldPosition() + transform.getScale();
 }
 
 Components::BoundingBox* Components::BoundingBox::clone()
@@ -16,6 +16,8 @@ namespace Components
 
   public:
 
+    static constexpr ComponentType StaticType = ComponentType::BoundingBox;
+
     BoundingBox();
 
     void update();
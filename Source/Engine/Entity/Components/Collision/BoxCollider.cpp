@@ -38,6 +38,8 @@ Components::BoxCollider::BoxCollider(const BoxCollider& other)
   scale = other.scale;
   meshScale = other.meshScale;
   colliderIsStatic = other.colliderIsStatic;
+  layer = other.layer;
+  mask = other.mask;
   init();
 }
 
@@ -62,12 +64,8 @@ void Components::BoxCollider::init()
 /// <returns></returns>
 bool Components::BoxCollider::isColliding(const Components::Collider* other)
 {
-  Components::Transform* otherTransform = getComponentOfType(Transform, other->parent);
-  Components::Transform* transform = getComponentOfType(Transform, parent);
-
-  Vector3D position = transform->getPosition();
-  Vector3D otherPosition = otherTransform->getPosition();
-  const BoxCollider* otherBox = dynamic_cast<const BoxCollider*>(other);
+  // box colliders are the only collider type, so the cast is safe without RTTI
+  const BoxCollider* otherBox = static_cast<const BoxCollider*>(other);
 
   return isAABBColliding(*otherBox);
 }
@@ -79,24 +77,12 @@ bool Components::BoxCollider::isColliding(const Components::Collider* other)
 /// <returns></returns>
 bool Components::BoxCollider::isAABBColliding(const BoxCollider& other) 
 {
-  Components::Transform* otherTransform = getComponentOfType(Transform, other.parent);
-  Components::Transform* transform = getComponentOfType(Transform, parent);
-
-  Vector3D position = transform->getPosition();
-  Vector3D otherPosition = otherTransform->getPosition();
-
-  Vector3D minA = position - scale * 0.5f;
-  Vector3D maxA = position + scale * 0.5f;
-
-  Vector3D otherScale = other.scale;
-  Vector3D minB = otherPosition - otherScale * 0.5f;
-  Vector3D maxB = (otherPosition + otherScale * 0.5f);
+  float min[3], max[3], otherMin[3], otherMax[3];
+  getBounds(min, max);
+  other.getBounds(otherMin, otherMax);
 
-  bool overlapX = (minA.x < maxB.x) && (maxA.x > minB.x);
-  bool overlapY = (minA.y <= maxB.y) && (maxA.y > minB.y);
-  bool overlapZ = (minA.z < maxB.z) && (maxA.z > minB.z);
-
-  return overlapX && overlapY && overlapZ;
+  World::Penetration overlap;
+  return World::BoxBatch::Overlap(min, max, otherMin, otherMax, overlap);
 }
 
 /// <summary>
@@ -106,50 +92,28 @@ bool Components::BoxCollider::isAABBColliding(const BoxCollider& other)
 void Components::BoxCollider::onCollide(const Components::Collider* other)
 {
   // Get the physics and transform components
-  Components::Physics* physics = getComponentOfType(Physics, parent);
+  Components::Physics* physics = parent->get<Components::Physics>();
 
   if (!physics)
   {
     return;
   }
 
-  Components::Transform* transform = getComponentOfType(Transform, parent);
-  Components::Transform* otherTransform = getComponentOfType(Transform, other->parent);
-  const BoxCollider* otherBox = dynamic_cast<const BoxCollider*>(other);
+  Components::Transform* transform = parent->get<Components::Transform>();
+  Components::Transform* otherTransform = other->parent->get<Components::Transform>();
 
   // Get the current position and velocity
   Vector3D currentPosition = transform->getPosition();
   Vector3D oldPosition = transform->getOldPosition();
   Vector3D velocity = physics->getVelocity();
 
-  // Get the positions of both colliding objects
-  Vector3D otherPosition = otherTransform->getPosition();
-
-  // Calculate the half-sizes
-  Vector3D halfSizeA = scale * 0.5f;
-  Vector3D otherScale = otherBox->scale;
-  Vector3D halfSizeB = otherScale * 0.5f;
-
-  // Calculate the penetration depths along each axis
-  float penetrationX = halfSizeA.x + halfSizeB.x - std::abs(currentPosition.x - otherPosition.x);
-  float penetrationY = halfSizeA.y + halfSizeB.y - std::abs(currentPosition.y - otherPosition.y);
-  float penetrationZ = halfSizeA.z + halfSizeB.z - std::abs(currentPosition.z - otherPosition.z);
+  // which side of the other collider we're on is decided in world space
+  Vector3D worldPosition = transform->getWorldPosition();
+  Vector3D otherPosition = otherTransform->getWorldPosition();
 
-  // Determine the primary collision axis by finding the smallest penetration depth
-  float minPenetration = penetrationX;
-  Vector3D collisionNormal = Vector3D(1, 0, 0);
-
-  if (penetrationY < minPenetration)
-  {
-    collisionNormal = Vector3D(0, 1, 0); // Y-axis
-    minPenetration = penetrationY;
-  }
-
-  if (penetrationZ < minPenetration)
-  {
-    collisionNormal = Vector3D(0, 0, 1); // Z-axis
-    minPenetration = penetrationZ;
-  }
+  // the axis we overlap the least on and our share of the depth, measured when this pair was resolved
+  float minPenetration = penetration.depth;
+  Vector3D collisionNormal = Vector3D(penetration.axis == 0 ? 1.f : 0.f, penetration.axis == 1 ? 1.f : 0.f, penetration.axis == 2 ? 1.f : 0.f);
 
   if (minPenetration <= 0) 
     return;
@@ -158,7 +122,7 @@ void Components::BoxCollider::onCollide(const Components::Collider* other)
   velocity = velocity - collisionNormal * (velocity.dot(collisionNormal));
 
   // If the smallest penetration is in the Y-axis, handle grounding and position adjustment
-  if (collisionNormal.y == 1 && currentPosition.y > otherPosition.y)
+  if (collisionNormal.y == 1 && worldPosition.y > otherPosition.y)
   {
     physics->setGrounded(true);
     velocity.y = 0;
@@ -189,7 +153,7 @@ void Components::BoxCollider::onCollide(const Components::Collider* other)
 void Components::BoxCollider::setHitboxSize(Vector3D hitboxSize)
 {
   calculateScale();
-  meshScale = hitboxSize / getComponentOfType(Transform, parent)->getScale();
+  meshScale = hitboxSize / parent->get<Components::Transform>()->getScale();
   scale = hitboxSize;
   dirty = false;
 }
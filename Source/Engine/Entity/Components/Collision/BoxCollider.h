@@ -20,6 +20,9 @@ namespace Components
 
   public:
 
+    static constexpr ComponentType StaticType = ComponentType::BoxCollider;
+    COMPONENT_POOL(BoxCollider)
+
     BoxCollider(Vector3D newScale = { 1,1,1 }, bool isStatic = true, bool autoResize = true);
     BoxCollider(const BoxCollider& other);
 
@@ -15,72 +15,172 @@ void Components::Collider::update()
 {
   // if we dont have a physics object, auto-mark as a static collider
   // if we do, and it's not anchored, then we are a moving collider
-  Components::Physics* physics = getComponentOfType(Physics, parent);
-  Components::Transform* transform = getComponentOfType(Transform, parent);
+  Components::Physics* physics = parent->get<Components::Physics>();
+  Components::Transform* transform = parent->get<Components::Transform>();
 
   // if we have no physics, no point in being not static
   if (!physics)
   {
     colliderIsStatic = true;
   }
+
+  // the editor can flip static through its variable, so keep the entity flag queries use in step here
+  parent->setFlag(Entities::StaticCollider, colliderIsStatic);
+}
+
+// when another collider starts touching us we add it to our list of colliding objects
+void Components::Collider::enterCollision(const Collider* other)
+{
+  if (!isCollidingWith(other))
+  {
+    collidingObjects.push_back(other->parent->getHandle());
+  }
+
+  // component function callback
+  onFirstCollide(other);
+}
+
+// every frame another collider touches us, including the first one
+void Components::Collider::updateCollision(const Collider* other, const World::Penetration& overlap)
+{
+  penetration = overlap;
+  onCollide(other);
+}
+
+void Components::Collider::ResolveContact(Collider* first, Collider* second)
+{
+  // the narrowphase's depth is from before any contact was resolved, and a body in a stack is in several
+  float firstMin[3], firstMax[3], secondMin[3], secondMax[3];
+  first->getBounds(firstMin, firstMax);
+  second->getBounds(secondMin, secondMax);
+
+  // pushed apart already by an earlier contact, the pair still touches until the next narrowphase says otherwise
+  World::Penetration overlap;
+  if (!World::BoxBatch::Overlap(firstMin, firstMax, secondMin, secondMax, overlap))
+  {
+    overlap.depth = 0;
+  }
+
+  // two bodies each move half the way out instead of both moving all of it
+  if (first->isPushable() && second->isPushable())
+  {
+    overlap.depth *= 0.5f;
+  }
+
+  first->updateCollision(second, overlap);
+  second->updateCollision(first, overlap);
+}
+
+bool Components::Collider::isPushable() const
+{
+  const Components::Physics* physics = parent->get<Components::Physics>();
+  return physics && !colliderIsStatic && !physics->isAnchored();
 }
 
 // when we leave a collision, we erase the other collider from the active list
 // we also call our collider callback for anything specific
 void Components::Collider::leaveCollision(const Components::Collider* other)
 {
-  // erase the reference to the other collider since we've stopped colliding
-  collidingObjects.erase(other);
-  collided = false;
-  colliding = false;
+  forgetCollision(other->parent->getHandle());
 
-  // if we have a physics component, then we want to do some falling logic
-  Components::Physics* physics = getComponentOfType(Physics, parent);
-  Components::Transform* transform = getComponentOfType(Transform, parent);
-  Components::Transform* otherTransform = getComponentOfType(Transform, other->parent);
+  // component function callback
+  onLeaveCollide(other);
+}
 
-  if (physics)
+void Components::Collider::forgetCollision(Entities::EntityHandle handle)
+{
+  // order doesn't matter so swap and pop
+  auto it = std::find(collidingObjects.begin(), collidingObjects.end(), handle);
+  if (it != collidingObjects.end())
   {
-    bool grounded = false;
-    for (auto* collider : collidingObjects)
+    *it = collidingObjects.back();
+    collidingObjects.pop_back();
+  }
+
+  updateGrounded();
+}
+
+// if we have a physics component, we stay grounded while any collider we still touch is under us
+void Components::Collider::updateGrounded()
+{
+  Components::Physics* physics = parent->get<Components::Physics>();
+  if (!physics)
+    return;
+
+  Components::Transform* transform = parent->get<Components::Transform>();
+  bool grounded = false;
+
+  for (const Entities::EntityHandle& handle : collidingObjects)
+  {
+    Entities::Entity* other = handle.get();
+    Components::Transform* otherTransform = other ? other->get<Components::Transform>() : nullptr;
+    if (!otherTransform)
+      continue;
+
+    Vector3D collisionNormal = transform->getWorldPosition() - otherTransform->getWorldPosition();
+    collisionNormal.normalize();
+    if (collisionNormal.y > 0)
     {
-      Vector3D collisionNormal = transform->getPosition() - otherTransform->getPosition();
-      collisionNormal.normalize();
-      if (collisionNormal.y > 0)
-      {
-        grounded = true;
-        break;
-      }
+      grounded = true;
+      break;
     }
-    physics->setGrounded(grounded);
   }
 
-  // componenet function callback
-  onLeaveCollide(other);
+  physics->setGrounded(grounded);
 }
 
-// when we enter a collision, we add the collider to its list of colliding objects
-// we then call its resolution callback for entering and then colliding
-void Components::Collider::updateCollision(const Collider* other)
+// pick our layer from the project's layers, and tick the layers we collide with
+void Components::Collider::display()
 {
-  // when we enter a collision, this is triggered only once
-  if (!collided)
+  World::CollisionLayers& layers = World::CollisionLayers::instance();
+
+  if (ImGui::BeginCombo("Layer", layers.getName(layer).c_str()))
   {
-    collided = true;
-    collidingObjects.insert(other);
-    onFirstCollide(other);
+    for (int i = 0; i < layers.getCount(); ++i)
+    {
+      if (ImGui::Selectable(layers.getName(i).c_str(), i == layer))
+      {
+        setLayer(i);
+      }
+    }
+    ImGui::EndCombo();
   }
 
-  // call the normal collision resolution callback
-  onCollide(other);
-  colliding = true;
+  if (ImGui::TreeNode("Collides With"))
+  {
+    for (int i = 0; i < layers.getCount(); ++i)
+    {
+      bool collides = (mask >> i) & 1u;
+
+      // layers the project never lets touch ours can't be ticked on
+      ImGui::BeginDisabled(!layers.canCollide(layer, i));
+      if (ImGui::Checkbox(layers.getName(i).c_str(), &collides))
+      {
+        mask = collides ? (mask | (1u << i)) : (mask & ~(1u << i));
+      }
+      ImGui::EndDisabled();
+    }
+    ImGui::TreePop();
+  }
+}
+
+void Components::Collider::CustomLoad(const nlohmann::json saveData)
+{
+  if (saveData.contains("Layer")) setLayer(saveData["Layer"].get<int>());
+  if (saveData.contains("Mask")) setMask(saveData["Mask"].get<std::uint32_t>());
+}
+
+void Components::Collider::CustomSave(nlohmann::json& saveData) const
+{
+  saveData["Layer"] = layer;
+  saveData["Mask"] = mask;
 }
 
 // call debug render if we have it enabled
 void Components::Collider::render()
 {
   Graphics::Renderer* renderer = EngineInstance::getEngine()->getRenderer();
-  Components::Transform* transform = getComponentOfType(Transform, parent);
+  Components::Transform* transform = parent->get<Components::Transform>();
 
   // recalculate the real scale of the mesh when our transform changes
   // this can be modified to only be done if the scale changes in the future
@@ -113,13 +213,23 @@ void Components::Collider::render()
 void Components::Collider::calculateScale()
 {
   // find out vertices
-  Components::Sprite3D* sprite = getComponentOfType(Sprite3D, parent);
+  // only read, so a sprite shared with a prefab stays shared
+  const Components::Sprite3D* sprite = parent->sprite;
 
   if (!sprite)
     return;
 
-  const std::vector<Vertex> vertices = sprite->getModel()->allVertices;
-  Components::Transform& transform = *getComponentOfType(Transform, parent);
+  Components::Transform& transform = *parent->get<Components::Transform>();
+
+  // without a model the hitbox is just our scale
+  Models::Model* model = sprite->getModel();
+  if (!model)
+  {
+    scale = transform.getScale();
+    return;
+  }
+
+  const std::vector<Vertex>& vertices = model->allVertices;
 
   // Calculate the scale of the 
   if (vertices.empty())
@@ -130,14 +240,14 @@ void Components::Collider::calculateScale()
 
 
 
-  Components::BoundingBox* boundingBox = getComponentOfType(BoundingBox, parent);
-  dirty = getComponentOfType(Transform, parent)->isDirty();
+  Components::BoundingBox* boundingBox = parent->get<Components::BoundingBox>();
+  dirty = parent->get<Components::Transform>()->isDirty();
 }
 
 void Components::Collider::CalculateMeshScale(Vector3D hitboxSize)
 {
   calculateScale();
-  meshScale = hitboxSize / getComponentOfType(Transform,parent)->getScale();
+  meshScale = hitboxSize / parent->get<Components::Transform>()->getScale();
   scale = hitboxSize;
   dirty = false;
 }
@@ -145,12 +255,7 @@ void Components::Collider::CalculateMeshScale(Vector3D hitboxSize)
 
 bool Components::Collider::isColliding()
 {
-  return colliding;
-}
-
-bool Components::Collider::hasCollided()
-{
-  return collided;
+  return !collidingObjects.empty();
 }
 
 bool Components::Collider::isDirty()
@@ -163,7 +268,7 @@ bool Components::Collider::autoSizeEnabled()
   return autoSize;
 }
 
-bool Components::Collider::isStatic()
+bool Components::Collider::isStatic() const
 {
   return colliderIsStatic;
 }
@@ -173,24 +278,42 @@ Vector3D Components::Collider::getHitboxSize()
   return scale;
 }
 
-Vector3D Components::Collider::getMeshScale()
+void Components::Collider::getBounds(float min[3], float max[3]) const
 {
-  return meshScale;
+  // the hitbox is sized against our own scale, so a parent's scale stretches it on top
+  const Components::Transform* transform = parent->get<Components::Transform>();
+  const Vector3D position = transform->getWorldPosition();
+  const Vector3D localScale = transform->getScale();
+  const Vector3D worldScale = transform->getWorldScale();
+  const float stretch[3] = {
+    localScale.x != 0 ? worldScale.x / localScale.x : 1,
+    localScale.y != 0 ? worldScale.y / localScale.y : 1,
+    localScale.z != 0 ? worldScale.z / localScale.z : 1 };
+
+  const float center[3] = { position.x, position.y, position.z };
+  const float half[3] = { scale.x * stretch[0] * 0.5f, scale.y * stretch[1] * 0.5f, scale.z * stretch[2] * 0.5f };
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    min[axis] = center[axis] - half[axis];
+    max[axis] = center[axis] + half[axis];
+  }
 }
 
-const std::set<const Components::Collider*>& Components::Collider::getCollidingObjects()
+Vector3D Components::Collider::getMeshScale()
 {
-  return collidingObjects;
+  return meshScale;
 }
 
-void Components::Collider::setColliding(bool val)
+const std::vector<Entities::EntityHandle>& Components::Collider::getCollidingObjects()
 {
-  colliding = val;
+  return collidingObjects;
 }
 
-void Components::Collider::setCollided(bool val)
+bool Components::Collider::isCollidingWith(const Collider* other)
 {
-  collided = val;
+  Entities::EntityHandle handle = other->parent->getHandle();
+  return std::find(collidingObjects.begin(), collidingObjects.end(), handle) != collidingObjects.end();
 }
 
 void Components::Collider::setAutoSize(bool val)
@@ -206,4 +329,9 @@ void Components::Collider::setDirty(bool val)
 void Components::Collider::setStatic(bool val)
 {
   colliderIsStatic = val;
+
+  if (parent)
+  {
+    parent->setFlag(Entities::StaticCollider, val);
+  }
 }
@@ -8,7 +8,9 @@
 
 #pragma once
 #include "Engine/Entity/Components/Component.h"
-#include <set>
+#include "Engine/Entity/EntityHandle.h"
+#include "Engine/Systems/World/BoxBatch.h"
+#include "Engine/Systems/World/CollisionLayers.h"
 
 namespace Components
 {
@@ -18,6 +20,8 @@ namespace Components
 
   public:
 
+    static constexpr ComponentType StaticType = ComponentType::Collider;
+
     // the logic to check if we are colliding
     virtual bool isColliding(const Components::Collider* other) = 0;
     // while we are colliding
@@ -28,10 +32,20 @@ namespace Components
     virtual void onLeaveCollide(const Components::Collider* other) {};
     virtual void update();
 
-    // calls the function callback after some checks
+    // the scene's contact events; another collider started touching us, is still touching us, or stopped
+    void enterCollision(const Collider* other);
+    void updateCollision(const Collider* other, const World::Penetration& overlap);
+    // a pair still touching: both sides get the overlap measured from where they are now, since contacts
+    // resolved earlier in the frame may have pushed either one, halved when both of them can move
+    static void ResolveContact(Collider* first, Collider* second);
     void leaveCollision(const Collider* other);
-    // calls the on first collide callback after some checks
-    void updateCollision(const Collider* other);
+    // stop touching an entity that no longer exists or lost its collider, no callback is made
+    void forgetCollision(Entities::EntityHandle handle);
+
+    // layer and mask pickers, named from the project's collision layers
+    void display();
+    virtual void CustomLoad(const nlohmann::json saveData);
+    virtual void CustomSave(nlohmann::json& saveData) const;
 
     // render calls respective draw function
     void render();
@@ -43,36 +57,57 @@ namespace Components
     void CalculateMeshScale(Vector3D hitboxSize);
 
     // general getters
+    // if we are touching anything
     bool isColliding();
-    bool hasCollided();
     bool isDirty();
     bool autoSizeEnabled();
-    bool isStatic();
+    bool isStatic() const;
     Vector3D getHitboxSize();
     Vector3D getMeshScale();
+    // the box the narrowphase tests, centered on our transform's world position and stretched by any parent scale
+    void getBounds(float min[3], float max[3]) const;
     
-    const std::set<const Components::Collider*>& getCollidingObjects();
+    // handles to the entities we are touching
+    const std::vector<Entities::EntityHandle>& getCollidingObjects();
+    // if another collider's entity is in our colliding list
+    bool isCollidingWith(const Collider* other);
+
+    // the layer we are on and the layers we want to touch
+    int getLayer() const { return layer; }
+    void setLayer(int newLayer) { layer = std::clamp(newLayer, 0, World::CollisionLayers::MaxLayers - 1); }
+    std::uint32_t getMask() const { return mask; }
+    void setMask(std::uint32_t newMask) { mask = newMask; }
+    // our layer and mask combined with the project's collision matrix, what the broadphase compares
+    World::CollisionFilter getFilter() const { return World::CollisionLayers::instance().filter(layer, mask); }
 
     // general setters
-    void setColliding(bool val);
-    void setCollided(bool val);
     void setAutoSize(bool val);
     void setDirty(bool val);
     void setStatic(bool val);
 
   protected:
 
+    // grounded while something we touch is below us
+    void updateGrounded();
+    // if contacts push us, we have a body that isn't anchored
+    bool isPushable() const;
+
+    // how much of the overlap with the collider onCollide is being called for we resolve, see ResolveContact
+    World::Penetration penetration;
+
     // flags for collision
-    bool colliding = false;
-    bool collided = false;
     bool autoSize = true;
     bool dirty = true;
 
     // static colliders are not checked against any other static colliders
     bool colliderIsStatic = false;
 
-    // debug drawing 
-    std::set<const Components::Collider*> collidingObjects;
+    // collision layer, and one bit for every layer we collide with
+    int layer = 0;
+    std::uint32_t mask = World::CollisionLayers::AllLayers;
+
+    // entities we are touching; handles stay valid when they get destroyed
+    std::vector<Entities::EntityHandle> collidingObjects;
 
     // scale of the collider and original mesh scale
     Vector3D scale;
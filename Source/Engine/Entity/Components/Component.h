@@ -8,6 +8,7 @@
 
 #pragma once
 #include "Property.h"
+#include "Engine/Systems/Memory/PoolAllocator.h"
 
 namespace Entities
 {
@@ -23,6 +24,7 @@ namespace Components
   {
     public:
 
+    // one id per component class; slots, pools, system access and the factory all go by it
     enum ComponentType
     {
       Transform,
@@ -38,10 +40,31 @@ namespace Components
       None
     };
 
+      // the id of a component class; every class that can be made on its own redeclares this
+      static constexpr ComponentType StaticType = None;
+
+      // the slot a class fills on its entity; a class that specializes another one shares its base's slot, so
+      // get<Collider>() finds a BoxCollider
+      static constexpr ComponentType SlotOf(ComponentType type)
+      {
+        switch (type)
+        {
+        case BoxCollider: return Collider;
+        case PlayerBehavior: return Behavior;
+        default: return type;
+        }
+      }
+
     public:
 
       Component();
       Component(const Component& other);
+      virtual ~Component() = default;
+
+      // components come from the pools instead of the heap; registered classes get a pool of their own through
+      // COMPONENT_POOL, and a block goes back to the pool it came from
+      static void* operator new(std::size_t size) { return Memory::PoolAllocator::instance().allocate(size); }
+      static void operator delete(void* block) { Memory::PoolAllocator::deallocate(block); }
 
       void init();
       virtual void update() {};
@@ -79,6 +102,8 @@ namespace Components
       const std::vector<Variable>& getVariables() const { return variables; }
       // if this component can be simulated
       bool IsSimulation() { return simulation; }
+      // if prefab instances can use the prefab's copy of this component until they write to it
+      bool IsShareable() const { return shareable; }
 
     protected:
       
@@ -92,6 +117,8 @@ namespace Components
       int priority = 0;
       // if this component is simulated (updated when in editor or paused)
       bool simulation = true;
+      // only for components with no state of their own instance to instance, and nothing to update
+      bool shareable = false;
 
       // components have a list of variables we expose to the editor
       std::vector<Variable> variables;
@@ -115,8 +142,9 @@ public:
     return factory;
   }
 
-  void registerComponent(const std::string& type, CreatorFunc func) {
+  void registerComponent(const std::string& type, CreatorFunc func, Components::Component::ComponentType componentType) {
     creators[type] = func;
+    componentTypes[type] = componentType;
     registeredTypes.push_back(type);
   }
 
@@ -128,12 +156,22 @@ public:
     return nullptr;
   }
 
+  // get the id of a registered component class, None if it isn't registered
+  Components::Component::ComponentType getComponentType(const std::string& type) const {
+    auto it = componentTypes.find(type);
+    if (it != componentTypes.end()) {
+      return it->second;
+    }
+    return Components::Component::None;
+  }
+
   const std::vector<std::string>& getRegisteredTypes() const {
     return registeredTypes;
   }
 
 private:
   std::unordered_map<std::string, CreatorFunc> creators;
+  std::unordered_map<std::string, Components::Component::ComponentType> componentTypes;
   std::vector<std::string> registeredTypes;
 };
 
@@ -142,10 +180,14 @@ Components::Component* createInstance() {
   return new T();
 }
 
+// put in the body of a registered component class so its instances come from a pool of their own
+#define COMPONENT_POOL(CLASS) \
+    static void* operator new(std::size_t size) { return Memory::PoolAllocator::instance().allocate(size, CLASS::StaticType, sizeof(CLASS)); }
+
 #define REGISTER_COMPONENT(CLASS) \
     namespace { \
         inline bool register_##CLASS() { \
-            ComponentFactory::instance().registerComponent(#CLASS, createInstance<Components::CLASS>); \
+            ComponentFactory::instance().registerComponent(#CLASS, createInstance<Components::CLASS>, Components::CLASS::StaticType); \
             return true; \
         } \
         static const bool registered_##CLASS = register_##CLASS(); \
@@ -154,7 +196,7 @@ Components::Component* createInstance() {
 #define REGISTER_BEHAVIOR(CLASS) \
     namespace { \
         inline bool register_##CLASS() { \
-            ComponentFactory::instance().registerComponent(#CLASS, createInstance<Game::CLASS>); \
+            ComponentFactory::instance().registerComponent(#CLASS, createInstance<Game::CLASS>, Game::CLASS::StaticType); \
             return true; \
         } \
         static const bool registered_##CLASS = register_##CLASS(); \
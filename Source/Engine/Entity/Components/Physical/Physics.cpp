@@ -16,16 +16,15 @@ REGISTER_COMPONENT(Physics);
 Components::Physics::Physics()
 {
   maxVelocity = 25.f;
-  acceleration = { 0,0,0 };
-  velocity = { 0,0,0 };
-  gravity = 35.f;
   targetVelocity = { 0,0,0 };
   init();
 }
 
 Components::Physics::Physics(const Physics& other) : Component(other)
 {
-  gravity = other.gravity;
+  const World::BodyState otherState = other.getState();
+  state.gravity = otherState.gravity;
+  state.canSleep = otherState.canSleep;
   maxVelocity = other.maxVelocity;
   init();
 }
@@ -37,15 +36,31 @@ void Components::Physics::init()
   simulation = false;
   priority = 1;
 
-  AddVariable(CreateVariable("Gravity", &gravity));
-  AddVariable(CreateVariable("Acceleration", &acceleration));
-  AddVariable(CreateVariable("Velocity", &velocity));
+  AddVariable(CreateVariable("Gravity", &state.gravity));
+  AddVariable(CreateVariable("Acceleration", &state.acceleration));
+  AddVariable(CreateVariable("Velocity", &state.velocity));
   AddVariable(CreateVariable("Maximum Velocity", &maxVelocity));
+  AddVariable(CreateVariable("Can Sleep", &state.canSleep));
 }
 
+namespace
+{
+  bool Differs(const Vector3D& a, const Vector3D& b)
+  {
+    return a.x != b.x || a.y != b.y || a.z != b.z;
+  }
+}
+
+// setting the value we already have doesn't wake us, behaviors set velocity every frame
 void Components::Physics::setVelocity(Vector3D vel)
 {
-  velocity = vel;
+  if (Differs(vel, getVelocity()))
+    wake();
+
+  if (world)
+    world->setVelocity(body, vel);
+  else
+    state.velocity = vel;
 }
 
 void Components::Physics::setTargetVelocity(Vector3D vel)
@@ -55,7 +70,20 @@ void Components::Physics::setTargetVelocity(Vector3D vel)
 
 void Components::Physics::setAcceleration(Vector3D acc)
 {
-  acceleration = acc;
+  if (Differs(acc, getAcceleration()))
+    wake();
+
+  if (world)
+    world->setAcceleration(body, acc);
+  else
+    state.acceleration = acc;
+}
+
+void Components::Physics::setAccelerationY(float val)
+{
+  Vector3D acc = getAcceleration();
+  acc.y = val;
+  setAcceleration(acc);
 }
 
 void Components::Physics::addTargetVelocity(Vector3D vec)
@@ -65,59 +93,151 @@ void Components::Physics::addTargetVelocity(Vector3D vec)
 
 void Components::Physics::setVelocityX(float val)
 {
-  velocity.x = val;
+  Vector3D vel = getVelocity();
+  vel.x = val;
+  setVelocity(vel);
 }
 
 void Components::Physics::setVelocityY(float val)
 {
-  velocity.y = val;
+  Vector3D vel = getVelocity();
+  vel.y = val;
+  setVelocity(vel);
 }
 
 void Components::Physics::setVelocityZ(float val)
 {
-  velocity.z = val;
+  Vector3D vel = getVelocity();
+  vel.z = val;
+  setVelocity(vel);
 }
 
-// update velocity and transform
-void Components::Physics::update()
+const Vector3D Components::Physics::getVelocity() const
 {
-  // anchored objects don't move
-  if (anchored)
+  return world ? world->getVelocity(body) : state.velocity;
+}
+
+const Vector3D Components::Physics::getAcceleration() const
+{
+  return world ? world->getAcceleration(body) : state.acceleration;
+}
+
+float Components::Physics::getGravity() const
+{
+  return world ? world->getGravity(body) : state.gravity;
+}
+
+void Components::Physics::setGravity(float val)
+{
+  if (world)
+    world->setGravity(body, val);
+  else
+    state.gravity = val;
+}
+
+void Components::Physics::render()
+{
+}
+
+void Components::Physics::display()
+{
+  if (!world)
     return;
 
-  float dt = EngineInstance::getEngine()->getDeltaTime();
-  Components::Transform* transform = getComponentOfType(Transform, parent);
+  const Vector3D velocity = world->getVelocity(body);
+  ImGui::Text(("Moving at " + std::to_string(velocity.x) + ", " + std::to_string(velocity.y) + ", " + std::to_string(velocity.z)).c_str());
+  ImGui::Text(isSleeping() ? "Sleeping" : (isGrounded() ? "Grounded" : "Airborne"));
+}
 
+void Components::Physics::setAnchored(bool val)
+{
+  if (world)
+    world->setAnchored(body, val);
+  else
+    state.anchored = val;
+}
+
+bool Components::Physics::isAnchored() const
+{
+  return world ? world->isAnchored(body) : state.anchored;
+}
+
+void Components::Physics::setGrounded(bool val)
+{
+  if (world)
+    world->setGrounded(body, val);
+  else
+    state.grounded = val;
+}
+
+bool Components::Physics::isGrounded() const
+{
+  return world ? world->isGrounded(body) : state.grounded;
+}
+
+bool Components::Physics::isSleeping() const
+{
+  return world ? world->isSleeping(body) : state.sleeping;
+}
+
+bool Components::Physics::isRestful() const
+{
+  return world ? world->isRestful(body) : state.canSleep && state.restTime >= World::PhysicsWorld::SleepDelay;
+}
+
+void Components::Physics::sleep()
+{
+  if (world)
+  {
+    world->sleep(body);
+    return;
+  }
+
+  if (state.sleeping || !state.canSleep)
+    return;
+
+  Components::Transform* transform = parent->get<Components::Transform>();
   if (transform)
   {
-    Vector3D position = transform->getPosition();
-
-    if (!grounded)
-    {
-      // Apply gravity to the acceleration
-      acceleration.y -= gravity * dt;
-    }
-    else
-    {
-      // Reset vertical acceleration and velocity when grounded
-      acceleration.y = 0;
-      velocity.y = 0;
-    }
-
-    // calculate the final position and update old position
-    Vector3D finalPosition = position + ((velocity+acceleration) * dt);
-
-    transform->setOldPosition(position);
-    transform->setPosition(finalPosition);
+    state.sleepPosition = transform->getPosition();
   }
+
+  state.velocity = { 0,0,0 };
+  state.acceleration = { 0,0,0 };
+  state.sleeping = true;
 }
 
-void Components::Physics::render()
+void Components::Physics::wake()
 {
+  if (world)
+  {
+    world->wake(body);
+    return;
+  }
+
+  state.sleeping = false;
+  state.restTime = 0;
 }
 
-void Components::Physics::setAnchored(bool val)
+void Components::Physics::setCanSleep(bool val)
 {
-  anchored = val;
+  if (world)
+  {
+    world->setCanSleep(body, val);
+    return;
+  }
+
+  state.canSleep = val;
+  if (!val)
+    wake();
+}
+
+bool Components::Physics::getCanSleep() const
+{
+  return world ? world->getCanSleep(body) : state.canSleep;
 }
 
+World::BodyState Components::Physics::getState() const
+{
+  return world ? world->getState(body) : state;
+}
@@ -2,21 +2,27 @@
 /
 // filename: Physics.h
 // author: Callen Betts
-// brief: defines the Physics class, holds vertices and Physics data
+// brief: defines the Physics class, a handle to a body in the scene's physics world
 /
 */
 
 #pragma once
 #include "Engine/Entity/Components/Component.h"
+#include "Engine/Systems/World/PhysicsWorld.h"
 
 namespace Components
 {
 
+  // while the game runs our state lives in the scene's physics world and everything here reaches through to it;
+  // in the editor, or before we're in a scene, it lives in state
   class Physics : public Component
   {
 
   public:
 
+    static constexpr ComponentType StaticType = ComponentType::Physics;
+    COMPONENT_POOL(Physics)
+
     Physics();
     Physics(const Physics& other);
 
@@ -27,7 +33,7 @@ namespace Components
     void setTargetVelocity(Vector3D vel);
     void setAcceleration(Vector3D acc);
 
-    void setAccelerationY(float val) { acceleration.y = val; }
+    void setAccelerationY(float val);
     void setTargetVelocityY(float val) { targetVelocity.y = val; }
     void setTargetVelocityX(float val) { targetVelocity.x = val; }
     void setTargetVelocityZ(float val) { targetVelocity.z = val; }
@@ -37,32 +43,48 @@ namespace Components
     void setVelocityY(float val);
     void setVelocityZ(float val);
 
-    const Vector3D getVelocity() { return velocity; }
-    const Vector3D getAcceleration() { return acceleration; }
+    const Vector3D getVelocity() const;
+    const Vector3D getAcceleration() const;
+
+    float getGravity() const;
+    void setGravity(float val);
 
-    void update();
+    // the physics world integrates every body at once, there's nothing to do per component
+    void update() {}
 
     void render();
+    // live state while the game runs, the variables only show what we'll start with
+    void display();
 
     void setAnchored(bool val);
-    bool isAnchored() { return anchored; }
-    void setGrounded(bool val) { grounded = val; }
-    bool isGrounded() { return grounded; }
+    bool isAnchored() const;
+    void setGrounded(bool val);
+    bool isGrounded() const;
+
+    // sleeping bodies skip integration and don't look for collisions until something wakes them
+    bool isSleeping() const;
+    // slow enough for long enough; islands put bodies to sleep when every body in them is restful
+    bool isRestful() const;
+    void sleep();
+    void wake();
+    void setCanSleep(bool val);
+    bool getCanSleep() const;
+
+    // the whole state, from the world if we're in one
+    World::BodyState getState() const;
+    bool isInWorld() const { return world != nullptr; }
 
   private:
 
-    Vector3D velocity;
-    Vector3D targetVelocity;
-    Vector3D acceleration;
+    friend class World::PhysicsWorld;
 
-    // anchored means we can't move no matter what
-    bool anchored = false;
-    bool grounded = false; // we are on the ground
+    World::BodyState state;
+    World::PhysicsWorld* world = nullptr;
+    int body = -1; // our index in world, kept up to date by it
 
-    // this is the gravity constant
-    float gravity;
+    Vector3D targetVelocity;
     float maxVelocity = 100.f;
 
   };
 
-}
\ No newline at end of file
+}
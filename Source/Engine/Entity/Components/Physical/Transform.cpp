@@ -8,7 +8,9 @@
 
 #include "stdafx.h"
 #include "Transform.h"
+#include "TransformBatch.h"
 #include "Engine/GlowEngine.h"
+#include "Engine/Systems/Update/FrameClock.h"
 
 REGISTER_COMPONENT(Transform);
 
@@ -41,6 +43,7 @@ Components::Transform::Transform(const Transform& other) : Component(other)
   scale = other.scale;
   position = finalPosition;
   rotation = other.rotation;
+  // copies start without a parent
 
   init();
 }
@@ -64,28 +67,86 @@ void Components::Transform::update()
   }
 }
 
-// reclaculate the world matrix
+// recalculate the matrix of just this transform; scenes rebuild dirty transforms in batches through TransformBatch
 void Components::Transform::recalculateMatrix()
 {
-  // rotation matrix
-  float radianFactor = 52.3f;
+  setLocalMatrix(Components::TransformBatch::Compose(position, rotation, scale));
+}
 
-  Matrix rotationMatrixX = DirectX::XMMatrixRotationX(rotation.x / radianFactor);
-  Matrix rotationMatrixY = DirectX::XMMatrixRotationY(rotation.y / radianFactor);
-  Matrix rotationMatrixZ = DirectX::XMMatrixRotationZ(rotation.z / radianFactor);
-  Matrix rotationMatrix = rotationMatrixX * rotationMatrixY * rotationMatrixZ;
+void Components::Transform::setLocalMatrix(const Matrix& matrix)
+{
+  // set the local matrix; without a parent it is also our world matrix
+  localMatrix = matrix;
 
-  // scale matrix
-  Matrix scaleMatrix = DirectX::XMMatrixScaling(scale.x, scale.y, scale.z);
+  if (!parented)
+  {
+    setWorldMatrix(localMatrix);
+  }
+
+  // reset dirty flag and let the hierarchy know our children need updating
+  dirty = false;
+  moved = true;
+}
 
-  // translation matrix
-  Matrix translationMatrix = DirectX::XMMatrixTranslation(position.x, position.y, position.z);
+void Components::Transform::setWorldMatrix(const Matrix& matrix)
+{
+  // only the first change in a step moves what we draw from; a new transform starts where it is
+  const std::uint32_t step = Systems::FrameClock::instance().getStepCount();
+  if (movedStep != step || !hasMatrix)
+  {
+    previousMatrix = hasMatrix ? transformMatrix : matrix;
+    movedStep = step;
+  }
 
-  // set the transform matrix
-  transformMatrix = scaleMatrix * rotationMatrix * translationMatrix;
+  transformMatrix = matrix;
+  hasMatrix = true;
+}
 
-  // reset dirty flag
-  dirty = false;
+Matrix Components::Transform::getRenderMatrix() const
+{
+  const Systems::FrameClock& clock = Systems::FrameClock::instance();
+  const float alpha = clock.getAlpha();
+
+  // anything that didn't move in the last step is already where it will be drawn
+  if (alpha >= 1.f || movedStep != clock.getStepCount())
+    return transformMatrix;
+
+  // blend the parts separately, lerping whole matrices would shrink anything turning fast
+  DirectX::XMVECTOR previousScale, previousRotation, previousPosition;
+  DirectX::XMVECTOR scale, rotation, position;
+  if (!DirectX::XMMatrixDecompose(&previousScale, &previousRotation, &previousPosition, previousMatrix)
+    || !DirectX::XMMatrixDecompose(&scale, &rotation, &position, transformMatrix))
+  {
+    return transformMatrix;
+  }
+
+  return DirectX::XMMatrixAffineTransformation(
+    DirectX::XMVectorLerp(previousScale, scale, alpha),
+    DirectX::XMVectorZero(),
+    DirectX::XMQuaternionSlerp(previousRotation, rotation, alpha),
+    DirectX::XMVectorLerp(previousPosition, position, alpha));
+}
+
+Vector3D Components::Transform::getWorldScale() const
+{
+  if (!parented)
+    return scale;
+
+  return Vector3D(
+    DirectX::XMVectorGetX(DirectX::XMVector3Length(transformMatrix.r[0])),
+    DirectX::XMVectorGetX(DirectX::XMVector3Length(transformMatrix.r[1])),
+    DirectX::XMVectorGetX(DirectX::XMVector3Length(transformMatrix.r[2])));
+}
+
+void Components::Transform::bakeWorldMatrix()
+{
+  if (hasMatrix)
+  {
+    Components::TransformBatch::Decompose(transformMatrix, position, rotation, scale);
+  }
+
+  parented = false;
+  dirty = true;
 }
 
 // if matrix is dirty
@@ -9,6 +9,11 @@
 #pragma once
 #include "Engine/Entity/Components/Component.h"
 
+namespace Entities
+{
+  class TransformHierarchy;
+}
+
 namespace Components
 {
 
@@ -17,6 +22,13 @@ namespace Components
 
   public:
 
+    static constexpr ComponentType StaticType = ComponentType::Transform;
+    COMPONENT_POOL(Transform)
+
+    // rotations are stored in editor units, this many make a radian; close to degrees (57.3) but not quite,
+    // and every saved scene is authored against it, so it stays
+    static constexpr float RotationUnitsPerRadian = 52.3f;
+
     Transform();
     Transform(Vector3D pos_, Vector3D scale_, Vector3D rotation_);
     Transform(const Transform& other);
@@ -29,8 +41,17 @@ namespace Components
     void recalculateMatrix();
     // check if dirty flag is set for matrix recalculation
     bool isDirty();
-    // get the transform matrix
+    // get the world matrix; for parented transforms this includes every parent above us
     const Matrix& getTransformMatrix();
+    // the world matrix to draw with; while the game runs this is between the last step's matrix and the one before
+    Matrix getRenderMatrix() const;
+    // get the matrix built from our own position, scale and rotation
+    const Matrix& getLocalMatrix() const { return localMatrix; }
+    // our position and scale in the world, the same as our own unless we have a parent
+    Vector3D getWorldPosition() const { return parented ? Vector3D::XMVectorToVector3D(transformMatrix.r[3]) : position; }
+    Vector3D getWorldScale() const;
+    // if we are parented to another transform
+    bool isParented() const { return parented; }
 
     Components::Transform* clone();
 
@@ -56,14 +77,33 @@ namespace Components
 
   private:
 
+    friend class Entities::TransformHierarchy;
+    friend class TransformBatch;
+
+    // take a freshly built local matrix and clear the dirty flag
+    void setLocalMatrix(const Matrix& matrix);
+    // set the world matrix, keeping the one from before this step to draw between them
+    void setWorldMatrix(const Matrix& matrix);
+    // take our world matrix as our own position, rotation and scale, for when our parent goes away
+    void bakeWorldMatrix();
+
+    // if our local matrix was rebuilt since the hierarchy last looked, clears the flag
+    bool consumeMoved() { bool value = moved; moved = false; return value; }
+
     Vector3D position;
     Vector3D oldPosition;
     Vector3D scale;
     Vector3D rotation;
 
-    Matrix transformMatrix;
+    Matrix localMatrix;
+    Matrix transformMatrix; // world matrix
+    Matrix previousMatrix; // world matrix at the end of the step before the one we last moved in
+    std::uint32_t movedStep = 0; // the fixed step we last moved in
+    bool hasMatrix = false; // our world matrix has been built at least once
 
     bool dirty;
+    bool parented = false; // our world matrix is set by the transform hierarchy
+    bool moved = false;
 
   };
 }
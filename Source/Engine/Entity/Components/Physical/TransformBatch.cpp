@@ -0,0 +1,191 @@
+/*
+/
+// filename: TransformBatch.cpp
+// author: Callen Betts
+// brief: implements TransformBatch.h
+/
+*/
+
+#include "stdafx.h"
+#include "TransformBatch.h"
+#include "Transform.h"
+
+//  with a, b, c the rotation around x, y and z, scale * rotX * rotY * rotZ * translation is
+//
+//    sx * ( cb*cc,             cb*sc,             -sb,    0 )
+//    sy * ( sa*sb*cc - ca*sc,  sa*sb*sc + ca*cc,  sa*cb,  0 )
+//    sz * ( ca*sb*cc + sa*sc,  ca*sb*sc - sa*cc,  ca*cb,  0 )
+//         ( px,                py,                pz,     1 )
+
+void Components::TransformBatch::clear()
+{
+  transforms.clear();
+  px.clear(); py.clear(); pz.clear();
+  rx.clear(); ry.clear(); rz.clear();
+  sx.clear(); sy.clear(); sz.clear();
+}
+
+void Components::TransformBatch::add(Components::Transform* transform)
+{
+  const Vector3D position = transform->getPosition();
+  const Vector3D rotation = transform->getRotation();
+  const Vector3D scale = transform->getScale();
+
+  transforms.push_back(transform);
+  px.push_back(position.x); py.push_back(position.y); pz.push_back(position.z);
+  rx.push_back(rotation.x); ry.push_back(rotation.y); rz.push_back(rotation.z);
+  sx.push_back(scale.x); sy.push_back(scale.y); sz.push_back(scale.z);
+}
+
+void Components::TransformBatch::build()
+{
+  const int count = getCount();
+
+  if (count < Width)
+  {
+    buildScalar();
+    return;
+  }
+
+  // pad the last block by repeating the last transform, the padding lanes are never written back
+  while (px.size() % Width)
+  {
+    px.push_back(px.back()); py.push_back(py.back()); pz.push_back(pz.back());
+    rx.push_back(rx.back()); ry.push_back(ry.back()); rz.push_back(rz.back());
+    sx.push_back(sx.back()); sy.push_back(sy.back()); sz.push_back(sz.back());
+  }
+
+  for (int i = 0; i < count; i += Width)
+  {
+    buildBlock(i);
+  }
+
+  clear();
+}
+
+void Components::TransformBatch::buildBlock(int index)
+{
+  using namespace DirectX;
+
+  auto load = [index](const std::vector<float>& values) { return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&values[index])); };
+
+  const XMVECTOR toRadians = XMVectorReplicate(1.0f / Components::Transform::RotationUnitsPerRadian);
+
+  XMVECTOR sa, ca, sb, cb, sc, cc;
+  XMVectorSinCos(&sa, &ca, XMVectorMultiply(load(rx), toRadians));
+  XMVectorSinCos(&sb, &cb, XMVectorMultiply(load(ry), toRadians));
+  XMVectorSinCos(&sc, &cc, XMVectorMultiply(load(rz), toRadians));
+
+  const XMVECTOR scaleX = load(sx);
+  const XMVECTOR scaleY = load(sy);
+  const XMVECTOR scaleZ = load(sz);
+
+  const XMVECTOR sbcc = XMVectorMultiply(sb, cc);
+  const XMVECTOR sbsc = XMVectorMultiply(sb, sc);
+  const XMVECTOR zero = XMVectorZero();
+
+  // every element of the matrix, for four transforms at once
+  const XMMATRIX row0 = XMMatrixTranspose(XMMATRIX(
+    XMVectorMultiply(scaleX, XMVectorMultiply(cb, cc)),
+    XMVectorMultiply(scaleX, XMVectorMultiply(cb, sc)),
+    XMVectorNegate(XMVectorMultiply(scaleX, sb)),
+    zero));
+
+  const XMMATRIX row1 = XMMatrixTranspose(XMMATRIX(
+    XMVectorMultiply(scaleY, XMVectorSubtract(XMVectorMultiply(sa, sbcc), XMVectorMultiply(ca, sc))),
+    XMVectorMultiply(scaleY, XMVectorMultiplyAdd(sa, sbsc, XMVectorMultiply(ca, cc))),
+    XMVectorMultiply(scaleY, XMVectorMultiply(sa, cb)),
+    zero));
+
+  const XMMATRIX row2 = XMMatrixTranspose(XMMATRIX(
+    XMVectorMultiply(scaleZ, XMVectorMultiplyAdd(ca, sbcc, XMVectorMultiply(sa, sc))),
+    XMVectorMultiply(scaleZ, XMVectorSubtract(XMVectorMultiply(ca, sbsc), XMVectorMultiply(sa, cc))),
+    XMVectorMultiply(scaleZ, XMVectorMultiply(ca, cb)),
+    zero));
+
+  const XMMATRIX row3 = XMMatrixTranspose(XMMATRIX(load(px), load(py), load(pz), XMVectorSplatOne()));
+
+  // after the transposes, row n of lane j is rowN.r[j]
+  const int lanes = (std::min)(Width, getCount() - index);
+  for (int lane = 0; lane < lanes; ++lane)
+  {
+    transforms[index + lane]->setLocalMatrix(XMMATRIX(row0.r[lane], row1.r[lane], row2.r[lane], row3.r[lane]));
+  }
+}
+
+void Components::TransformBatch::buildScalar()
+{
+  for (int i = 0; i < getCount(); ++i)
+  {
+    transforms[i]->setLocalMatrix(Compose({ px[i], py[i], pz[i] }, { rx[i], ry[i], rz[i] }, { sx[i], sy[i], sz[i] }));
+  }
+
+  clear();
+}
+
+Matrix Components::TransformBatch::Compose(const Vector3D& position, const Vector3D& rotation, const Vector3D& scale)
+{
+  const float toRadians = 1.0f / Components::Transform::RotationUnitsPerRadian;
+
+  const float sa = std::sin(rotation.x * toRadians), ca = std::cos(rotation.x * toRadians);
+  const float sb = std::sin(rotation.y * toRadians), cb = std::cos(rotation.y * toRadians);
+  const float sc = std::sin(rotation.z * toRadians), cc = std::cos(rotation.z * toRadians);
+
+  return DirectX::XMMatrixSet(
+    scale.x * cb * cc, scale.x * cb * sc, scale.x * -sb, 0,
+    scale.y * (sa * sb * cc - ca * sc), scale.y * (sa * sb * sc + ca * cc), scale.y * sa * cb, 0,
+    scale.z * (ca * sb * cc + sa * sc), scale.z * (ca * sb * sc - sa * cc), scale.z * ca * cb, 0,
+    position.x, position.y, position.z, 1);
+}
+
+void Components::TransformBatch::Decompose(const Matrix& matrix, Vector3D& position, Vector3D& rotation, Vector3D& scale)
+{
+  DirectX::XMFLOAT4X4 m;
+  DirectX::XMStoreFloat4x4(&m, matrix);
+
+  // each basis row is a rotation row times the scale on that axis
+  scale = Vector3D(
+    std::sqrt(m._11 * m._11 + m._12 * m._12 + m._13 * m._13),
+    std::sqrt(m._21 * m._21 + m._22 * m._22 + m._23 * m._23),
+    std::sqrt(m._31 * m._31 + m._32 * m._32 + m._33 * m._33));
+  position = Vector3D(m._41, m._42, m._43);
+
+  const float sx = scale.x > 0 ? 1.0f / scale.x : 0;
+  const float sy = scale.y > 0 ? 1.0f / scale.y : 0;
+  const float sz = scale.z > 0 ? 1.0f / scale.z : 0;
+
+  // undo Compose's closed form; row 0 is (cb * cc, cb * sc, -sb)
+  const float sb = std::clamp(-m._13 * sx, -1.0f, 1.0f);
+  float a, b = std::asin(sb), c;
+
+  if (std::abs(sb) < 0.9999f)
+  {
+    a = std::atan2(m._23 * sy, m._33 * sz);
+    c = std::atan2(m._12 * sx, m._11 * sx);
+  }
+  else
+  {
+    // pitched straight up or down, x and z turn about the same axis so z takes none of it
+    a = std::atan2(m._21 * sy * sb, m._22 * sy);
+    c = 0;
+  }
+
+  rotation = Vector3D(a, b, c) * Components::Transform::RotationUnitsPerRadian;
+}
+
+void Components::TransformBatch::Run(Components::Component** components, int count)
+{
+  // one batch per thread, its buffers are reused every frame
+  thread_local TransformBatch batch;
+
+  for (int i = 0; i < count; ++i)
+  {
+    Components::Transform* transform = static_cast<Components::Transform*>(components[i]);
+    if (transform->isDirty())
+    {
+      batch.add(transform);
+    }
+  }
+
+  batch.build();
+}
@@ -0,0 +1,66 @@
+/*
+/
+// filename: TransformBatch.h
+// author: Callen Betts
+// brief: defines a batch kernel that rebuilds the matrices of many dirty transforms at once
+//
+// description: Dirty transforms are collected into structure of arrays buffers (position, rotation and scale
+//  split per axis), then their local matrices are built four at a time. Each vector register holds the same
+//  value for four transforms, so the sines and cosines of all three rotation axes are computed together and the
+//  scale * rotation * translation product is written out in closed form instead of multiplying five matrices.
+//
+//  The math goes through DirectXMath, which compiles to SSE2 or AVX depending on the build's instruction set and
+//  to plain scalar code with _XM_NO_INTRINSICS_. Small batches take the scalar path, which uses the same closed
+//  form. The update pipeline already splits the transform pass across worker threads, so every worker fills and
+//  builds its own batch.
+/
+*/
+
+#pragma once
+
+namespace Components
+{
+  class Component;
+  class Transform;
+
+  class TransformBatch
+  {
+
+  public:
+
+    // transforms handled per vector register
+    static constexpr int Width = 4;
+
+    void clear();
+    // collect a transform to rebuild
+    void add(Components::Transform* transform);
+    int getCount() const { return (int)transforms.size(); }
+
+    // build every collected matrix and hand it back to its transform, then clear the batch
+    void build();
+    // same results one transform at a time, used for small batches
+    void buildScalar();
+
+    // scale * rotation * translation of a single transform in closed form
+    static Matrix Compose(const Vector3D& position, const Vector3D& rotation, const Vector3D& scale);
+    // the position, rotation and scale Compose would build a matrix from
+    static void Decompose(const Matrix& matrix, Vector3D& position, Vector3D& rotation, Vector3D& scale);
+
+    // update pipeline entry point; rebuilds the dirty transforms of a range of gathered components
+    static void Run(Components::Component** components, int count);
+
+  private:
+
+    // build the matrices of Width transforms starting at index
+    void buildBlock(int index);
+
+    std::vector<Components::Transform*> transforms;
+
+    // one array per axis, padded to a multiple of Width
+    std::vector<float> px, py, pz;
+    std::vector<float> rx, ry, rz;
+    std::vector<float> sx, sy, sz;
+
+  };
+
+}
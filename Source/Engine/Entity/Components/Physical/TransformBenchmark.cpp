@@ -0,0 +1,139 @@
+/*
+/
+// filename: TransformBenchmark.cpp
+// author: Callen Betts
+// brief: measures transform matrix rebuild throughput for moving transforms
+//
+// description: Every frame each transform gets a new position and rotation, then all of them are rebuilt. The
+//  five matrix product the transform used before is the baseline, against the closed form one transform at a
+//  time, the SIMD batch on one thread and the SIMD batch split across the job system like the update pipeline
+//  does. Run it with "-benchmark TransformBatch 100000" for 100k transforms.
+/
+*/
+
+#include "stdafx.h"
+#include "TransformBatch.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+#include "Engine/Systems/Jobs/JobSystem.h"
+
+namespace
+{
+  constexpr int Frames = 20;
+
+  // the old rebuild, three rotation matrices plus scale and translation multiplied together
+  Matrix MultiplyMatrices(Components::Transform* transform)
+  {
+    const float units = Components::Transform::RotationUnitsPerRadian;
+    const Vector3D rotation = transform->getRotation();
+    const Vector3D scale = transform->getScale();
+    const Vector3D position = transform->getPosition();
+
+    Matrix rotationMatrix = DirectX::XMMatrixRotationX(rotation.x / units) * DirectX::XMMatrixRotationY(rotation.y / units) * DirectX::XMMatrixRotationZ(rotation.z / units);
+    return DirectX::XMMatrixScaling(scale.x, scale.y, scale.z) * rotationMatrix * DirectX::XMMatrixTranslation(position.x, position.y, position.z);
+  }
+
+  void Move(std::vector<Components::Transform*>& transforms, int frame)
+  {
+    for (size_t i = 0; i < transforms.size(); ++i)
+    {
+      transforms[i]->setPosition({ (float)i, (float)frame, 0.f });
+      transforms[i]->setRotation({ (float)frame, (float)i * 0.01f, 10.f });
+    }
+  }
+
+  // time only the rebuild, moving the transforms is the same for every variant
+  template <typename RebuildFunc>
+  double Run(std::vector<Components::Transform*>& transforms, RebuildFunc rebuild)
+  {
+    double total = 0;
+    for (int frame = 0; frame < Frames; ++frame)
+    {
+      Move(transforms, frame);
+
+      Benchmark::Stopwatch timer;
+      rebuild();
+      total += timer.elapsed();
+    }
+    return total / Frames;
+  }
+
+  // millions of transforms per second from milliseconds per frame
+  double Throughput(int count, double ms)
+  {
+    return ms > 0 ? count / (ms * 1000.0) : 0;
+  }
+
+  void TransformBatchBenchmark(int count)
+  {
+    std::vector<Components::Transform*> transforms;
+    transforms.reserve(count);
+
+    for (int i = 0; i < count; ++i)
+    {
+      transforms.push_back(new Components::Transform({ (float)i, 0.f, 0.f }, { 1.f, 2.f, 1.f }, { 0.f, 0.f, 0.f }));
+    }
+
+    Components::Component** components = reinterpret_cast<Components::Component**>(transforms.data());
+
+    // the result is summed so the baseline can't be optimized away
+    float checksum = 0;
+    double multiplied = Run(transforms, [&]() {
+      for (Components::Transform* transform : transforms)
+      {
+        checksum += DirectX::XMVectorGetX(MultiplyMatrices(transform).r[0]);
+      }
+      });
+
+    double scalar = Run(transforms, [&]() {
+      for (Components::Transform* transform : transforms)
+      {
+        transform->recalculateMatrix();
+      }
+      });
+
+    double batched = Run(transforms, [&]() { Components::TransformBatch::Run(components, count); });
+
+    int threads = 1;
+    double parallel = 0;
+    {
+      Jobs::JobSystem jobs(0);
+      threads = jobs.getThreadCount();
+      parallel = Run(transforms, [&]() {
+        jobs.parallelFor(count, [components](int begin, int end) { Components::TransformBatch::Run(components + begin, end - begin); });
+        });
+    }
+
+    // the batch has to agree with the matrix product it replaced
+    float maxError = 0;
+    for (Components::Transform* transform : transforms)
+    {
+      Matrix expected = MultiplyMatrices(transform);
+      const Matrix& actual = transform->getLocalMatrix();
+
+      for (int row = 0; row < 4; ++row)
+      {
+        DirectX::XMVECTOR difference = DirectX::XMVectorAbs(DirectX::XMVectorSubtract(expected.r[row], actual.r[row]));
+        maxError = (std::max)(maxError, (std::max)((std::max)(DirectX::XMVectorGetX(difference), DirectX::XMVectorGetY(difference)),
+          (std::max)(DirectX::XMVectorGetZ(difference), DirectX::XMVectorGetW(difference))));
+      }
+    }
+
+    Benchmark::Report("TransformBatch", "matrix product", multiplied, "ms/frame");
+    Benchmark::Report("TransformBatch", "closed form, one at a time", scalar, "ms/frame");
+    Benchmark::Report("TransformBatch", "simd batch", batched, "ms/frame");
+    Benchmark::Report("TransformBatch", "simd batch, " + std::to_string(threads) + " threads", parallel, "ms/frame");
+    Benchmark::Report("TransformBatch", "matrix product throughput", Throughput(count, multiplied), "M/s");
+    Benchmark::Report("TransformBatch", "simd batch throughput", Throughput(count, batched), "M/s");
+    Benchmark::Report("TransformBatch", "simd batch threaded throughput", Throughput(count, parallel), "M/s");
+    Benchmark::Report("TransformBatch", "speedup over matrix product", batched > 0 ? multiplied / batched : 0, "x");
+    Benchmark::Report("TransformBatch", "max error", maxError, "");
+    Benchmark::Report("TransformBatch", "checksum", checksum, "");
+
+    for (Components::Transform* transform : transforms)
+    {
+      delete transform;
+    }
+  }
+}
+
+REGISTER_BENCHMARK(TransformBatch, TransformBatchBenchmark);
@@ -22,6 +22,8 @@ namespace Components
 
   public:
 
+    static constexpr ComponentType StaticType = ComponentType::Animation3D;
+
     // initialize the animation's base values
     Animation3D();
 
@@ -39,9 +39,9 @@ Models::Model::Model(const std::string fileName)
 void Models::Model::init()
 {
   engine = EngineInstance::getEngine();
-  renderer = engine->getRenderer(); // models need the renderer to draw
-  device = renderer->getDevice();
-  deviceContext = renderer->getDeviceContext();
+  renderer = engine->getRenderer(); // models need the renderer to draw, headless there is none and they never do
+  device = renderer ? renderer->getDevice() : nullptr;
+  deviceContext = renderer ? renderer->getDeviceContext() : nullptr;
   dirty = true;
 }
 
@@ -78,12 +78,6 @@ void Models::Model::addMesh(Meshes::Mesh* meshToAdd)
     meshes.push_back(meshToAdd);
 }
 
-// get the meshes from the model
-std::vector<Meshes::Mesh*> Models::Model::getMeshes()
-{
-    return meshes;
-}
-
 // set the model's name to lookup in library
 void Models::Model::setName(std::string name_)
 {
@@ -150,11 +144,11 @@ void Models::Model::assignMaterialToSubSection(int mi, int si, std::string name)
 }
 
 // render a model's meshes
-void Models::Model::render()
+void Models::Model::render(const std::vector<std::vector<std::string>>* materials)
 {
     // render each mesh
-    for (auto& mesh : meshes)
+    for (size_t i = 0; i < meshes.size(); ++i)
     {
-        mesh->render();
+        meshes[i]->render((materials && i < materials->size()) ? &(*materials)[i] : nullptr);
     }
 }
@@ -62,7 +62,7 @@ namespace Models
     void init();
     void load(const std::string fileName);
     void addMesh(Meshes::Mesh* meshToAdd);
-    std::vector<Meshes::Mesh*> getMeshes();
+    const std::vector<Meshes::Mesh*>& getMeshes() const { return meshes; }
 
     // is dirty
     bool isDirty() { return dirty; }
@@ -71,8 +71,8 @@ namespace Models
     void assignMaterialFromName(std::string name);
     void assignMaterialToSubSection(int mi, int si, std::string name);
 
-    // render a model
-    void render();
+    // render a model; materials holds a sprite's own material names per mesh and subsection
+    void render(const std::vector<std::vector<std::string>>* materials = nullptr);
     // rename a model
     void setName(std::string name);
     std::string& getName();
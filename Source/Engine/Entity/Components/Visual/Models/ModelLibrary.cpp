@@ -20,6 +20,12 @@ Models::ModelLibrary::ModelLibrary()
 // loop through our assets and load all of our 
 void Models::ModelLibrary::load(std::string directoryPath)
 {
+  if (locked)
+  {
+    Logger::error("Model library is read only, can't load " + directoryPath);
+    return;
+  }
+
   // 1. check if the directory exists and if it is a directory
   if (fs::is_directory(directoryPath) && fs::exists(directoryPath))
   {
@@ -43,14 +49,21 @@ void Models::ModelLibrary::load(std::string directoryPath)
 }
 
 // add a model to the library
-void Models::ModelLibrary::add(std::string name, Models::Model* model)
+bool Models::ModelLibrary::add(std::string name, Models::Model* model)
 {
+  if (locked)
+  {
+    Logger::error("Model library is read only, can't add " + name);
+    return false;
+  }
+
   if (model)
   {
     model->setName(name);
     models[name] = model;
   }
   Logger::write("Added new model " + name + " to library");
+  return true;
 }
 
 // get a model from the library
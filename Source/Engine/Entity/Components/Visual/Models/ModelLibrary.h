@@ -24,14 +24,22 @@ namespace Models
     // load all of our 3D models
     void load(std::string directoryPath = "Assets/Models");
 
-    // add a model to the map
-    void add(std::string name, Models::Model* model);
+    // add a model to the map; returns false once the library is locked, the caller keeps the model
+    bool add(std::string name, Models::Model* model);
 
     // get a model from the map
     Models::Model* get(std::string name);
 
+    // once everything is loaded the library is read only, so worlds on other threads can share it without a lock
+    void lock() { locked = true; }
+    bool isLocked() const { return locked; }
+
     std::map<std::string, Models::Model*> models; // our models
 
+  private:
+
+    bool locked = false;
+
   };
 
 }
\ No newline at end of file
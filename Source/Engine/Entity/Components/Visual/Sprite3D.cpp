@@ -21,26 +21,44 @@
 
 REGISTER_COMPONENT(Sprite3D);
 
+namespace
+{
+  // the library's copy of a model, nullptr without a library or a model by that name; never loads anything
+  Models::Model* FindModel(const std::string& name)
+  {
+    Engine::GlowEngine* engine = EngineInstance::getEngine();
+    Models::ModelLibrary* library = engine ? engine->getModelLibrary() : nullptr;
+    return library ? library->get(name) : nullptr;
+  }
+}
+
 // overloaded constructor to take in a model and a texture
 Components::Sprite3D::Sprite3D(const std::string modelName, const std::string textureName)
   : Component(),
+  modelName(modelName),
   renderer(nullptr)
 {
   init();
+
+  // only looks the model up, so sprites can be made without a library or off the main thread
+  model = FindModel(modelName);
 }
 
 // base Sprite3D constructor to give pointers to renderer
 Components::Sprite3D::Sprite3D()
-  : Component(),
-  renderer(nullptr)
+  : Sprite3D("Cube")
 {
-  init();
 }
 
-Components::Sprite3D::Sprite3D(const Sprite3D& other) : Component(other)
+// copies share the model and only copy material names if the original had its own
+Components::Sprite3D::Sprite3D(const Sprite3D& other)
+  : Component(other),
+  repeatTexture(other.repeatTexture),
+  modelName(other.modelName),
+  model(other.model),
+  materialOverrides(other.materialOverrides)
 {
   init();
-  setModel(other.model->getName());
 }
 
 Components::Sprite3D* Components::Sprite3D::clone()
@@ -57,11 +75,11 @@ void Components::Sprite3D::load(const nlohmann::json& data)
 /// </summary>
 void Components::Sprite3D::CustomLoad(const nlohmann::json saveData)
 {
+  // Assign the model
+  if (saveData.contains("Model")) setModel(saveData["Model"]["value"]);
+
   if (model)
   {
-    // Assign the model
-    if (saveData.contains("Model")) setModel(saveData["Model"]["value"]);
-
     // Assign material
     if (saveData.contains("Materials") && saveData["Materials"].is_array())
     {
@@ -74,7 +92,8 @@ void Components::Sprite3D::CustomLoad(const nlohmann::json saveData)
             if (mi < 0 || si < 0 || name.empty())
                 continue;
 
-            model->assignMaterialToSubSection(mi, si, name); // you implement this
+            // only materials that differ from the model's are stored on this sprite
+            setMaterial(mi, si, name);
         }
     }
   }
@@ -88,18 +107,19 @@ void Components::Sprite3D::CustomSave(nlohmann::json& saveData) const
 {
     saveData["Materials"] = nlohmann::json::array();
 
+    if (!model)
+        return;
+
     int mi = 0;
     for (const auto& mesh : model->getMeshes())
     {
-        int si = 0;
-        for (const auto& section : mesh->getMeshSubsections())
+        for (int si = 0; si < (int)mesh->getMeshSubsections().size(); ++si)
         {
             saveData["Materials"].push_back({
                 {"mesh", mi},
                 {"section", si},
-                {"name", section.materialName}
+                {"name", getMaterialName(mi, si)}
                 });
-            si++;
         }
         mi++;
     }
@@ -108,13 +128,14 @@ void Components::Sprite3D::CustomSave(nlohmann::json& saveData) const
 // initialize the Sprite3D component
 void Components::Sprite3D::init()
 {
-  model = new Models::Model("Cube");
   type = Components::Component::Sprite3D;
   name = "Sprite3D";
+  // instances of a prefab draw the prefab's sprite until one of them changes its model or materials
+  shareable = true;
   Engine::GlowEngine* engine = EngineInstance::getEngine();
-  renderer = engine->getRenderer();
+  renderer = engine ? engine->getRenderer() : nullptr;
 
-  AddVariable(CreateVariable("Model", &(model->getName())));
+  AddVariable(CreateVariable("Model", &modelName));
   AddVariable(CreateVariable("Repeat Texture", &repeatTexture));
 }
 
@@ -122,29 +143,30 @@ void Components::Sprite3D::init()
 void Components::Sprite3D::render()
 {
     // set transform constant buffer
-    Components::Transform* transform = getComponentOfType(Transform, parent);
-    if (!transform)
+    Components::Transform* transform = parent->get<Components::Transform>();
+    if (!transform || !model)
     {
         return;
     }
 
     // update the constant buffer's world matrix
-    renderer->updateObjectBufferWorldMatrix(transform->getTransformMatrix());
+    renderer->updateObjectBufferWorldMatrix(transform->getRenderMatrix());
 
     // bind the constant buffer and update sub resource
     renderer->updateObjectBuffer();
 
     // texture repeat
-    for (const auto& mesh : model->getMeshes())
+    const std::vector<Meshes::Mesh*>& meshes = model->getMeshes();
+    for (int mi = 0; mi < (int)meshes.size(); ++mi)
     {
-        for (const auto& section : mesh->getMeshSubsections())
+        for (int si = 0; si < (int)meshes[mi]->getMeshSubsections().size(); ++si)
         {
-            EngineInstance::getEngine()->getMaterialLibrary()->get(section.materialName)->repeatTexture = repeatTexture;
+            EngineInstance::getEngine()->getMaterialLibrary()->get(getMaterialName(mi, si))->repeatTexture = repeatTexture;
         }
     }
 
-    // render our model
-    model->render();
+    // render our model with our own materials if we have any
+    model->render(materialOverrides.empty() ? nullptr : &materialOverrides);
 
     // reset UV scale after drawing
     renderer->SetUVScale(1, 1);
@@ -153,18 +175,14 @@ void Components::Sprite3D::render()
 // draw the outline of this sprite 
 void Components::Sprite3D::DrawOutline()
 {
-  if (parent->IsSelected())
+  if (parent->IsSelected() && model)
   {
-    Components::Transform* transform = getComponentOfType(Transform, parent);
+    Components::Transform* transform = parent->get<Components::Transform>();
     renderer->DrawSetOutline(Color::Outline);
-    Vector3D outlineScale = transform->getScale() * 1.02f;
-    Vector3D oldScale = transform->getScale();
-    transform->setScale(outlineScale);
-    transform->recalculateMatrix();
-    renderer->updateObjectBufferWorldMatrix(transform->getTransformMatrix());
+    // scale up in model space rather than touching the transform, which would dirty it and its children every frame
+    renderer->updateObjectBufferWorldMatrix(DirectX::XMMatrixScaling(1.02f, 1.02f, 1.02f) * transform->getRenderMatrix());
     renderer->updateObjectBuffer();
-    transform->setScale(oldScale);
-    model->render();
+    model->render(materialOverrides.empty() ? nullptr : &materialOverrides);
     renderer->DrawSetOutline(Color::Clear);
   }
 }
@@ -175,6 +193,14 @@ void Components::Sprite3D::display()
   Textures::TextureLibrary* tex = EngineInstance::getEngine()->getTextureLibrary();
   Materials::MaterialLibrary* matLib = EngineInstance::getEngine()->getMaterialLibrary();
 
+  // the Model variable writes straight into our name, so switch once it names another model in the library
+  const std::string typedName = modelName.c_str();
+  Models::Model* typedModel = lib->get(typedName);
+  if (typedModel && typedModel != model)
+  {
+    setModel(typedName);
+  }
+
   // Assuming `currentModel` is a member variable that holds the name of the current model
   static std::string currentModel = "";
   static std::string currentMaterial = "";
@@ -217,7 +243,7 @@ void Components::Sprite3D::display()
           if (ImGui::Selectable(name.c_str(), isSelected))
           {
               currentMaterial = name;
-              model->assignMaterial(matLib->get(currentMaterial));
+              setMaterial(currentMaterial);
           }
 
           if (isSelected)
@@ -231,13 +257,104 @@ void Components::Sprite3D::display()
 }
 
 // set this model given a name
-void Components::Sprite3D::setModel(const std::string modelName)
+void Components::Sprite3D::setModel(const std::string newModelName)
+{
+  Engine::GlowEngine* engine = EngineInstance::getEngine();
+  Models::ModelLibrary* library = engine ? engine->getModelLibrary() : nullptr;
+  Models::Model* shared = FindModel(newModelName);
+
+  if (!shared)
+  {
+    // the library is read only once the engine has loaded, worlds on other threads may be reading it
+    if (!library || library->isLocked())
+    {
+      Logger::error("No model named " + newModelName);
+      return;
+    }
+
+    // still loading; load it once and let every other sprite share it
+    shared = new Models::Model(newModelName);
+    library->add(newModelName, shared);
+  }
+
+  // our material names were per subsection of the old model
+  if (shared != model)
+  {
+    materialOverrides.clear();
+  }
+
+  model = shared;
+  modelName = newModelName;
+}
+
+const std::string& Components::Sprite3D::getMaterialName(int meshIndex, int sectionIndex) const
+{
+  if (!materialOverrides.empty())
+  {
+    return materialOverrides[meshIndex][sectionIndex];
+  }
+
+  return model->getMeshes()[meshIndex]->getMeshSubsections()[sectionIndex].materialName;
+}
+
+void Components::Sprite3D::setMaterial(int meshIndex, int sectionIndex, const std::string& materialName)
+{
+  if (!model)
+    return;
+
+  const std::vector<Meshes::Mesh*>& meshes = model->getMeshes();
+
+  if (meshIndex < 0 || meshIndex >= (int)meshes.size())
+    return;
+
+  if (sectionIndex < 0 || sectionIndex >= (int)meshes[meshIndex]->getMeshSubsections().size())
+    return;
+
+  // only materials that exist can be assigned
+  if (!EngineInstance::getEngine()->getMaterialLibrary()->get(materialName))
+    return;
+
+  // writing what we already have doesn't need our own copy
+  if (getMaterialName(meshIndex, sectionIndex) == materialName)
+    return;
+
+  materializeMaterials();
+  materialOverrides[meshIndex][sectionIndex] = materialName;
+}
+
+void Components::Sprite3D::setMaterial(const std::string& materialName)
 {
-  model->load(modelName);
+  if (!model)
+    return;
+
+  const std::vector<Meshes::Mesh*>& meshes = model->getMeshes();
+
+  for (int mi = 0; mi < (int)meshes.size(); ++mi)
+  {
+    for (int si = 0; si < (int)meshes[mi]->getMeshSubsections().size(); ++si)
+    {
+      setMaterial(mi, si, materialName);
+    }
+  }
+}
+
+void Components::Sprite3D::materializeMaterials()
+{
+  if (!materialOverrides.empty())
+    return;
+
+  for (Meshes::Mesh* mesh : model->getMeshes())
+  {
+    std::vector<std::string>& names = materialOverrides.emplace_back();
+    for (const Meshes::MeshSubSection& section : mesh->getMeshSubsections())
+    {
+      names.push_back(section.materialName);
+    }
+  }
 }
 
 // get the Sprite3D's model
-Models::Model* Components::Sprite3D::getModel()
+Models::Model* Components::Sprite3D::getModel() const
 {
   return model;
 }
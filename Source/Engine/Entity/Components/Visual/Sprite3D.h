@@ -27,6 +27,9 @@ namespace Components
 
   public:
 
+    static constexpr ComponentType StaticType = ComponentType::Sprite3D;
+    COMPONENT_POOL(Sprite3D)
+
     // constructors
     Sprite3D(const std::string modelName, const std::string textureName = "");
     Sprite3D();
@@ -48,11 +51,20 @@ namespace Components
     // set the texture repeat
     void setTextureRepeat(bool val);
 
-    // set the sprite's model
+    // set the sprite's model; every sprite using the same model shares the library's copy
     void setModel(const std::string modelName);
 
-    // get the model
-    Models::Model* getModel();
+    // get the model, it is shared so don't write to it through a sprite; nullptr if it wasn't in the library when
+    // we were made and nothing has called setModel since
+    Models::Model* getModel() const;
+
+    // the material of a mesh subsection, our own override if we have one; needs a model
+    const std::string& getMaterialName(int meshIndex, int sectionIndex) const;
+    // change the material of one subsection, or of all of them, for this sprite only
+    void setMaterial(int meshIndex, int sectionIndex, const std::string& materialName);
+    void setMaterial(const std::string& materialName);
+    // if this sprite has materials of its own instead of the model's
+    bool hasMaterialOverrides() const { return !materialOverrides.empty(); }
     
     // set alpha
     void setAlpha(float alpha);
@@ -62,10 +74,15 @@ namespace Components
 
   private:
 
+    // copy the model's material names so they can be changed, done on the first write
+    void materializeMaterials();
+
     float alpha;
     bool repeatTexture = false;
 
-    Models::Model* model;
+    std::string modelName;
+    Models::Model* model; // owned by the model library
+    std::vector<std::vector<std::string>> materialOverrides; // per mesh and subsection, empty while we use the model's
     Graphics::Renderer* renderer;
 
   };
@@ -8,6 +8,10 @@
 
 #include "stdafx.h"
 #include "Entity.h"
+#include "EntityList/NameIndex.h"
+#include "EntityList/QueryIndex.h"
+#include "Prefab.h"
+#include "Game/System/SystemScheduler.h"
 #include <utility>
 
 // base entity constructor
@@ -26,25 +30,64 @@ Entities::Entity::Entity(const Entity& other)
   id(0),
   name(other.name),
   destroyed(false),
-  visible(other.visible)
+  prefab(other.prefab),
+  flags(other.flags)
 {
-  // copy components
+  // copies keep the original's component order, so there is nothing to sort
+  components.reserve(other.components.size());
   for (const auto& component : other.components)
   {
+    // whatever the original still shares with its prefab we share as well
+    if (component->parent != &other)
+    {
+      components.push_back(component);
+      continue;
+    }
+
     Components::Component* comp = component->clone();
-    addComponent(comp);
+    comp->setParent(this);
+    components.push_back(comp);
   }
 
-  // update quick pointers
-  transform = getComponentOfType(Transform, this);
-  sprite = getComponentOfType(Sprite3D, this);
-  physics = getComponentOfType(Physics, this);
+  updateComponentSlots();
 
   init();
 }
 
+// prefab instances only copy the components that can't be shared, the rest are copied when first written to
+Entities::Entity::Entity(const Entity& archetype, const Entities::Prefab* prefab)
+  :
+  id(0),
+  name(archetype.name),
+  destroyed(false),
+  prefab(prefab),
+  flags(archetype.flags)
+{
+  components.reserve(archetype.components.size());
+  for (Components::Component* component : archetype.components)
+  {
+    if (component->IsShareable())
+    {
+      components.push_back(component);
+      continue;
+    }
+
+    Components::Component* comp = component->clone();
+    comp->setParent(this);
+    components.push_back(comp);
+  }
+
+  updateComponentSlots();
+
+  init();
+}
+
+// every entity gets a slot in the registry and a stable id, copies included
 void Entities::Entity::init()
 {
+  Entities::EntityRegistry& registry = Entities::EntityRegistry::instance();
+  handle = registry.create(this);
+  id = static_cast<int>(registry.getStableId(handle));
 }
 
 /// <summary>
@@ -66,10 +109,39 @@ const nlohmann::json Entities::Entity::Save() const
   // Iterate over our components and add their data to the json object
   for (const auto& component : components)
   {
-    componentData[component->getName()] = component->Save();
+    nlohmann::json data = component->Save();
+
+    // prefab instances only keep what they changed; a component the prefab doesn't have is saved whole
+    if (prefab)
+    {
+      prefab->stripDefaults(component->getName(), data);
+
+      if (data.empty() && prefab->hasComponent(component->getName()))
+        continue;
+    }
+
+    componentData[component->getName()] = data;
   }
 
   saveData["Components"] = componentData;
+  saveData["ID"] = id;
+
+  if (prefab)
+  {
+    saveData["Prefab"] = prefab->getName();
+
+    nlohmann::json removed = prefab->getRemovedComponents(this);
+    if (!removed.empty())
+    {
+      saveData["RemovedComponents"] = removed;
+    }
+  }
+
+  // parents are saved by stable id and linked up once the whole scene has loaded
+  if (Entities::Entity* parentEntity = parent.get())
+  {
+    saveData["Parent"] = parentEntity->GetId();
+  }
 
   return saveData;
 }
@@ -80,6 +152,12 @@ const nlohmann::json Entities::Entity::Save() const
 /// <param name=""> Json object </param>
 void Entities::Entity::Load(const nlohmann::json data)
 {
+  // keep the id we were saved with so references to us stay valid
+  if (data.contains("ID"))
+  {
+    SetId(data["ID"].get<int>());
+  }
+
   // Check if the "Components" key exists in the JSON data
   if (data.contains("Components"))
   {
@@ -89,8 +167,27 @@ void Entities::Entity::Load(const nlohmann::json data)
     // Iterate over all components in the JSON data
     for (auto& [componentName, componentData] : componentsData.items())
     {
+      // prefab instances already have the prefab's components, their saved data only overrides values
+      Components::Component* component = nullptr;
+      for (Components::Component* existing : components)
+      {
+        if (existing->getName() == componentName)
+        {
+          component = existing;
+          break;
+        }
+      }
+
+      const bool existed = component != nullptr;
+
+      // the saved values are written into it, so it has to be ours
+      component = own(component);
+
       // Create the component using the factory
-      Components::Component* component = ComponentFactory::instance().createComponent(componentName);
+      if (!component)
+      {
+        component = ComponentFactory::instance().createComponent(componentName);
+      }
 
       // If the component creation failed, handle it (e.g., log an error)
       if (component == nullptr)
@@ -147,7 +244,26 @@ void Entities::Entity::Load(const nlohmann::json data)
       component->CustomLoad(componentData);
 
       // Add the component to the entity's components list
-      components.push_back(component);
+      if (!existed)
+      {
+        addComponent(component);
+      }
+    }
+  }
+
+  // components of our prefab this instance removed
+  if (data.contains("RemovedComponents"))
+  {
+    for (const auto& removedName : data["RemovedComponents"])
+    {
+      for (Components::Component* component : components)
+      {
+        if (component->getName() == removedName.get<std::string>())
+        {
+          DeleteComponent(component);
+          break;
+        }
+      }
     }
   }
 }
@@ -155,10 +271,28 @@ void Entities::Entity::Load(const nlohmann::json data)
 // virtual destructor for entities
 Entities::Entity::~Entity()
 {
+  // components shared with our prefab belong to it
   for (auto component : components)
   {
-    delete component;
+    if (component->parent == this)
+    {
+      delete component;
+    }
+  }
+  components.clear();
+
+  if (nameIndex)
+  {
+    nameIndex->remove(this);
+  }
+
+  if (queryIndex)
+  {
+    queryIndex->remove(this);
   }
+
+  // any handle still pointing at us resolves to nullptr from now on
+  Entities::EntityRegistry::instance().release(handle);
 }
 
 void Entities::Entity::load(const nlohmann::json&)
@@ -192,6 +326,17 @@ void Entities::Entity::render()
   // get the sprite3D to render
   for (auto component : components)
   {
+    // a component shared with our prefab draws for whichever instance is rendering it; rendering is only ever
+    // on the main thread
+    if (component->parent != this)
+    {
+      Entities::Entity* owner = component->parent;
+      component->parent = this;
+      component->render();
+      component->parent = owner;
+      continue;
+    }
+
     component->render();
   }
 }
@@ -199,6 +344,8 @@ void Entities::Entity::render()
 // attach a new component to an entity
 void Entities::Entity::addComponent(Components::Component* component)
 {
+  CHECK_COMPONENT_WRITE(component->getType());
+
   // add the components
   component->setParent(this);
   this->components.push_back(component);
@@ -207,6 +354,8 @@ void Entities::Entity::addComponent(Components::Component* component)
   std::sort(components.begin(), components.end(), [](Components::Component* a, Components::Component* b) {
     return a->getPriority() > b->getPriority();
   });
+
+  updateComponentSlots();
 }
 
 // flag an entity for destroy
@@ -218,24 +367,51 @@ void Entities::Entity::destroy()
   }
 
   destroyed = true;
+
+  // drop out of the scene's views on the next flush
+  if (queryIndex)
+  {
+    queryIndex->markDirty(this);
+  }
+}
+
+void Entities::Entity::setFlag(EntityFlags flag, bool value)
+{
+  EntityFlags newFlags = value ? (flags | flag) : (flags & ~flag);
+  if (newFlags == flags)
+    return;
+
+  flags = newFlags;
+
+  if (queryIndex)
+  {
+    queryIndex->markDirty(this);
+  }
+}
+
+void Entities::Entity::SetId(int val)
+{
+  id = static_cast<int>(Entities::EntityRegistry::instance().assignStableId(handle, static_cast<std::uint32_t>(val)));
 }
 
 void Entities::Entity::setName(std::string newName)
 {
+  std::string oldName = name;
   name = newName;
+
+  if (nameIndex)
+  {
+    nameIndex->rename(this, oldName);
+  }
 }
 
 // has a component
 bool Entities::Entity::hasComponent(Components::Component::ComponentType type)
 {
-  for (Components::Component* component : components)
-  {
-    if (component->getType() == type)
-    {
-      return true;
-    }
-  }
-  return false;
+  if (type < 0 || type >= Components::Component::None)
+    return false;
+
+  return (componentMask & TypeBit(Components::Component::SlotOf(type))) != 0;
 }
 
 void Entities::Entity::DeleteComponent(Components::Component* component)
@@ -246,26 +422,38 @@ void Entities::Entity::DeleteComponent(Components::Component* component)
   // If the component is found, delete it and remove it from the vector
   if (it != components.end())
   {
-    delete* it;
+    CHECK_COMPONENT_WRITE(component->getType());
     components.erase(it);
+
+    // a component shared with our prefab is only let go of
+    if (component->parent == this)
+    {
+      delete component;
+    }
+
+    updateComponentSlots();
   }
 }
 
 // get a component
 Components::Component* Entities::Entity::getComponent(Components::Component::ComponentType type)
 {
-  for (Components::Component* component : components)
-  {
-    if (component->getType() == type)
-    {
-      return component;
-    }
-  }
-  return nullptr;
+  if (type < 0 || type >= Components::Component::None)
+    return nullptr;
+
+  return own(slots[Components::Component::SlotOf(type)]);
 }
 
 bool Entities::Entity::hasComponent(const std::string& type)
 {
+  // registered components share a slot with every class of the same type
+  Components::Component::ComponentType componentType = ComponentFactory::instance().getComponentType(type);
+
+  if (componentType != Components::Component::None)
+  {
+    return hasComponent(componentType);
+  }
+
   for (const auto& comp : components)
   {
     if (comp->getName() == type)
@@ -284,9 +472,52 @@ void Entities::Entity::addComponent(const std::string& type)
     Components::Component* component = ComponentFactory::instance().createComponent(type);
     if (component) 
     {
-      component->parent = this;
-      components.push_back(component);
+      addComponent(component);
     }
   }
 }
 
+// rebuild the component slots; components are sorted by priority, so the first of each type wins
+void Entities::Entity::updateComponentSlots()
+{
+  std::fill(std::begin(slots), std::end(slots), nullptr);
+  componentMask = 0;
+
+  for (Components::Component* component : components)
+  {
+    Components::Component::ComponentType type = component->getType();
+
+    if (type < 0 || type >= Components::Component::None || slots[type])
+      continue;
+
+    slots[type] = component;
+    componentMask |= TypeBit(type);
+  }
+
+  // refresh the core component pointers; only sprites can be shared with a prefab, so the rest are our own
+  const Entity& self = *this;
+  transform = static_cast<Components::Transform*>(slots[Components::Component::Transform]);
+  sprite = self.get<Components::Sprite3D>();
+  physics = static_cast<Components::Physics*>(slots[Components::Component::Physics]);
+  boundingBox = static_cast<Components::BoundingBox*>(slots[Components::Component::BoundingBox]);
+
+  // the collider keeps this in sync when it changes, but it has to be right the moment the collider is added
+  const Components::Collider* collider = self.get<Components::Collider>();
+  flags = (collider && collider->isStatic()) ? (flags | StaticCollider) : (flags & ~StaticCollider);
+
+  if (queryIndex)
+  {
+    queryIndex->markDirty(this);
+  }
+}
+
+Components::Component* Entities::Entity::copyShared(Components::Component* shared)
+{
+  Components::Component* copy = shared->clone();
+  copy->setParent(this);
+
+  // same place in the list, so the update order doesn't change
+  std::replace(components.begin(), components.end(), shared, copy);
+  updateComponentSlots();
+  return copy;
+}
@@ -9,10 +9,32 @@
 #pragma once
 
 #include "Components/Component.h"
-#define getComponentOfType(type, entity) dynamic_cast<Components::type*>(entity->getComponent(Components::Component::ComponentType::type##))
+#include "EntityHandle.h"
+#include "Engine/Systems/Memory/PoolAllocator.h"
 
 namespace Entities
 {
+  class EntityList;
+  class NameIndex;
+  class QueryIndex;
+  class TransformHierarchy;
+  class Prefab;
+
+  // one bit for each Components::Component::ComponentType
+  using ComponentTypeMask = std::uint32_t;
+
+  // entity wide bits that queries can filter on alongside components
+  using EntityFlags = std::uint32_t;
+
+  enum EntityFlag : EntityFlags
+  {
+    StaticCollider = 1 << 0, // we have a collider that doesn't move, kept in sync by the collider
+    Hidden = 1 << 1, // not rendered or picked
+    FirstTag = 1 << 8 // bits from here up are free for game tags and layers
+  };
+
+  // the bit of game tag n, 0 to 23
+  constexpr EntityFlags Tag(int n) { return EntityFlags(FirstTag) << n; }
 
   class Entity
   {
@@ -21,8 +43,14 @@ namespace Entities
 
     Entity(std::string name = "Entity");
     Entity(const Entity& other);
+    // an instance of a prefab's archetype; shareable components are the archetype's own until we write to them
+    Entity(const Entity& archetype, const Entities::Prefab* prefab);
 
     virtual ~Entity();
+
+    // entities are pooled by size so spawning and clearing scenes doesn't hit the heap every time
+    static void* operator new(std::size_t size) { return Memory::PoolAllocator::instance().allocate(size); }
+    static void operator delete(void* block) { Memory::PoolAllocator::deallocate(block); }
     virtual void load(const nlohmann::json&);
 
     void init(); 
@@ -31,7 +59,7 @@ namespace Entities
     const nlohmann::json Save() const;
     void Load(const nlohmann::json);
 
-    // update all of an entity's components
+    // update all of an entity's components; entities in a scene are updated by type through its UpdatePipeline instead
     void update();
     // render an entity's components
     void render();
@@ -44,19 +72,56 @@ namespace Entities
     // if we are selected by the inspector
     bool IsSelected() { return selected; }
     // if visible
-    bool isVisible() { return visible; }
+    bool isVisible() { return !(flags & Hidden); }
     // get the name
     std::string getName() { return name; }
-    // set name
+    // set name; inside a scene the name is made unique
     void setName(std::string newName);
     // has a component
     bool hasComponent(Components::Component::ComponentType type);
     // delete a component
     void DeleteComponent(Components::Component* component);
-    // get a component
+    // get a component, our own copy if it was shared with our prefab
     Components::Component* getComponent(Components::Component::ComponentType type);
-    // get the components vector
-    std::vector<Components::Component*> getComponents() { return components; }
+
+    // get a component by class in constant time, nullptr if we don't have one
+    // derived classes (BoxCollider, PlayerBehavior) live in the slot of their base type; the caller may write to
+    // it, so a component still shared with our prefab is copied first
+    template <typename T>
+    T* get()
+    {
+      static_assert(T::StaticType != Components::Component::None, "component class has no type id");
+      return static_cast<T*>(own(slots[Components::Component::SlotOf(T::StaticType)]));
+    }
+
+    // the same for reading, a component shared with our prefab stays shared
+    template <typename T>
+    const T* get() const
+    {
+      static_assert(T::StaticType != Components::Component::None, "component class has no type id");
+      return static_cast<const T*>(slots[Components::Component::SlotOf(T::StaticType)]);
+    }
+
+    // a component of ours we can write to; one still shared with our prefab is swapped for a copy, which is returned
+    Components::Component* own(Components::Component* component) { return (!component || component->parent == this) ? component : copyShared(component); }
+
+    // check if we have every one of the given component classes with a single mask test
+    template <typename... T>
+    bool has() const
+    {
+      const ComponentTypeMask mask = (TypeBit(Components::Component::SlotOf(T::StaticType)) | ...);
+      return (componentMask & mask) == mask;
+    }
+
+    // get the bitmask of component types we have
+    ComponentTypeMask getComponentMask() const { return componentMask; }
+    // entity flags and game tags
+    EntityFlags getFlags() const { return flags; }
+    bool hasFlag(EntityFlags flag) const { return (flags & flag) == flag; }
+    // set or clear flag bits, views of the scene we are in are updated on their next flush
+    void setFlag(EntityFlags flag, bool value);
+    // get the components vector; components whose parent isn't us are shared with our prefab, see own
+    const std::vector<Components::Component*>& getComponents() const { return components; }
     std::vector<Variable>& getVariables()  { return variables; }
 
     // add a variable to be modified in the editor
@@ -64,29 +129,48 @@ namespace Entities
     // set selected
     void SetSelected(bool val) { selected = val; }
     // toggle visibility
-    void ToggleVisiblity() { visible = !visible; }
+    void ToggleVisiblity() { setFlag(Hidden, isVisible()); }
     // set locked status
     bool IsLocked() { return locked; }
-    // get the ID
+    // get the stable ID, this is saved with the scene
     int GetId() { return id; }
-    // set the ID
-    void SetId(int val) { id = val; }
+    // set the stable ID, used when loading an entity back in
+    void SetId(int val);
+    // get a generational handle that is safe to hold after we are destroyed
+    EntityHandle getHandle() const { return handle; }
+    // the list we are in, nullptr if we aren't in one
+    Entities::EntityList* getList() const { return list; }
+    void setList(Entities::EntityList* newList) { list = newList; }
+    // the scene name index we are in
+    Entities::NameIndex* getNameIndex() const { return nameIndex; }
+    void setNameIndex(Entities::NameIndex* index) { nameIndex = index; }
+    // the scene query index we are in
+    Entities::QueryIndex* getQueryIndex() const { return queryIndex; }
+    void setQueryIndex(Entities::QueryIndex* index) { queryIndex = index; }
+    // our parent in the transform hierarchy, nullptr for roots; set through the scene's TransformHierarchy
+    Entities::Entity* getParent() const { return parent.get(); }
+    // entities parented to us, may include ones destroyed this frame
+    const std::vector<EntityHandle>& getChildren() const { return children; }
+    // the prefab we are an instance of, nullptr if we weren't made from one; we only save what differs from it
+    const Entities::Prefab* getPrefab() const { return prefab; }
+    void setPrefab(const Entities::Prefab* newPrefab) { prefab = newPrefab; }
 
     bool hasComponent(const std::string& type);
 
     void addComponent(const std::string& type);
 
-    // core components are public for easy modification and access
-    Components::Transform* transform;
-    Components::Sprite3D* sprite;
-    Components::Physics* physics;
-    Components::BoundingBox* boundingBox;
+    // core components are public for easy modification and access; the sprite may be our prefab's, so it is
+    // changed through get<Components::Sprite3D>()
+    Components::Transform* transform = nullptr;
+    const Components::Sprite3D* sprite = nullptr;
+    Components::Physics* physics = nullptr;
+    Components::BoundingBox* boundingBox = nullptr;
 
   protected:
 
     int id;
+    EntityHandle handle; // our slot in the entity registry
     bool destroyed;
-    bool visible = true;
     bool selected = false; // if we are selected by the inspector
     bool needsComponentSort = true; // flag for sorting components
     bool locked = false; // locked entities cannot be edited
@@ -96,8 +180,39 @@ namespace Entities
     std::vector<Components::Component*> components; // entity component list
     std::vector<Variable> variables;
 
+    Entities::EntityList* list = nullptr; // the list that holds us
+    int listIndex = -1; // where we are in our list, kept by the list so removing us doesn't search it
+    Entities::NameIndex* nameIndex = nullptr; // keeps our name unique within the scene
+    Entities::QueryIndex* queryIndex = nullptr; // keeps the scene's cached views up to date
+    bool queryPending = false; // waiting for the query index to re-check us
+
+    EntityHandle parent; // transform parent
+    std::vector<EntityHandle> children;
+
+    const Entities::Prefab* prefab = nullptr; // shared data owned by the entity factory
+
+    // type indexed table of our components, one per component type, plus a bit for each filled slot
+    Components::Component* slots[Components::Component::None] = {};
+    ComponentTypeMask componentMask = 0;
+    EntityFlags flags = 0;
+
   private:
 
+    friend class EntityList;
+    friend class NameIndex;
+    friend class QueryIndex;
+    friend class TransformHierarchy;
+
+    // change the name without telling the name index, used by the index itself
+    void setNameUnindexed(const std::string& newName) { name = newName; }
+
+    // rebuild the component slots and core pointers after components were added or removed
+    void updateComponentSlots();
+    // replace a component shared with our prefab by a copy of our own
+    Components::Component* copyShared(Components::Component* shared);
+
+    static constexpr ComponentTypeMask TypeBit(Components::Component::ComponentType type) { return ComponentTypeMask(1) << type; }
+
   };
 
 }
\ No newline at end of file
@@ -18,6 +18,9 @@ namespace fs = std::filesystem;
 // initialize the entity factory and load all the archetypes from HJSON data
 Entities::EntityFactory::EntityFactory(std::string directoryPath) : System("EntityFactory")
 {
+  readsResource(Systems::Resource::Assets);
+  SetMainThreadOnly(false);
+
   // check if the directory exists and if it is a directory
   if (fs::is_directory(directoryPath) && fs::exists(directoryPath))
   {
@@ -46,7 +49,8 @@ void Entities::EntityFactory::addArchetype(std::string name, std::string filePat
   // don't add to the archetype if it doesn't exist (for some reason)
   if (fs::exists(filePath))
   {
-    archetypes[name] = loadEntity(filePath);
+    delete archetypes[name];
+    archetypes[name] = new Entities::Prefab(name, loadEntity(filePath));
   }
 }
 
@@ -54,7 +58,11 @@ void Entities::EntityFactory::addArchetype(std::string name, std::string filePat
 Entities::Entity* Entities::EntityFactory::loadEntity(std::string filePath)
 {
   // entity to load data into
-  Entities::Entity* entity = new Entities::Entity();
+  Entities::Entity* entity = new Entities::Entity(fs::path(filePath).stem().string());
+
+  // every archetype can be placed and drawn
+  entity->addComponent(new Components::Transform());
+  entity->addComponent(new Components::Sprite3D());
 
   // parse the hjson data
   try 
@@ -64,6 +72,22 @@ Entities::Entity* Entities::EntityFactory::loadEntity(std::string filePath)
     file >> data;
     file.close();
 
+    if (data.contains("name"))
+    {
+      entity->setName(data["name"].get<std::string>());
+    }
+
+    if (data.contains("model"))
+    {
+      entity->get<Components::Sprite3D>()->setModel(data["model"].get<std::string>());
+    }
+
+    // archetypes can also list components the same way scenes save them
+    if (data.contains("Components"))
+    {
+      entity->Load(data);
+    }
+
     // call entity load
     entity->load(data);
   }
@@ -79,38 +103,43 @@ Entities::Entity* Entities::EntityFactory::loadEntity(std::string filePath)
 // creates an entity given a name
 Entities::Entity* Entities::EntityFactory::createEntity(std::string name, Vector3D position, EntityType type)
 {
+  const Entities::Prefab* prefab = getPrefab(name);
+
   // if archetype was invalid, return an empty entity
-  if (!archetypes[name])
+  if (!prefab)
   {
     Logger::error("Failed to create entity from " + name);
-    return new Entities::Entity();
+    Entities::Entity* entity = new Entities::Entity();
+    entity->addComponent(new Components::Transform());
+    entity->addComponent(new Components::Sprite3D());
+    return entity;
   }
 
-  // if valid, clone the entity
-  Entities::Entity* entity = new Entities::Entity(*archetypes[name]);
-
-  if (!entity->transform && !entity->sprite)
-  {
-    entity->addComponent(entity->transform = new Components::Transform());
-    entity->addComponent(entity->sprite = new Components::Sprite3D());
-  }
+  // if valid, make an instance; the copy shares the prefab's model instead of loading its own
+  return prefab->instantiate();
+}
 
-  return entity;
+const Entities::Prefab* Entities::EntityFactory::getPrefab(const std::string& name) const
+{
+  auto it = archetypes.find(name);
+  return it != archetypes.end() ? it->second : nullptr;
 }
 
 // creates an actor given a name
 Entities::Actor* Entities::EntityFactory::createActor(std::string name, Vector3D position, EntityType type)
 {
+  const Entities::Prefab* prefab = getPrefab(name);
+
   // if archetype was invalid, return an empty entity
-  if (!archetypes[name])
+  if (!prefab)
   {
     Logger::error("Failed to create actor " + name);
     return new Entities::Actor();
   }
 
-  // if valid, clone the entity
-  Entities::Actor* entity = new Entities::Actor(*archetypes[name]);
-
+  // the actor starts from the archetype's components and only adds the ones it is missing
+  Entities::Actor* entity = new Entities::Actor(*prefab->getArchetype());
+  entity->setPrefab(prefab);
   return entity;
 }
 
@@ -136,6 +165,6 @@ Entities::Entity* Entities::EntityFactory::CreateBaseEntity(std::string name, Ve
 {
   Entities::Entity* entity = new Entities::Entity(name);
   entity->addComponent(entity->transform = new Components::Transform(position, { 3,3,3 },{0,0,0}));
-  entity->addComponent(entity->sprite = new Components::Sprite3D());
+  entity->addComponent(new Components::Sprite3D());
   return entity;
 }
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Components/Component.h"
+#include "Prefab.h"
 
 namespace Entities
 {
@@ -24,11 +25,13 @@ namespace Entities
     // add an entity to the archetype map
     void addArchetype(std::string name, std::string filePath);
 
-    // load an entity's data
+    // load an archetype entity from its file
     Entities::Entity* loadEntity(std::string name);
-    std::map<std::string, Entities::Entity*>& GetArchetypes() { return archetypes; }
+    const std::map<std::string, Entities::Prefab*>& GetArchetypes() const { return archetypes; }
+    // get a prefab by name, nullptr if there isn't one
+    const Entities::Prefab* getPrefab(const std::string& name) const;
 
-    // create an entity and add it to the active scene (using loadEntity())
+    // create an instance of a prefab; it shares the prefab's model and only stores what it changes
     Entities::Entity* createEntity(std::string name, Vector3D position, EntityType type = EntityType::Entity);
     Entities::Actor* createActor(std::string name, Vector3D position, EntityType type = EntityType::Entity);
 
@@ -39,6 +42,6 @@ namespace Entities
   private:
 
     // map of names to entity archetypes
-    std::map<std::string, Entities::Entity*> archetypes;
+    std::map<std::string, Entities::Prefab*> archetypes;
   };
 }
\ No newline at end of file
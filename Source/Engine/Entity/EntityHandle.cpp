@@ -0,0 +1,130 @@
+/*
+/
+// filename: EntityHandle.cpp
+// author: Callen Betts
+// brief: implements EntityHandle.h
+/
+*/
+
+#include "stdafx.h"
+#include "EntityHandle.h"
+
+Entities::Entity* Entities::EntityHandle::get() const
+{
+  return EntityRegistry::instance().get(*this);
+}
+
+bool Entities::EntityHandle::isValid() const
+{
+  return EntityRegistry::instance().isValid(*this);
+}
+
+// reuse a free slot if we have one, otherwise grow the slot array
+Entities::EntityHandle Entities::EntityRegistry::create(Entities::Entity* entity)
+{
+  std::uint32_t index;
+
+  if (freeHead != EntityHandle::InvalidIndex)
+  {
+    index = freeHead;
+    freeHead = slots[index].nextFree;
+  }
+  else
+  {
+    index = static_cast<std::uint32_t>(slots.size());
+    slots.emplace_back();
+  }
+
+  Slot& slot = slots[index];
+  slot.entity = entity;
+  slot.nextFree = EntityHandle::InvalidIndex;
+  count++;
+
+  EntityHandle handle;
+  handle.index = index;
+  handle.generation = slot.generation;
+
+  assignStableId(handle);
+  return handle;
+}
+
+// bump the generation so old handles fail their check, then push the slot onto the free list
+void Entities::EntityRegistry::release(EntityHandle handle)
+{
+  if (!isValid(handle))
+    return;
+
+  Slot& slot = slots[handle.index];
+
+  // another entity may have loaded with our id since, only forget it if it is still ours
+  auto it = stableIds.find(slot.stableId);
+  if (it != stableIds.end() && it->second == handle.index)
+  {
+    stableIds.erase(it);
+  }
+
+  slot.entity = nullptr;
+  slot.stableId = 0;
+  slot.generation++;
+
+  // skip the null generation when the counter wraps
+  if (slot.generation == 0)
+  {
+    slot.generation = 1;
+  }
+
+  slot.nextFree = freeHead;
+  freeHead = handle.index;
+  count--;
+}
+
+std::uint32_t Entities::EntityRegistry::assignStableId(EntityHandle handle, std::uint32_t id)
+{
+  if (!isValid(handle))
+    return 0;
+
+  Slot& slot = slots[handle.index];
+
+  if (id == 0)
+  {
+    id = nextStableId++;
+  }
+  else if (id >= nextStableId)
+  {
+    // loaded ids push the counter forward so new entities never reuse them
+    nextStableId = id + 1;
+  }
+
+  auto it = stableIds.find(slot.stableId);
+  if (it != stableIds.end() && it->second == handle.index)
+  {
+    stableIds.erase(it);
+  }
+
+  // a freshly loaded entity takes the id over from one that is waiting to be destroyed
+  slot.stableId = id;
+  stableIds[id] = handle.index;
+
+  return id;
+}
+
+std::uint32_t Entities::EntityRegistry::getStableId(EntityHandle handle) const
+{
+  if (!isValid(handle))
+    return 0;
+
+  return slots[handle.index].stableId;
+}
+
+Entities::EntityHandle Entities::EntityRegistry::findByStableId(std::uint32_t id) const
+{
+  auto it = stableIds.find(id);
+
+  if (it == stableIds.end())
+    return EntityHandle();
+
+  EntityHandle handle;
+  handle.index = it->second;
+  handle.generation = slots[it->second].generation;
+  return handle;
+}
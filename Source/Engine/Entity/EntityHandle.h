@@ -0,0 +1,113 @@
+/*
+/
+// filename: EntityHandle.h
+// author: Callen Betts
+// brief: defines generational entity handles and the slot map that resolves them
+//
+// description: A handle is an index into the entity registry plus the generation of that slot when the handle
+//  was made. Destroying an entity bumps its slot's generation, so every handle still pointing at it resolves to
+//  nullptr instead of dangling. Checking a handle is one array read and one compare.
+//
+//  Every entity also has a stable id. Unlike the handle it is written to the scene file, so references between
+//  entities survive saving and loading.
+/
+*/
+
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+
+namespace Engine
+{
+  class WorldContext;
+}
+
+namespace Entities
+{
+  class Entity;
+
+  struct EntityHandle
+  {
+    static constexpr std::uint32_t InvalidIndex = 0xFFFFFFFF;
+
+    std::uint32_t index = InvalidIndex;
+    std::uint32_t generation = 0;
+
+    // resolve the handle, nullptr if the entity was destroyed
+    Entities::Entity* get() const;
+    // if the entity we point at still exists
+    bool isValid() const;
+    // if this handle was never assigned
+    bool isNull() const { return index == InvalidIndex; }
+
+    // pack the handle into a single integer for hashing and sorting
+    std::uint64_t value() const { return (static_cast<std::uint64_t>(generation) << 32) | index; }
+
+    bool operator==(const EntityHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+  };
+
+  class EntityRegistry
+  {
+
+  public:
+
+    // the registry of the world stepping on this thread, or the process's own
+    static EntityRegistry& instance() {
+      static EntityRegistry registry;
+      return bound ? *bound : registry;
+    }
+
+    // give an entity a slot and a fresh stable id
+    EntityHandle create(Entities::Entity* entity);
+    // free an entity's slot, invalidating every handle to it
+    void release(EntityHandle handle);
+
+    // resolve a handle, nullptr if it is stale
+    Entities::Entity* get(EntityHandle handle) const
+    {
+      if (handle.index >= slots.size() || slots[handle.index].generation != handle.generation)
+        return nullptr;
+
+      return slots[handle.index].entity;
+    }
+
+    bool isValid(EntityHandle handle) const { return get(handle) != nullptr; }
+
+    // set the stable id of an entity, 0 generates a new unique one; returns the id that was assigned
+    std::uint32_t assignStableId(EntityHandle handle, std::uint32_t id = 0);
+    std::uint32_t getStableId(EntityHandle handle) const;
+    // find the live entity that owns a stable id
+    EntityHandle findByStableId(std::uint32_t id) const;
+
+    // amount of living entities
+    int getCount() const { return count; }
+
+  private:
+
+    friend class Engine::WorldContext;
+
+    EntityRegistry() = default;
+
+    // set while a world steps, see Engine::WorldContext
+    static inline thread_local EntityRegistry* bound = nullptr;
+
+    struct Slot
+    {
+      Entities::Entity* entity = nullptr;
+      std::uint32_t generation = 1; // generation 0 is reserved for null handles
+      std::uint32_t nextFree = EntityHandle::InvalidIndex;
+      std::uint32_t stableId = 0;
+    };
+
+    std::vector<Slot> slots;
+    std::uint32_t freeHead = EntityHandle::InvalidIndex;
+
+    std::unordered_map<std::uint32_t, std::uint32_t> stableIds; // stable id to slot index
+    std::uint32_t nextStableId = 1;
+
+    int count = 0;
+
+  };
+
+}
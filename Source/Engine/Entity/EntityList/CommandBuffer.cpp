@@ -0,0 +1,156 @@
+/*
+/
+// filename: CommandBuffer.cpp
+// author: Callen Betts
+// brief: implements CommandBuffer.h
+/
+*/
+
+#include "stdafx.h"
+#include "CommandBuffer.h"
+#include "EntityList.h"
+#include "Engine/Entity/Entity.h"
+
+Entities::CommandBuffer::~CommandBuffer()
+{
+  clear();
+}
+
+void Entities::CommandBuffer::spawn(Entities::Entity* entity, Entities::EntityList* list, int index)
+{
+  Command command;
+  command.type = CommandType::Spawn;
+  command.spawned = entity;
+  command.to = list;
+  command.index = index;
+  record(command);
+}
+
+void Entities::CommandBuffer::destroy(Entities::Entity* entity)
+{
+  Command command;
+  command.type = CommandType::Destroy;
+  command.handle = entity->getHandle();
+  record(command);
+}
+
+void Entities::CommandBuffer::move(Entities::Entity* entity, Entities::EntityList* from, Entities::EntityList* to, int index)
+{
+  Command command;
+  command.type = CommandType::Move;
+  command.handle = entity->getHandle();
+  command.from = from;
+  command.to = to;
+  command.index = index;
+  record(command);
+}
+
+void Entities::CommandBuffer::addComponent(Entities::Entity* entity, Components::Component* component)
+{
+  Command command;
+  command.type = CommandType::AddComponent;
+  command.handle = entity->getHandle();
+  command.component = component;
+  record(command);
+}
+
+// recorded by type rather than by pointer; the component may be deleted or replaced before playback
+void Entities::CommandBuffer::removeComponent(Entities::Entity* entity, Components::Component::ComponentType type)
+{
+  Command command;
+  command.type = CommandType::RemoveComponent;
+  command.handle = entity->getHandle();
+  command.componentType = type;
+  record(command);
+}
+
+void Entities::CommandBuffer::record(const Command& command)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  commands.push_back(command);
+}
+
+void Entities::CommandBuffer::playback()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    playing.swap(commands);
+  }
+
+  for (const Command& command : playing)
+  {
+    // the entity may have died since the command was queued, in which case this is nullptr
+    Entities::Entity* entity = command.handle.get();
+
+    switch (command.type)
+    {
+
+    case CommandType::Spawn:
+      if (!command.to)
+      {
+        Logger::error("Spawned entity " + command.spawned->getName() + " has no list");
+        delete command.spawned;
+        break;
+      }
+
+      if (command.index < 0)
+        command.to->add(command.spawned);
+      else
+        command.to->insert(command.spawned, command.index);
+      break;
+
+    case CommandType::Destroy:
+      // the list compacts destroyed entities out when it syncs
+      if (entity)
+        entity->destroy();
+      break;
+
+    case CommandType::Move:
+      if (entity && command.from && command.to)
+      {
+        command.from->remove(entity);
+
+        if (command.index < 0)
+          command.to->add(entity);
+        else
+          command.to->insert(entity, command.index);
+      }
+      break;
+
+    case CommandType::AddComponent:
+      if (entity)
+        entity->addComponent(command.component);
+      else
+        delete command.component;
+      break;
+
+    case CommandType::RemoveComponent:
+      if (entity)
+      {
+        Components::Component* component = entity->getComponent(command.componentType);
+        if (component)
+          entity->DeleteComponent(component);
+      }
+      break;
+
+    }
+  }
+
+  playing.clear();
+}
+
+void Entities::CommandBuffer::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // nothing else owns these until they're played back
+  for (const Command& command : commands)
+  {
+    if (command.type == CommandType::Spawn)
+      delete command.spawned;
+    else if (command.type == CommandType::AddComponent)
+      delete command.component;
+  }
+
+  commands.clear();
+}
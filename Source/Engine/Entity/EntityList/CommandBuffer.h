@@ -0,0 +1,89 @@
+/*
+/
+// filename: CommandBuffer.h
+// author: Callen Betts
+// brief: defines a queue of structural changes that are applied once per frame
+//
+// description: Spawning, destroying, moving an entity between lists and adding or removing components all
+//  change the containers that are being iterated during an update. Instead of doing them on the spot, anything
+//  running during the update records a command here. The scene plays the buffer back at a single sync point
+//  after every list has finished updating, then each list compacts itself in one pass.
+//
+//  Recording is guarded by a mutex so updates running on worker threads can queue changes safely; playback
+//  happens on the main thread. Entities and components handed to the buffer belong to it until playback, and
+//  are deleted with it if they're never played back.
+/
+*/
+
+#pragma once
+#include "Engine/Entity/EntityHandle.h"
+#include "Engine/Entity/Components/Component.h"
+#include <mutex>
+
+namespace Entities
+{
+  class Entity;
+  class EntityList;
+
+  class CommandBuffer
+  {
+
+  public:
+
+    CommandBuffer() = default;
+    ~CommandBuffer();
+
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    // add a new entity to a list, at the end if index is negative
+    void spawn(Entities::Entity* entity, Entities::EntityList* list, int index = -1);
+    // destroy an entity and remove it from its list
+    void destroy(Entities::Entity* entity);
+    // move an entity from one list into another, at the end if index is negative
+    void move(Entities::Entity* entity, Entities::EntityList* from, Entities::EntityList* to, int index = -1);
+    // attach a component to an entity
+    void addComponent(Entities::Entity* entity, Components::Component* component);
+    // delete an entity's component of the given type, if it still has one at playback
+    void removeComponent(Entities::Entity* entity, Components::Component::ComponentType type);
+
+    // apply every queued command in the order it was recorded
+    void playback();
+    // drop every queued command, deleting the entities and components that were waiting to be added
+    void clear();
+
+    bool empty() const { return commands.empty(); }
+    size_t getCount() const { return commands.size(); }
+
+  private:
+
+    enum class CommandType
+    {
+      Spawn,
+      Destroy,
+      Move,
+      AddComponent,
+      RemoveComponent
+    };
+
+    struct Command
+    {
+      CommandType type;
+      Entities::EntityHandle handle; // the entity we act on, skipped if it died before playback
+      Entities::Entity* spawned = nullptr; // entity to spawn, not in any list yet
+      Entities::EntityList* from = nullptr;
+      Entities::EntityList* to = nullptr;
+      int index = -1;
+      Components::Component* component = nullptr; // component to add, not on any entity yet
+      Components::Component::ComponentType componentType = Components::Component::ComponentType::None;
+    };
+
+    void record(const Command& command);
+
+    std::vector<Command> commands;
+    std::vector<Command> playing; // swapped with commands during playback so new commands go to next frame
+    std::mutex mutex;
+
+  };
+
+}
@@ -15,6 +15,9 @@
 #include "Engine/GlowEngine.h"
 #include "Game/Scene/Scene.h"
 #include "Game/Scene/SceneSystem.h"
+#include "Engine/Systems/Jobs/JobSystem.h"
+#include "NameIndex.h"
+#include "QueryIndex.h"
 #include <algorithm>
 
 // base constructor
@@ -30,23 +33,99 @@ Entities::EntityList::EntityList(std::string newName)
 // add a given entity to the list
 void Entities::EntityList::add(Entities::Entity* entity)
 {
-  // ensure no duplicate named entities
-  if (entity->getName() == "Entity")
-  {
-    entity->setName("Entity"+std::to_string(activeList.size()));
-  }
-
+  track(entity);
+  entity->listIndex = (int)activeList.size();
   activeList.push_back(entity);
   size++;
 }
 
 void Entities::EntityList::insert(Entities::Entity* entity, int index)
 {
-  index = std::clamp(index, 0, (int)activeList.size());
+  index = std::clamp(index, 0, (int)activeList.size() - removedCount);
+
+  // the index counts the entities still in the list, step over the empty slots removals left behind
+  int slot = index;
+  if (removedCount > 0)
+  {
+    slot = 0;
+    for (int seen = 0; slot < (int)activeList.size() && (seen < index || !activeList[slot]); ++slot)
+    {
+      if (activeList[slot])
+        ++seen;
+    }
+  }
 
-  auto it = activeList.begin() + index;
-  activeList.insert(it, entity);
+  track(entity);
+  activeList.insert(activeList.begin() + slot, entity);
   size++;
+
+  // everything after us moved up one
+  for (int i = slot; i < (int)activeList.size(); ++i)
+  {
+    if (activeList[i])
+      activeList[i]->listIndex = i;
+  }
+}
+
+// remember which list an entity is in, make sure its name is unique in the scene and add it to the scene's views
+void Entities::EntityList::track(Entities::Entity* entity)
+{
+  entity->setList(this);
+
+#ifdef _DEBUG
+  // another scene's arena is freed with that scene, taking this entity with it
+  Memory::PoolAllocator* owner = Memory::PoolAllocator::OwnerOf(entity);
+  if (parentScene && owner->isArena() && owner != &parentScene->getArena())
+  {
+    Logger::error(entity->getName() + " moved between scenes without being copied, it dies with the scene it came from");
+  }
+#endif
+
+  if (queryIndex)
+  {
+    queryIndex->add(entity);
+  }
+
+  if (nameIndex)
+  {
+    nameIndex->add(entity);
+  }
+  else if (entity->getName() == "Entity")
+  {
+    // lists outside of a scene have no index, so just number default names
+    entity->setName("Entity" + std::to_string(activeList.size()));
+  }
+}
+
+// give this list and every sublist under it the scene's indices
+void Entities::EntityList::setIndices(Entities::NameIndex* names, Entities::QueryIndex* queries)
+{
+  nameIndex = names;
+  queryIndex = queries;
+
+  for (Entities::Entity* entity : activeList)
+  {
+    if (nameIndex)
+    {
+      nameIndex->add(entity);
+    }
+
+    if (queryIndex)
+    {
+      queryIndex->add(entity);
+    }
+  }
+
+  for (Entities::EntityList* list : subLists)
+  {
+    list->setIndices(names, queries);
+  }
+}
+
+void Entities::EntityList::addSubList(Entities::EntityList* list)
+{
+  list->setIndices(nameIndex, queryIndex);
+  subLists.push_back(list);
 }
 
 /// <summary>
@@ -62,12 +141,30 @@ nlohmann::json Entities::EntityList::Save()
     list->Save();
   }
 
-  // Iterate over our entites and add their data to the json object
-  for (const auto& entity : activeList)
+  // serialize every entity on its own, this only reads so it can be spread over the job system
+  std::vector<nlohmann::json> entityData(activeList.size());
+  auto saveRange = [this, &entityData](int begin, int end) {
+    for (int i = begin; i < end; ++i)
+    {
+      if (!activeList[i]->IsLocked())
+      {
+        entityData[i] = activeList[i]->Save();
+      }
+    }
+  };
+
+  Jobs::JobSystem* jobs = EngineInstance::GetJobSystem();
+  if (jobs)
+    jobs->parallelFor((int)activeList.size(), 16, saveRange);
+  else
+    saveRange(0, (int)activeList.size());
+
+  // then add them in list order so the file is the same no matter how the work was split
+  for (size_t i = 0; i < activeList.size(); ++i)
   {
-    if (!entity->IsLocked())
+    if (!activeList[i]->IsLocked())
     {
-      saveData[entity->getName()] = entity->Save();
+      saveData[activeList[i]->getName()] = std::move(entityData[i]);
     }
   }
 
@@ -145,73 +242,87 @@ void Entities::EntityList::DeleteAllEntities()
   DeleteEntities();
 }
 
-// update a list of entities
+// update a list of entities; the list itself is not changed here, destroyed entities are compacted out in sync()
 void Entities::EntityList::update()
 {
-  // update our parent scene to the current scene
-  parentScene = EngineInstance::getEngine()->getSceneSystem()->getCurrentScene();
+  // lists outside a scene gather into the engine's current one
+  Scene::Scene* scene = parentScene ? parentScene : EngineInstance::getEngine()->getSceneSystem()->getCurrentScene();
 
-  for (auto it = activeList.begin(); it != activeList.end(); )
+  // index based so anything added during the update can't invalidate our position; it gets updated next frame
+  const size_t count = activeList.size();
+  for (size_t i = 0; i < count; ++i)
   {
-    // check for destroyed entities
-    if ((*it)->isDestroyed())
-    {
-      destroyList.push_back(*it);
+    Entities::Entity* entity = activeList[i];
+
+    // destroyed entities stay in place until the sync point
+    if (entity->isDestroyed())
+      continue;
+
+    // components are updated by type in the scene's update pipeline, not per entity
+    scene->getUpdatePipeline().gather(entity);
+  }
 
-      // erase the entity from the active list and get the new iterator position
-      it = activeList.erase(it);
+  // recursively update any of our sublists
+  for (auto& list : subLists)
+  {
+    list->parentScene = scene;
+    list->update();
+  }
+}
+
+/// <summary>
+/// Apply structural changes once every list has updated. Destroyed entities are removed in a single stable
+/// pass so the hierarchy order is kept, then deleted; destroyed sublists are deleted the same way.
+/// </summary>
+void Entities::EntityList::sync()
+{
+  size_t write = 0;
+  for (size_t read = 0; read < activeList.size(); ++read)
+  {
+    Entities::Entity* entity = activeList[read];
+
+    // slots emptied by remove
+    if (!entity)
+      continue;
+
+    if (entity->isDestroyed())
+    {
+      destroyList.push_back(entity);
     }
     else
     {
-      // add colliders to a separate list for update
-      Components::Collider* col = getComponentOfType(Collider, (*it));
-
-      if (col)
-      {
-        if (!col->isStatic())
-        {
-          parentScene->getGlobalList()->getNonStaticList().push_back((*it));
-        }
-        parentScene->getGlobalList()->getColliderList().push_back((*it));
-      }
-
-      // update the entity and increment the iterator
-      (*it)->update();
-      ++it;
+      entity->listIndex = (int)write;
+      activeList[write++] = entity;
     }
   }
+  activeList.resize(write);
+  size = (int)activeList.size();
+  removedCount = 0;
 
   // destroy entities
   for (auto& entity : destroyList)
   {
-    entity->~Entity();
     delete entity;
   }
   destroyList.clear();
 
-  // recursively update any of our sublists
-  for (auto& list : subLists)
+  // sync our sublists and drop any that were marked for destroy
+  size_t keep = 0;
+  for (size_t i = 0; i < subLists.size(); ++i)
   {
-    list->update();
-  }
+    Entities::EntityList* list = subLists[i];
+    list->sync();
 
-  // Delete ourself if we are marked for destroy
-  if (destroyed)
-  {
-    delete this;
+    if (list->destroyed)
+    {
+      delete list;
+    }
+    else
+    {
+      subLists[keep++] = list;
+    }
   }
-}
-
-// this function is used to update our global list and check for collisions
-void Entities::EntityList::updateColliders()
-{
-  if (colliderList.empty())
-    return;
-
-  checkCollisions();
-
-  colliderList.clear();
-  nonStaticList.clear();
+  subLists.resize(keep);
 }
 
 // update a list of entities
@@ -240,67 +351,46 @@ void Entities::EntityList::clear()
   }
   activeList.clear();
   subLists.clear();
+  size = 0;
+  removedCount = 0;
 }
 
-// removes an entity from the list and deletes it
+// removes an entity from the list without deleting it; the slot is emptied rather than erased, so moving many
+// entities doesn't shift the list once per entity, and sync compacts it in one pass
 void Entities::EntityList::remove(Entities::Entity* entityToRemove)
 {
-  auto it = std::find_if(activeList.begin(), activeList.end(),
-    [entityToRemove](Entities::Entity* entity) {
-      return entity == entityToRemove;
-    });
-  if (it != activeList.end()) {
-    activeList.erase(it);
-  }
-}
+  int index = entityToRemove->listIndex;
 
-void Entities::EntityList::checkCollisions()
-{
-  for (auto it1 = nonStaticList.begin(); it1 != nonStaticList.end(); ++it1)
+  // the editor reorders the list directly, so search if our index is out of date
+  if (index < 0 || index >= (int)activeList.size() || activeList[index] != entityToRemove)
   {
-    Entity* ent1 = *it1;
-    Components::Collider* collider1 = getComponentOfType(Collider, ent1);
+    auto it = std::find(activeList.begin(), activeList.end(), entityToRemove);
+    if (it == activeList.end())
+      return;
 
-    for (auto it2 = colliderList.begin(); it2 != colliderList.end(); ++it2)
-    {
-      Entity* ent2 = *it2;
-
-      // don't collide with ourselves; this seems strange, but this allows us to have absurd amounts
-      // of static colliders with almost zero drawback
-      if (ent2 == ent1)
-        continue;
-
-      Components::Collider* collider2 = getComponentOfType(Collider, ent2);
+    index = (int)(it - activeList.begin());
+  }
 
-      // if both colliders are static, then we don't want to do any collision logic
-      // this reduces our collision to O(N) complexity  
-      if (collider2->isStatic() && collider1->isStatic()) 
-        break;
+  activeList[index] = nullptr;
+  removedCount++;
+  size--;
 
-      // detect collisions
-      if (collider1->isColliding(collider2)) 
-      {
-        collider2->updateCollision(collider1);
-        collider1->updateCollision(collider2);
-      }
-      else
-      {
-        if (collider1->getCollidingObjects().find(collider2) != collider1->getCollidingObjects().end() 
-          && collider1->hasCollided() 
-          && collider2->hasCollided())
-        {
-          collider2->leaveCollision(collider1);
-          collider1->leaveCollision(collider2);
-        }
-      }
-    }
+  // the entity keeps its name in the scene index, it is usually on its way to another list
+  if (entityToRemove->getList() == this)
+  {
+    entityToRemove->setList(nullptr);
+    entityToRemove->listIndex = -1;
   }
-  colliderList.clear();
-  nonStaticList.clear();
 }
 
 Entities::Entity* Entities::EntityList::find(std::string name)
 {
+  // constant time lookup over the whole scene
+  if (nameIndex)
+  {
+    return nameIndex->find(name);
+  }
+
   for (auto entity : activeList)
   {
     if (entity->getName() == name)
@@ -315,7 +405,17 @@ Entities::Entity* Entities::EntityList::find(std::string name)
 // given a source index and a destination index, we move two entities within a list
 void Entities::EntityList::ReorderEntities(int srcIndex, int dstIndex)
 {
-  auto entity = activeList[srcIndex];
-  activeList.erase(activeList.begin() + srcIndex);
-  activeList.insert(activeList.begin() + dstIndex, entity);
+  // rotate only the range between the two indices instead of shifting the whole tail twice
+  auto src = activeList.begin() + srcIndex;
+  auto dst = activeList.begin() + dstIndex;
+
+  if (srcIndex < dstIndex)
+    std::rotate(src, src + 1, dst + 1);
+  else if (srcIndex > dstIndex)
+    std::rotate(dst, src, src + 1);
+
+  for (int i = (std::min)(srcIndex, dstIndex); i <= (std::max)(srcIndex, dstIndex); ++i)
+  {
+    activeList[i]->listIndex = i;
+  }
 }
@@ -12,6 +12,8 @@ namespace Entities
 {
   class Entity;
   class EntityList;
+  class NameIndex;
+  class QueryIndex;
 
   // define a wrapper for entity lists
   class EntityListWrapper
@@ -67,11 +69,14 @@ namespace Entities
 
     void add(Entities::Entity* entity);
     void update();
-    void updateColliders();
+    // sync point: remove and delete destroyed entities and lists, called once after every list has updated
+    void sync();
     void render();
     void clear();
+    // take an entity out without deleting it, in constant time; its slot stays empty until the list syncs, so
+    // only the command buffer calls this, while it plays back right before the sync
     void remove(Entities::Entity* entity);
-    void checkCollisions();
+    // put an entity at a position among the entities still in the list
     void insert(Entities::Entity* entity, int index);
     nlohmann::json Save();
     Entities::EntityList* FindSublist(std::string name);
@@ -82,8 +87,18 @@ namespace Entities
     void DeleteEntities();
     void DeleteAllEntities();
 
+    // find an entity by name; lists in a scene search the whole scene through its name index
     Entities::Entity* find(std::string name);
 
+    // set the scene indices of this list and every sublist, entities already in them are indexed
+    void setIndices(Entities::NameIndex* names, Entities::QueryIndex* queries);
+    Entities::NameIndex* getNameIndex() { return nameIndex; }
+    Entities::QueryIndex* getQueryIndex() { return queryIndex; }
+    // add a sublist that shares our indices
+    void addSubList(Entities::EntityList* list);
+    // the scene whose pipeline we gather into; sublists take their parent's
+    void setScene(Scene::Scene* scene) { parentScene = scene; }
+
     int getSize() { return size; }
     std::string getName() { return name; }
     void SetName(std::string name_) { name = name_; }
@@ -92,8 +107,6 @@ namespace Entities
     std::vector<Entities::Entity*>& getEntities() { return activeList; }
     const std::vector<Entities::Entity*>& getEntities() const { return activeList; }
 
-    std::vector<Entities::Entity*>& getColliderList() { return colliderList; }
-    std::vector<Entities::Entity*>& getNonStaticList() { return nonStaticList; }
     std::vector<Entities::EntityList*>& getSubLists() { return subLists; }
 
     // reorder the entities by id
@@ -101,20 +114,25 @@ namespace Entities
 
   private:
 
+    // point an entity added to us back at us, index its name and add it to the scene's views
+    void track(Entities::Entity* entity);
+
     // vectors of lists for handling updates and collisions
     std::vector<Entities::Entity*> activeList;
     std::vector<Entities::Entity*> destroyList;
 
-    std::vector<Entities::Entity*> colliderList;
-    std::vector<Entities::Entity*> nonStaticList;
-
     std::vector<Entities::EntityList*> subLists; // used for scene hierarchy drawing
 
     // pointer to our parent scene
     Scene::Scene* parentScene = nullptr;
+    // the scene's name and query indices, nullptr for lists that aren't part of a scene hierarchy
+    Entities::NameIndex* nameIndex = nullptr;
+    Entities::QueryIndex* queryIndex = nullptr;
 
     // size of current active list
     int size;
+    // empty slots left by remove, compacted out at the sync point
+    int removedCount = 0;
     bool destroyed; // we can mark an entire list for delete
 
     // name of entity list for display purposes
@@ -0,0 +1,105 @@
+/*
+/
+// filename: NameIndex.cpp
+// author: Callen Betts
+// brief: implements NameIndex.h
+/
+*/
+
+#include "stdafx.h"
+#include "NameIndex.h"
+#include "Engine/Entity/Entity.h"
+
+void Entities::NameIndex::add(Entities::Entity* entity)
+{
+  // moving between lists of the same scene keeps our entry
+  if (entity->getNameIndex() == this && find(entity->getName()) == entity)
+    return;
+
+  entity->setNameIndex(this);
+  claim(entity);
+}
+
+void Entities::NameIndex::remove(Entities::Entity* entity)
+{
+  auto it = names.find(entity->getName());
+
+  // only erase the entry if it is still ours, a newer entity may have taken the name over
+  if (it != names.end() && it->second == entity->getHandle())
+  {
+    names.erase(it);
+  }
+
+  if (entity->getNameIndex() == this)
+  {
+    entity->setNameIndex(nullptr);
+  }
+}
+
+void Entities::NameIndex::rename(Entities::Entity* entity, const std::string& oldName)
+{
+  auto it = names.find(oldName);
+  if (it != names.end() && it->second == entity->getHandle())
+  {
+    names.erase(it);
+  }
+
+  claim(entity);
+}
+
+Entities::Entity* Entities::NameIndex::find(const std::string& name) const
+{
+  auto it = names.find(name);
+  if (it == names.end())
+    return nullptr;
+
+  Entities::Entity* entity = it->second.get();
+
+  // destroyed entities linger until the end of the frame but no longer own their name
+  if (!entity || entity->isDestroyed())
+    return nullptr;
+
+  return entity;
+}
+
+bool Entities::NameIndex::isTaken(const std::string& name, const Entities::Entity* self) const
+{
+  Entities::Entity* owner = find(name);
+  return owner && owner != self;
+}
+
+std::string Entities::NameIndex::makeUnique(const std::string& name)
+{
+  // strip the trailing number so copies of "Tree3" become "Tree4" rather than "Tree31"
+  size_t end = name.find_last_not_of("0123456789");
+  std::string base = end == std::string::npos ? std::string("Entity") : name.substr(0, end + 1);
+
+  int& suffix = nextSuffix[base];
+  std::string candidate = base + std::to_string(suffix);
+
+  while (isTaken(candidate))
+  {
+    candidate = base + std::to_string(++suffix);
+  }
+
+  suffix++;
+  return candidate;
+}
+
+void Entities::NameIndex::clear()
+{
+  names.clear();
+  nextSuffix.clear();
+}
+
+void Entities::NameIndex::claim(Entities::Entity* entity)
+{
+  // "Entity" is the default name and always gets a number
+  if (entity->getName().empty() || entity->getName() == "Entity" || isTaken(entity->getName(), entity))
+  {
+    // set the name directly, going through setName would come back here
+    entity->setNameUnindexed(makeUnique(entity->getName().empty() ? std::string("Entity") : entity->getName()));
+  }
+
+  names[entity->getName()] = entity->getHandle();
+}
@@ -0,0 +1,55 @@
+/*
+/
+// filename: NameIndex.h
+// author: Callen Betts
+// brief: defines a scene wide hash index from entity names to entities
+//
+// description: Every entity in a scene's lists has a unique name, and the index maps that name to the entity's
+//  handle so finding an entity by name is a hash lookup. Names that are already taken get a number appended;
+//  the next number to try is remembered per base name, so generating a unique name doesn't rescan the scene.
+//  Entities keep a pointer to the index they are in and update it when renamed or deleted.
+/
+*/
+
+#pragma once
+#include "Engine/Entity/EntityHandle.h"
+#include <unordered_map>
+
+namespace Entities
+{
+  class Entity;
+
+  class NameIndex
+  {
+
+  public:
+
+    // index an entity, renaming it first if its name is already taken
+    void add(Entities::Entity* entity);
+    // forget an entity, it keeps its name
+    void remove(Entities::Entity* entity);
+    // move an entity from its old name to its current one, called after the name changed
+    void rename(Entities::Entity* entity, const std::string& oldName);
+
+    // find a live entity by name, nullptr if there isn't one
+    Entities::Entity* find(const std::string& name) const;
+    // if another live entity already uses a name
+    bool isTaken(const std::string& name, const Entities::Entity* self = nullptr) const;
+
+    // get a name nobody in the scene uses yet, built from the given name without its trailing number
+    std::string makeUnique(const std::string& name);
+
+    void clear();
+    int getCount() const { return (int)names.size(); }
+
+  private:
+
+    // take over a name for an entity, making it unique first
+    void claim(Entities::Entity* entity);
+
+    std::unordered_map<std::string, Entities::EntityHandle> names;
+    std::unordered_map<std::string, int> nextSuffix; // base name to the next number to try
+
+  };
+
+}
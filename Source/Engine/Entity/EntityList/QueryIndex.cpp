@@ -0,0 +1,184 @@
+/*
+/
+// filename: QueryIndex.cpp
+// author: Callen Betts
+// brief: implements QueryIndex.h
+/
+*/
+
+#include "stdafx.h"
+#include "QueryIndex.h"
+
+bool Entities::Query::matches(Entities::Entity* entity) const
+{
+  if (entity->isDestroyed())
+    return false;
+
+  const ComponentTypeMask mask = entity->getComponentMask();
+  const EntityFlags flags = entity->getFlags();
+
+  return (mask & required) == required && (mask & excluded) == 0
+    && (flags & requiredFlags) == requiredFlags && (flags & excludedFlags) == 0;
+}
+
+bool Entities::QueryView::contains(const Entities::Entity* entity) const
+{
+  const std::uint32_t slot = entity->getHandle().index;
+  return slot < positions.size() && positions[slot] != EntityHandle::InvalidIndex;
+}
+
+void Entities::QueryView::insert(Entities::Entity* entity)
+{
+  const std::uint32_t slot = entity->getHandle().index;
+
+  if (slot >= positions.size())
+  {
+    positions.resize(slot + 1, EntityHandle::InvalidIndex);
+  }
+
+  if (positions[slot] != EntityHandle::InvalidIndex)
+    return;
+
+  positions[slot] = (std::uint32_t)entities.size();
+  entities.push_back(entity);
+}
+
+void Entities::QueryView::erase(Entities::Entity* entity)
+{
+  if (!contains(entity))
+    return;
+
+  const std::uint32_t slot = entity->getHandle().index;
+  const std::uint32_t position = positions[slot];
+
+  // order doesn't matter, so fill the gap with the last entity
+  Entities::Entity* last = entities.back();
+  entities[position] = last;
+  positions[last->getHandle().index] = position;
+
+  entities.pop_back();
+  positions[slot] = EntityHandle::InvalidIndex;
+}
+
+void Entities::QueryView::clear()
+{
+  entities.clear();
+  positions.clear();
+}
+
+Entities::QueryIndex::QueryIndex()
+  :
+  all(Query())
+{
+}
+
+const Entities::QueryView& Entities::QueryIndex::view(const Query& query)
+{
+  for (const auto& existing : views)
+  {
+    if (existing->getQuery() == query)
+      return *existing;
+  }
+
+  views.push_back(std::make_unique<QueryView>(query));
+  QueryView& created = *views.back();
+
+  for (Entities::Entity* entity : all)
+  {
+    if (query.matches(entity))
+    {
+      created.insert(entity);
+    }
+  }
+
+  return created;
+}
+
+void Entities::QueryIndex::add(Entities::Entity* entity)
+{
+  // moving between lists of the same scene keeps our entry
+  if (entity->getQueryIndex() == this)
+    return;
+
+  if (entity->getQueryIndex())
+  {
+    entity->getQueryIndex()->remove(entity);
+  }
+
+  entity->setQueryIndex(this);
+  all.insert(entity);
+  markDirty(entity);
+}
+
+void Entities::QueryIndex::remove(Entities::Entity* entity)
+{
+  all.erase(entity);
+
+  for (const auto& view : views)
+  {
+    view->erase(entity);
+  }
+
+  if (entity->queryPending)
+  {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+
+    auto it = std::find(pending.begin(), pending.end(), entity);
+    if (it != pending.end())
+    {
+      *it = pending.back();
+      pending.pop_back();
+    }
+    entity->queryPending = false;
+  }
+
+  if (entity->getQueryIndex() == this)
+  {
+    entity->setQueryIndex(nullptr);
+  }
+}
+
+void Entities::QueryIndex::markDirty(Entities::Entity* entity)
+{
+  std::lock_guard<std::mutex> lock(pendingMutex);
+
+  if (entity->queryPending)
+    return;
+
+  entity->queryPending = true;
+  pending.push_back(entity);
+}
+
+void Entities::QueryIndex::flush()
+{
+  for (Entities::Entity* entity : pending)
+  {
+    entity->queryPending = false;
+
+    for (const auto& view : views)
+    {
+      if (view->getQuery().matches(entity))
+        view->insert(entity);
+      else
+        view->erase(entity);
+    }
+  }
+  pending.clear();
+}
+
+void Entities::QueryIndex::clear()
+{
+  for (Entities::Entity* entity : all)
+  {
+    entity->queryPending = false;
+    entity->setQueryIndex(nullptr);
+  }
+
+  all.clear();
+  pending.clear();
+
+  for (const auto& view : views)
+  {
+    view->clear();
+  }
+}
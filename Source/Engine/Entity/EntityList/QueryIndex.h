@@ -0,0 +1,123 @@
+/*
+/
+// filename: QueryIndex.h
+// author: Callen Betts
+// brief: defines cached views of the entities in a scene that match a component and flag signature
+//
+// description: A query names the components an entity must and must not have, and the entity flags that must be
+//  set or clear, e.g. "has a Collider and isn't StaticCollider". The index keeps one dense array per query for
+//  every entity in the scene, so passes like collision iterate a ready-made array instead of asking every entity
+//  for its components each frame.
+//
+//  Views are kept up to date incrementally. Adding or removing a component, changing a flag, being added to the
+//  scene or being destroyed only marks the entity as pending; flush() re-checks the pending entities against
+//  every view. Views only change in flush() and when an entity is deleted, so they are safe to iterate while
+//  entities update.
+/
+*/
+
+#pragma once
+#include "Engine/Entity/Entity.h"
+#include <memory>
+#include <mutex>
+
+namespace Entities
+{
+
+  // which entities belong in a view: all of the required components and flags, none of the excluded ones
+  struct Query
+  {
+    ComponentTypeMask required = 0;
+    ComponentTypeMask excluded = 0;
+    EntityFlags requiredFlags = 0;
+    EntityFlags excludedFlags = 0;
+
+    template <typename... T>
+    Query& with() { required |= ((ComponentTypeMask(1) << Components::Component::SlotOf(T::StaticType)) | ...); return *this; }
+
+    template <typename... T>
+    Query& without() { excluded |= ((ComponentTypeMask(1) << Components::Component::SlotOf(T::StaticType)) | ...); return *this; }
+
+    Query& withFlags(EntityFlags flags) { requiredFlags |= flags; return *this; }
+    Query& withoutFlags(EntityFlags flags) { excludedFlags |= flags; return *this; }
+
+    // destroyed entities never match
+    bool matches(Entities::Entity* entity) const;
+
+    bool operator==(const Query& other) const
+    {
+      return required == other.required && excluded == other.excluded
+        && requiredFlags == other.requiredFlags && excludedFlags == other.excludedFlags;
+    }
+  };
+
+  // a dense array of the entities matching one query, in no particular order
+  class QueryView
+  {
+
+  public:
+
+    QueryView(const Query& query) : query(query) {}
+
+    const Query& getQuery() const { return query; }
+    const std::vector<Entities::Entity*>& getEntities() const { return entities; }
+
+    int size() const { return (int)entities.size(); }
+    bool empty() const { return entities.empty(); }
+    std::vector<Entities::Entity*>::const_iterator begin() const { return entities.begin(); }
+    std::vector<Entities::Entity*>::const_iterator end() const { return entities.end(); }
+
+    bool contains(const Entities::Entity* entity) const;
+
+  private:
+
+    friend class QueryIndex;
+
+    // add or remove an entity, removing swaps the last entity into the gap
+    void insert(Entities::Entity* entity);
+    void erase(Entities::Entity* entity);
+    void clear();
+
+    Query query;
+    std::vector<Entities::Entity*> entities;
+    std::vector<std::uint32_t> positions; // registry slot of an entity to its index in entities
+
+  };
+
+  class QueryIndex
+  {
+
+  public:
+
+    QueryIndex();
+
+    // get the view of a query, it is made and filled the first time it is asked for and lives as long as the index
+    const QueryView& view(const Query& query);
+
+    // start tracking an entity, it shows up in views after the next flush
+    void add(Entities::Entity* entity);
+    // stop tracking an entity and take it out of every view right away; called when an entity is deleted
+    void remove(Entities::Entity* entity);
+    // re-check an entity against every view on the next flush; safe to call from the job system
+    void markDirty(Entities::Entity* entity);
+
+    // move pending entities into or out of the views they now match
+    void flush();
+    // forget every entity, views stay registered but empty
+    void clear();
+
+    int getCount() const { return all.size(); }
+    int getViewCount() const { return (int)views.size(); }
+    int getPendingCount() const { return (int)pending.size(); }
+
+  private:
+
+    QueryView all; // every tracked entity, used to fill new views
+    std::vector<std::unique_ptr<QueryView>> views; // pointers so views returned to callers never move
+
+    std::vector<Entities::Entity*> pending;
+    std::mutex pendingMutex; // colliders set flags from the job system
+
+  };
+
+}
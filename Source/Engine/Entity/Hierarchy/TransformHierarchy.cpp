@@ -0,0 +1,192 @@
+/*
+/
+// filename: TransformHierarchy.cpp
+// author: Callen Betts
+// brief: implements TransformHierarchy.h
+/
+*/
+
+#include "stdafx.h"
+#include "TransformHierarchy.h"
+#include "Engine/Entity/Entity.h"
+#include <unordered_set>
+
+bool Entities::TransformHierarchy::setParent(Entities::Entity* child, Entities::Entity* parent)
+{
+  if (!child || child == parent)
+    return false;
+
+  // walking up from the new parent must never reach the child
+  for (Entities::Entity* ancestor = parent; ancestor; ancestor = ancestor->getParent())
+  {
+    if (ancestor == child)
+    {
+      Logger::error("Can't parent " + child->getName() + " to its own descendant " + parent->getName());
+      return false;
+    }
+  }
+
+  unlink(child);
+
+  if (parent)
+  {
+    child->parent = parent->getHandle();
+    parent->children.push_back(child->getHandle());
+    linked.push_back(child->getHandle());
+
+    if (child->transform)
+    {
+      child->transform->parented = true;
+    }
+  }
+
+  // rebuild our local matrix so the world matrix is recomputed with the new parent
+  if (child->transform)
+  {
+    child->transform->setDirty(true);
+  }
+
+  structureDirty = true;
+  return true;
+}
+
+void Entities::TransformHierarchy::unlink(Entities::Entity* child)
+{
+  if (Entities::Entity* oldParent = child->getParent())
+  {
+    std::vector<Entities::EntityHandle>& siblings = oldParent->children;
+    siblings.erase(std::remove(siblings.begin(), siblings.end(), child->getHandle()), siblings.end());
+  }
+
+  child->parent = Entities::EntityHandle();
+
+  if (child->transform)
+  {
+    child->transform->parented = false;
+    child->transform->setDirty(true);
+  }
+}
+
+void Entities::TransformHierarchy::update()
+{
+  if (structureDirty)
+  {
+    rebuild();
+  }
+
+  updatedCount = 0;
+
+  // parents come before their children, so one pass sees every parent's final world matrix
+  for (Node& node : nodes)
+  {
+    Entities::Entity* entity = node.entity.get();
+    node.transform = (entity && !entity->isDestroyed()) ? entity->transform : nullptr;
+
+    // an entity left the hierarchy, drop it next frame
+    if (!node.transform)
+    {
+      node.changed = false;
+      structureDirty = true;
+      continue;
+    }
+
+    node.changed = node.transform->consumeMoved();
+
+    if (node.parent < 0)
+      continue;
+
+    const Node& parent = nodes[node.parent];
+    if (!parent.transform)
+      continue;
+
+    node.changed = node.changed || parent.changed;
+
+    if (node.changed)
+    {
+      node.transform->setWorldMatrix(node.transform->localMatrix * parent.transform->transformMatrix);
+      updatedCount++;
+    }
+  }
+}
+
+void Entities::TransformHierarchy::rebuild()
+{
+  structureDirty = false;
+  nodes.clear();
+
+  // drop stale and duplicate links, and detach children whose parent is gone
+  std::unordered_set<std::uint64_t> seen;
+  size_t kept = 0;
+
+  for (Entities::EntityHandle handle : linked)
+  {
+    Entities::Entity* child = handle.get();
+    if (!child || child->isDestroyed() || !seen.insert(handle.value()).second)
+      continue;
+
+    // a child outlives its parent where it was last drawn, so its world matrix becomes its own
+    Entities::Entity* parent = child->getParent();
+    if (!parent || parent->isDestroyed())
+    {
+      if (child->transform)
+      {
+        child->transform->bakeWorldMatrix();
+      }
+
+      unlink(child);
+      continue;
+    }
+
+    linked[kept++] = handle;
+  }
+  linked.resize(kept);
+
+  // the top of every chain is a root
+  std::unordered_set<std::uint64_t> rootSet;
+
+  for (Entities::EntityHandle handle : linked)
+  {
+    Entities::Entity* top = handle.get();
+    while (top->getParent())
+    {
+      top = top->getParent();
+    }
+
+    if (rootSet.insert(top->getHandle().value()).second)
+    {
+      Node root;
+      root.entity = top->getHandle();
+      nodes.push_back(root);
+    }
+  }
+
+  // breadth first from the roots, which keeps the array sorted by depth
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    Entities::Entity* entity = nodes[i].entity.get();
+    std::vector<Entities::EntityHandle>& children = entity->children;
+
+    // forget children that were destroyed since
+    children.erase(std::remove_if(children.begin(), children.end(), [entity](Entities::EntityHandle handle) {
+      Entities::Entity* child = handle.get();
+      return !child || child->isDestroyed() || child->getParent() != entity;
+    }), children.end());
+
+    for (Entities::EntityHandle child : children)
+    {
+      Node node;
+      node.entity = child;
+      node.parent = (int)i;
+      node.depth = nodes[i].depth + 1;
+      nodes.push_back(node);
+    }
+  }
+}
+
+void Entities::TransformHierarchy::clear()
+{
+  nodes.clear();
+  linked.clear();
+  structureDirty = false;
+  updatedCount = 0;
+}
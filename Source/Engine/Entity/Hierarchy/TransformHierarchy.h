@@ -0,0 +1,73 @@
+/*
+/
+// filename: TransformHierarchy.h
+// author: Callen Betts
+// brief: defines the parent/child relationships between entity transforms
+//
+// description: An entity can be parented to another entity, its transform is then relative to its parent.
+//  Every entity that is part of a hierarchy is kept in one flat array sorted by depth, so a parent always comes
+//  before its children. Each frame, after the transform pass has rebuilt the local matrices that changed, a single
+//  walk over the array multiplies local matrices by their parent's world matrix, but only for transforms that moved
+//  or whose parent's world matrix changed this frame. Untouched subtrees cost one flag check per node.
+//
+//  The array is rebuilt only when the structure changes. EntityList sublists are still just folders; they have
+//  no effect on transforms.
+/
+*/
+
+#pragma once
+#include "Engine/Entity/EntityHandle.h"
+
+namespace Components
+{
+  class Transform;
+}
+
+namespace Entities
+{
+  class Entity;
+
+  class TransformHierarchy
+  {
+
+  public:
+
+    // an entity in the depth sorted array
+    struct Node
+    {
+      Entities::EntityHandle entity;
+      int parent = -1; // index of our parent node, -1 for roots
+      int depth = 0;
+      Components::Transform* transform = nullptr; // resolved each update, the transform can be removed and replaced
+      bool changed = false; // our world matrix changed this frame
+    };
+
+    // parent an entity to another; the child keeps its local values, so it now moves relative to the parent
+    // passing nullptr detaches the child. Returns false if the parent is the child or one of its descendants
+    bool setParent(Entities::Entity* child, Entities::Entity* parent);
+    void detach(Entities::Entity* child) { setParent(child, nullptr); }
+
+    // propagate world matrices down every subtree that changed this frame
+    void update();
+    void clear();
+
+    const std::vector<Node>& getNodes() const { return nodes; }
+    // how many world matrices were recomputed last update
+    int getUpdatedCount() const { return updatedCount; }
+
+  private:
+
+    // rebuild the depth sorted array from the parent links on the entities
+    void rebuild();
+    // clear an entity's parent link without marking the structure dirty
+    void unlink(Entities::Entity* child);
+
+    std::vector<Node> nodes;
+    std::vector<Entities::EntityHandle> linked; // every entity that was given a parent, may hold stale entries
+
+    bool structureDirty = false;
+    int updatedCount = 0;
+
+  };
+
+}
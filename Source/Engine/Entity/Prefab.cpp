@@ -0,0 +1,79 @@
+/*
+/
+// filename: Prefab.cpp
+// author: Callen Betts
+// brief: implements Prefab.h
+/
+*/
+
+#include "stdafx.h"
+#include "Prefab.h"
+#include "Entity.h"
+
+Entities::Prefab::Prefab(const std::string& name, Entities::Entity* archetype)
+  :
+  name(name),
+  archetype(archetype)
+{
+  // saved once here so instances can compare against it without saving the archetype every time
+  for (Components::Component* component : archetype->getComponents())
+  {
+    componentData[component->getName()] = component->Save();
+  }
+}
+
+Entities::Prefab::~Prefab()
+{
+  delete archetype;
+}
+
+Entities::Entity* Entities::Prefab::instantiate() const
+{
+  return new Entities::Entity(*archetype, this);
+}
+
+void Entities::Prefab::stripDefaults(const std::string& componentName, nlohmann::json& data) const
+{
+  auto it = componentData.find(componentName);
+  if (it == componentData.end())
+    return;
+
+  for (auto value = data.begin(); value != data.end();)
+  {
+    auto prefabValue = it->find(value.key());
+
+    if (prefabValue != it->end() && *prefabValue == value.value())
+    {
+      value = data.erase(value);
+    }
+    else
+    {
+      ++value;
+    }
+  }
+}
+
+nlohmann::json Entities::Prefab::getRemovedComponents(const Entities::Entity* instance) const
+{
+  nlohmann::json removed = nlohmann::json::array();
+
+  for (const auto& [componentName, data] : componentData.items())
+  {
+    bool found = false;
+    for (Components::Component* component : instance->getComponents())
+    {
+      if (component->getName() == componentName)
+      {
+        found = true;
+        break;
+      }
+    }
+
+    if (!found)
+    {
+      removed.push_back(componentName);
+    }
+  }
+
+  return removed;
+}
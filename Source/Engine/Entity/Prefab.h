@@ -0,0 +1,53 @@
+/*
+/
+// filename: Prefab.h
+// author: Callen Betts
+// brief: defines the shared, read only data an entity archetype's instances are made from
+//
+// description: A prefab owns the archetype entity loaded from Data/Entities and the saved data of each of its
+//  components. Instances don't copy what they can share: components marked shareable (sprites) are the
+//  archetype's own until an instance asks for one it can write to through get<T>(), the inspector or a load, and
+//  only then is it cloned. Everything with state of its own per instance (transforms, bodies, colliders,
+//  behaviors) is cloned when the instance is made. Instances must be deleted before their prefab. When an
+//  instance is saved, every value that still matches the prefab is left out, so a scene stores each instance's
+//  overrides and the name of its prefab.
+/
+*/
+
+#pragma once
+
+namespace Entities
+{
+  class Entity;
+
+  class Prefab
+  {
+
+  public:
+
+    // takes ownership of the archetype
+    Prefab(const std::string& name, Entities::Entity* archetype);
+    ~Prefab();
+
+    const std::string& getName() const { return name; }
+    Entities::Entity* getArchetype() const { return archetype; }
+
+    // make a new instance of the prefab; it shares our shareable components and copies the rest
+    Entities::Entity* instantiate() const;
+
+    // if the archetype has a component with this name
+    bool hasComponent(const std::string& componentName) const { return componentData.contains(componentName); }
+    // remove every value from a component's saved data that is the same as on the prefab
+    void stripDefaults(const std::string& componentName, nlohmann::json& data) const;
+    // names of prefab components an instance no longer has
+    nlohmann::json getRemovedComponents(const Entities::Entity* instance) const;
+
+  private:
+
+    std::string name;
+    Entities::Entity* archetype;
+    nlohmann::json componentData; // component name to the archetype's saved data
+
+  };
+
+}
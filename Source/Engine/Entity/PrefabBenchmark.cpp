@@ -0,0 +1,131 @@
+/*
+/
+// filename: PrefabBenchmark.cpp
+// author: Callen Betts
+// brief: measures spawning and saving prefab instances against standalone entities
+//
+// description: Spawns N instances of a physics prop prefab and N standalone entities with the same components,
+//  each group from an allocator of its own so the pooled memory it takes can be compared. Instances share the
+//  prefab's sprite instead of copying it. Each one is then moved and saved: standalone entities save every value
+//  of every component, prefab instances only what differs from the prefab, which here is their position. Last,
+//  every instance writes to its sprite, which is when it gets a copy of its own.
+/
+*/
+
+#include "stdafx.h"
+#include "Prefab.h"
+#include "Entity.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+#include "Engine/Systems/Memory/PoolAllocator.h"
+
+namespace
+{
+  Entities::Entity* MakeProp()
+  {
+    Entities::Entity* entity = new Entities::Entity("Prop");
+    entity->addComponent(new Components::Transform({ 0.f, 0.f, 0.f }, { 2.f, 2.f, 2.f }, { 0.f, 45.f, 0.f }));
+    entity->addComponent(new Components::Physics());
+    entity->addComponent(new Components::BoxCollider());
+    // no model library outside the engine, so the sprite only holds its model's name
+    entity->addComponent(new Components::Sprite3D("Crate"));
+    return entity;
+  }
+
+  // save every entity and return the size of the json text
+  size_t SaveAll(const std::vector<Entities::Entity*>& entities, double& time)
+  {
+    Benchmark::Stopwatch timer;
+    nlohmann::json data;
+    for (Entities::Entity* entity : entities)
+    {
+      data.push_back(entity->Save());
+    }
+    time = timer.elapsed();
+    return data.dump().size();
+  }
+
+  void Destroy(std::vector<Entities::Entity*>& entities)
+  {
+    for (Entities::Entity* entity : entities)
+    {
+      delete entity;
+    }
+    entities.clear();
+  }
+
+  void PrefabBenchmark(int count)
+  {
+    // declared first so they outlive every entity made from them
+    Memory::PoolAllocator standaloneArena;
+    Memory::PoolAllocator instanceArena;
+
+    Entities::Prefab prefab("Prop", MakeProp());
+
+    std::vector<Entities::Entity*> standalone;
+    std::vector<Entities::Entity*> instances;
+    standalone.reserve(count);
+    instances.reserve(count);
+
+    Benchmark::Stopwatch timer;
+    {
+      Memory::PoolAllocator::Scope scope(standaloneArena);
+      for (int i = 0; i < count; ++i)
+      {
+        standalone.push_back(MakeProp());
+      }
+    }
+    double standaloneSpawn = timer.elapsed();
+
+    timer.start();
+    {
+      Memory::PoolAllocator::Scope scope(instanceArena);
+      for (int i = 0; i < count; ++i)
+      {
+        instances.push_back(prefab.instantiate());
+      }
+    }
+    double instanceSpawn = timer.elapsed();
+
+    const std::size_t standaloneBytes = standaloneArena.getStats().liveBytes;
+    const std::size_t instanceBytes = instanceArena.getStats().liveBytes;
+
+    for (int i = 0; i < count; ++i)
+    {
+      standalone[i]->transform->setPosition({ (float)i, 0.f, 0.f });
+      instances[i]->transform->setPosition({ (float)i, 0.f, 0.f });
+    }
+
+    double standaloneSave = 0;
+    double instanceSave = 0;
+    size_t standaloneSaved = SaveAll(standalone, standaloneSave);
+    size_t instanceSaved = SaveAll(instances, instanceSave);
+
+    // the first write to a shared sprite is what pays for the copy
+    timer.start();
+    {
+      Memory::PoolAllocator::Scope scope(instanceArena);
+      for (Entities::Entity* instance : instances)
+      {
+        instance->get<Components::Sprite3D>()->setAlpha(0.5f);
+      }
+    }
+    double instanceWrite = timer.elapsed();
+
+    Benchmark::Report("Prefab", "standalone spawn", standaloneSpawn, "ms");
+    Benchmark::Report("Prefab", "instance spawn", instanceSpawn, "ms");
+    Benchmark::Report("Prefab", "standalone memory", standaloneBytes / 1024.0, "KB");
+    Benchmark::Report("Prefab", "instance memory", instanceBytes / 1024.0, "KB");
+    Benchmark::Report("Prefab", "instance memory after writing", instanceArena.getStats().liveBytes / 1024.0, "KB");
+    Benchmark::Report("Prefab", "instance first write", instanceWrite, "ms");
+    Benchmark::Report("Prefab", "standalone save", standaloneSave, "ms");
+    Benchmark::Report("Prefab", "instance save", instanceSave, "ms");
+    Benchmark::Report("Prefab", "standalone saved size", standaloneSaved / 1024.0, "KB");
+    Benchmark::Report("Prefab", "instance saved size", instanceSaved / 1024.0, "KB");
+    Benchmark::Report("Prefab", "saved size ratio", standaloneSaved > 0 ? (double)instanceSaved / standaloneSaved : 0, "");
+
+    Destroy(standalone);
+    Destroy(instances);
+  }
+}
+
+REGISTER_BENCHMARK(Prefab, PrefabBenchmark);
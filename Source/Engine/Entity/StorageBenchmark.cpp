@@ -0,0 +1,170 @@
+/*
+/
+// filename: StorageBenchmark.cpp
+// author: Callen Betts
+// brief: compares per-entity heap components against pooled components found through their slots
+//
+// description: Both layouts run the exact same integration kernel over a Transform and a Physics component.
+//  The legacy layout allocates every component on the heap and finds them through a linear search of the
+//  entity's component list, which is what the engine did before components were pooled. The pooled layout is
+//  what entities do now: each component class comes from a pool of its own and get<T>() is one slot read.
+//  Cache misses can only be measured with an external profiler, so as a proxy we also report the average
+//  distance in bytes between consecutive Transforms visited by each loop.
+/
+*/
+
+#include "stdafx.h"
+#include "Entity.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+
+namespace
+{
+  // the way entities used to store components
+  struct LegacyEntity
+  {
+    std::vector<Components::Component*> components;
+
+    Components::Component* getComponent(Components::Component::ComponentType type)
+    {
+      for (Components::Component* component : components)
+      {
+        if (component->getType() == type)
+          return component;
+      }
+      return nullptr;
+    }
+  };
+
+  constexpr int Frames = 100;
+  constexpr float TimeStep = 1.f / 60.f;
+
+  // shared kernel so both layouts do identical work
+  inline void Integrate(Components::Transform* transform, Components::Physics* physics)
+  {
+    Vector3D velocity = physics->getVelocity();
+    Vector3D position = transform->getPosition();
+    transform->setPosition(position + velocity * TimeStep);
+  }
+
+  // average absolute distance between neighbouring addresses
+  double AverageStride(const std::vector<const void*>& addresses)
+  {
+    if (addresses.size() < 2)
+      return 0;
+
+    double total = 0;
+    for (size_t i = 1; i < addresses.size(); ++i)
+    {
+      std::intptr_t a = reinterpret_cast<std::intptr_t>(addresses[i - 1]);
+      std::intptr_t b = reinterpret_cast<std::intptr_t>(addresses[i]);
+      total += static_cast<double>(a > b ? a - b : b - a);
+    }
+    return total / (addresses.size() - 1);
+  }
+
+  double RunLegacy(int count, double& stride)
+  {
+    std::vector<LegacyEntity*> entities;
+    entities.reserve(count);
+
+    for (int i = 0; i < count; ++i)
+    {
+      LegacyEntity* entity = new LegacyEntity();
+      // straight from the heap, the way components were made before the pools
+      entity->components.push_back(::new Components::Transform());
+      Components::Physics* physics = ::new Components::Physics();
+      physics->setVelocity({ 1.f, 0.f, (float)(i % 7) });
+      entity->components.push_back(physics);
+      entities.push_back(entity);
+    }
+
+    std::vector<const void*> addresses;
+    addresses.reserve(count);
+    for (LegacyEntity* entity : entities)
+    {
+      addresses.push_back(entity->getComponent(Components::Component::Transform));
+    }
+    stride = AverageStride(addresses);
+
+    Benchmark::Stopwatch timer;
+    for (int frame = 0; frame < Frames; ++frame)
+    {
+      for (LegacyEntity* entity : entities)
+      {
+        auto* transform = static_cast<Components::Transform*>(entity->getComponent(Components::Component::Transform));
+        auto* physics = static_cast<Components::Physics*>(entity->getComponent(Components::Component::Physics));
+        Integrate(transform, physics);
+      }
+    }
+    double time = timer.elapsed() / Frames;
+
+    for (LegacyEntity* entity : entities)
+    {
+      for (Components::Component* component : entity->components)
+      {
+        component->~Component();
+        ::operator delete(component);
+      }
+      delete entity;
+    }
+
+    return time;
+  }
+
+  double RunPooled(int count, double& stride)
+  {
+    std::vector<Entities::Entity*> entities;
+    entities.reserve(count);
+
+    for (int i = 0; i < count; ++i)
+    {
+      Entities::Entity* entity = new Entities::Entity();
+      entity->addComponent(new Components::Transform());
+      entity->addComponent(new Components::Physics());
+      entity->physics->setVelocity({ 1.f, 0.f, (float)(i % 7) });
+      entities.push_back(entity);
+    }
+
+    std::vector<const void*> addresses;
+    addresses.reserve(count);
+    for (Entities::Entity* entity : entities)
+    {
+      addresses.push_back(entity->get<Components::Transform>());
+    }
+    stride = AverageStride(addresses);
+
+    Benchmark::Stopwatch timer;
+    for (int frame = 0; frame < Frames; ++frame)
+    {
+      for (Entities::Entity* entity : entities)
+      {
+        Integrate(entity->get<Components::Transform>(), entity->get<Components::Physics>());
+      }
+    }
+    double time = timer.elapsed() / Frames;
+
+    for (Entities::Entity* entity : entities)
+    {
+      delete entity;
+    }
+
+    return time;
+  }
+
+  void StorageBenchmark(int count)
+  {
+    double legacyStride = 0;
+    double pooledStride = 0;
+
+    double legacy = RunLegacy(count, legacyStride);
+    double pooled = RunPooled(count, pooledStride);
+
+    Benchmark::Report("Storage", "legacy update", legacy, "ms/frame");
+    Benchmark::Report("Storage", "pooled update", pooled, "ms/frame");
+    Benchmark::Report("Storage", "speedup", pooled > 0 ? legacy / pooled : 0, "x");
+    Benchmark::Report("Storage", "legacy transform stride", legacyStride, "bytes");
+    Benchmark::Report("Storage", "pooled transform stride", pooledStride, "bytes");
+  }
+}
+
+REGISTER_BENCHMARK(Storage, StorageBenchmark);
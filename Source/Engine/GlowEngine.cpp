@@ -18,6 +18,12 @@
 #include "Engine/Graphics/Meshes/MeshLibrary.h"
 #include "Engine/Audio/SoundLibrary.h"
 #include "Engine/Audio/SoundSystem.h"
+#include "Engine/Systems/Jobs/JobSystem.h"
+#include "Game/System/SystemScheduler.h"
+#include "Engine/Systems/Update/FrameClock.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+#include "Engine/Platform/Platform.h"
+#include "Engine/Graphics/Camera/Camera.h"
 
 // initialize engine values
 Engine::GlowEngine::GlowEngine()
@@ -40,7 +46,11 @@ Engine::GlowEngine::GlowEngine()
   paused(true),
   playing(false),
   gameWindowIsFocused(false),
-  fps(60)
+  fps(60),
+  threadCount(0),
+  headlessSteps(600),
+  jobSystem(nullptr),
+  scheduler(nullptr)
 {
   EngineInstance::setup(this);
 }
@@ -48,14 +58,17 @@ Engine::GlowEngine::GlowEngine()
 // start the engine - returns false if failed, true on success
 bool Engine::GlowEngine::start()
 {
-  // we need a window immediately
-  window = new Graphics::Window();
+  // we need a window immediately, unless there's nothing to show
+  if (!IsHeadless())
+  {
+    window = new Graphics::Window();
+  }
 
   // create the window
-  Logger::write("Starting engine...");
+  Logger::write(IsHeadless() ? "Starting headless engine..." : "Starting engine...");
 
   // failed
-  if (!window->setup())
+  if (window && !window->setup())
   {
     Logger::error("Invalid window handle");
     return false;
@@ -65,6 +78,9 @@ bool Engine::GlowEngine::start()
   createCoreSystems();
   // create later systems
   createLaterSystems();
+  // every system exists now, work out what can run side by side
+  scheduler = new Systems::SystemScheduler(jobSystem);
+  scheduler->build();
   // setup global data
   SetupGlobalDataStructures();
   // success
@@ -78,11 +94,9 @@ bool Engine::GlowEngine::run()
   // update and display the window
   window->updateWindow();
 
-  // calculate delta time
-  LARGE_INTEGER frequency, prevTime, currTime;
-
-  QueryPerformanceFrequency(&frequency);
-  QueryPerformanceCounter(&prevTime);
+  // systems see the same delta time every step, however long frames take
+  Systems::FrameClock& clock = Systems::FrameClock::instance();
+  clock.reset();
 
   // run the engine
   running = true;
@@ -95,17 +109,26 @@ bool Engine::GlowEngine::run()
       break;
     }
 
-    // calculate the delta time
-    QueryPerformanceCounter(&currTime);
-    deltaTime = static_cast<float>(currTime.QuadPart - prevTime.QuadPart) / frequency.QuadPart;
-    prevTime = currTime;
-    fpsTimer += deltaTime;
+    // how long the last frame took
+    const float frameTime = clock.tick();
+    fpsTimer += frameTime;
     frameCount++;
     totalFrames++;
 
-    // update systems
+    // input, audio and the rest of the per frame systems
     update();
-    // render systems
+
+    // step the scene simulation as many fixed steps as fit in the time that passed, which may be none
+    const int steps = clock.advance(frameTime);
+    deltaTime = clock.getStep();
+    for (int i = 0; i < steps; ++i)
+    {
+      clock.beginStep();
+      step();
+    }
+
+    // render systems, drawing moving transforms between their last two steps while the game runs
+    clock.setInterpolating(!paused);
     render();
     // finish render
     input->Clear();
@@ -117,12 +140,66 @@ bool Engine::GlowEngine::run()
       frameCount = 0;
       fpsTimer -= 1.0f;
     }
+
+    // don't burn a core on frames nobody will see
+    clock.limit();
   } 
 
   // stop running
   return window->getMessageParam();
 }
 
+int Engine::GlowEngine::runHeadless()
+{
+  Scene::Scene* scene = sceneSystem->getCurrentScene();
+
+  if (!headlessMap.empty() && headlessMap != scene->getName())
+  {
+    const std::string mapPath = "Data/Maps/" + headlessMap + "_MapData.json";
+    if (!std::ifstream(mapPath).is_open())
+    {
+      Logger::error("No map at " + mapPath);
+      return -1;
+    }
+
+    scene->setName(headlessMap);
+    scene->LoadScene();
+  }
+
+  // the same as pressing play in the editor
+  SetPaused(false);
+  StartGame();
+
+  // nothing waits on a frame, so steps run back to back
+  Systems::FrameClock& clock = Systems::FrameClock::instance();
+  deltaTime = clock.getStep();
+  running = true;
+
+  Benchmark::Stopwatch timer;
+  int steps = 0;
+  for (; running && steps < headlessSteps; ++steps)
+  {
+    clock.beginStep();
+    update();
+    step();
+    input->Clear();
+    totalFrames++;
+  }
+  const double time = timer.elapsed();
+
+  const std::string label = scene->getName() + ", " + std::to_string(scene->getEntityCount()) + " entities, " + std::to_string(steps) + " steps";
+  Benchmark::Report("Headless", label, steps ? time / steps : 0, "ms/step");
+  Benchmark::Report("Headless", label + " simulated", time > 0 ? steps * deltaTime * 1000.0 / time : 0, "x real time");
+
+  // the map on disk is left as it was
+  cleanUp();
+  delete scheduler;
+  scheduler = nullptr;
+  delete jobSystem;
+  jobSystem = nullptr;
+  return 0;
+}
+
 // stop all processes in the engine and exit
 void Engine::GlowEngine::stop()
 {
@@ -130,25 +207,16 @@ void Engine::GlowEngine::stop()
   running = false;
 }
 
-// loop through and update each system
+// update the per frame systems; the scheduler runs them in dependency order, systems that are simulations still run when paused
 void Engine::GlowEngine::update()
 {
-  // update all systems
-  for (auto system : SystemInstance::getSystems())
-  {
-    // Systems that are simulations will still run when paused
-    if (paused)
-    {
-      if (system->IsSimulation())
-      {
-        system->update();
-      }
-    }
-    else
-    {
-      system->update();
-    }
-  }
+  scheduler->run(paused, false);
+}
+
+// advance the fixed step systems by one step
+void Engine::GlowEngine::step()
+{
+  scheduler->run(paused, true);
 }
 
 // call the renderer updates and render systems
@@ -173,19 +241,27 @@ void Engine::GlowEngine::exit()
   cleanUp();
 
   sceneSystem->getCurrentScene()->SaveScene();
+
+  // saving may use the workers, so they go last
+  delete scheduler;
+  scheduler = nullptr;
+  delete jobSystem;
+  jobSystem = nullptr;
 }
 
 // create systems that need to be initialized first
 void Engine::GlowEngine::createCoreSystems()
 {
-  // window handle
+  // worker threads for anything that can fan out
+  jobSystem = new Jobs::JobSystem(threadCount);
+  // window handle, null when headless
   windowHandle = getWindowHandle();
   // input
   input = new Input::InputSystem("InputSystem");
-  // setup renderer
-  renderer = new Graphics::Renderer(windowHandle);
-  // camera, though it belongs to the renderer we have a quick pointer
-  camera = renderer->getCamera();
+  // setup renderer; headless runs have none, and everything that draws checks for it
+  renderer = IsHeadless() ? nullptr : new Graphics::Renderer(windowHandle);
+  // camera, though it belongs to the renderer we have a quick pointer; without one it is ours
+  camera = renderer ? renderer->getCamera() : new Visual::Camera(nullptr);
   // audio
   soundLibrary = new Audio::SoundLibrary();
   soundSystem = new Audio::SoundSystem();
@@ -208,10 +284,13 @@ void Engine::GlowEngine::createLaterSystems()
     modelLibrary->load();
     // entity factory
     factory = new Entities::EntityFactory();
+    // archetypes were the last thing that could load a model; from here on worlds may share the library
+    modelLibrary->lock();
     // scene system
     sceneSystem = new Scene::SceneSystem("SceneSystem");
     sceneSystem->init();
     sceneSystem->SetAsSimulation(true);
+    sceneSystem->SetFixedStep(true);
     // initialize later system core pointers
     initializeSystemCorePointers();
     // set the first scene
@@ -265,11 +344,45 @@ void Engine::GlowEngine::StartGame()
 {
   setPlaying(true);
   sceneSystem->getCurrentScene()->SaveSnapshot();
+
+  Memory::PoolAllocator::Scope scope(sceneSystem->getCurrentScene()->getArena());
   sceneSystem->getCurrentScene()->init();
 }
 
 // directly get the window handle
 HWND Engine::GlowEngine::getWindowHandle()
 {
-  return window->getHandle();
+  return window ? window->getHandle() : NULL;
+}
+
+void Engine::GlowEngine::SetHeadlessFromCommandLine(int argc, char** argv)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::string(argv[i]) != "-headless")
+      continue;
+
+    Platform::SetHeadless(true);
+
+    // a number is the step count, anything else is the map
+    for (int j = i + 1; j < argc && argv[j][0] != '-'; ++j)
+    {
+      std::string arg = argv[j];
+
+      if (std::isdigit(static_cast<unsigned char>(arg[0])))
+      {
+        headlessSteps = (std::max)(1, std::atoi(arg.c_str()));
+      }
+      else
+      {
+        headlessMap = arg;
+      }
+    }
+    return;
+  }
+}
+
+bool Engine::GlowEngine::IsHeadless()
+{
+  return Platform::IsHeadless();
 }
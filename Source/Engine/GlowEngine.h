@@ -18,6 +18,8 @@ namespace Scene { class SceneSystem; }
 namespace Meshes { class MeshLibrary; }
 namespace Entities { class EntityFactory; }
 namespace Audio { class SoundSystem; class SoundLibrary; }
+namespace Jobs { class JobSystem; }
+namespace Systems { class SystemScheduler; }
 
 namespace Engine
 {
@@ -32,8 +34,11 @@ namespace Engine
     bool start();
     bool run();
     void stop();
+    // step the current scene as fast as possible without a window, renderer or editor, then report the time
+    int runHeadless();
 
     void update();
+    void step();
     void render();
     void exit();
 
@@ -62,12 +67,21 @@ namespace Engine
     Entities::EntityFactory* getEntityFactory() { return factory; }
     Audio::SoundLibrary* getSoundLibrary() { return soundLibrary; }
     Audio::SoundSystem* getSoundSystem() { return soundSystem; }
+    Jobs::JobSystem* getJobSystem() { return jobSystem; }
+    Systems::SystemScheduler* getScheduler() { return scheduler; }
 
     // get engine properties
     int getFps() { return fps; }
     int getTotalFrames() { return totalFrames; }
     bool isRunning() { return running; }
+    // the fixed step systems update by, see Systems::FrameClock
     float getDeltaTime() { return deltaTime; }
+    // amount of threads the job system starts with, 0 for every hardware thread and 1 for single threaded; set before start
+    void SetThreadCount(int val) { threadCount = val; }
+    // "-headless [map] [steps]" runs Data/Maps/[map]_MapData.json for that many steps with nothing on screen; set before start
+    // still the windows build, only without a window, renderer or editor
+    void SetHeadlessFromCommandLine(int argc, char** argv);
+    bool IsHeadless();
 
     // if we are playing
     bool isPlaying();
@@ -100,6 +114,8 @@ namespace Engine
     Entities::EntityFactory* factory;
     Audio::SoundLibrary* soundLibrary;
     Audio::SoundSystem* soundSystem;
+    Jobs::JobSystem* jobSystem;
+    Systems::SystemScheduler* scheduler;
 
     // core engine properties (fps, delta time)
     bool running;
@@ -119,6 +135,11 @@ namespace Engine
     int totalFrames;
     int frameTime;
     float deltaTime;
+    int threadCount;
+
+    // headless runs
+    std::string headlessMap;
+    int headlessSteps;
 
   };
 }
@@ -27,7 +27,6 @@ Visual::Camera::Camera(Graphics::Renderer* renderEngine)
   viewMatrix = {};
   perspectiveMatrix = {};
   targetPosition = {0,0,1};
-  target = nullptr;
   upDirection = { 0,1,0 };
   right = { 0,0,0 };
   forward = { 0,0,1 };
@@ -38,8 +37,9 @@ Visual::Camera::Camera(Graphics::Renderer* renderEngine)
   windowHandle = engine->getWindowHandle();
   input = engine->getInputSystem();
   window = engine->getWindow();
-  windowHeight = window->getHeight();
-  windowWidth = window->getWidth();
+  // headless there's no window, the camera still works out its matrices for anything that picks or culls with them
+  windowHeight = window ? window->getHeight() : 1080;
+  windowWidth = window ? window->getWidth() : 1920;
   aspectRatio = static_cast<float>(windowWidth / windowHeight);
   locked = true;
   name = "Camera";
@@ -102,7 +102,10 @@ void Visual::Camera::update()
   viewMatrix = DirectX::XMMatrixLookAtLH(position, targetPosition, upDirection);
 
   // Update the renderer's view and perspective matrices
-  renderer->updateObjectBufferCameraMatrices();
+  if (renderer)
+  {
+    renderer->updateObjectBufferCameraMatrices();
+  }
 }
 
 // game controller
@@ -115,10 +118,11 @@ void Visual::Camera::GameCameraController()
   float deltaX = input->getMouseDelta().x;
   float deltaY = input->getMouseDelta().y;
 
-  // update our target position given a target entity
-  if (target)
+  // update our target position given a target entity, the handle goes null if the target was destroyed
+  Entities::Entity* targetEntity = target.get();
+  if (targetEntity && targetEntity->transform)
   {
-    Vector3D targetPos = getComponentOfType(Transform, target)->getPosition();
+    Vector3D targetPos = targetEntity->transform->getPosition();
     position = DirectX::XMVectorSet(targetPos.x, targetPos.y + height, targetPos.z, 1.0f);
   }
 
@@ -139,7 +143,6 @@ void Visual::Camera::SceneCameraController()
   // get the mouse delta so we can look around
   float deltaX = input->getMouseDelta().x;
   float deltaY = input->getMouseDelta().y;
-  POINT mousePos = input->GetMousePosition();
 
   // if we are in editor mode, we can use WASD SHIFT+SPACE to directly set our position
   if (!engine->isPlaying())
@@ -169,25 +172,25 @@ void Visual::Camera::SceneCameraController()
     if (Input::InputSystem::KeyDown('D'))
       finalPosition = DirectX::XMVectorAdd(finalPosition, DirectX::XMVectorScale(right, -camSpd));
 
-    if (Input::InputSystem::KeyDown(VK_SHIFT))
+    if (Input::InputSystem::KeyDown(Input::Key::Shift))
       finalPosition = DirectX::XMVectorAdd(finalPosition, { 0,-camSpd,0 });
 
-    if (Input::InputSystem::KeyDown(VK_SPACE))
+    if (Input::InputSystem::KeyDown(Input::Key::Space))
       finalPosition = DirectX::XMVectorAdd(finalPosition, { 0,camSpd,0 });
 
     // pivot by right clicking; we want to be able to pan around our scene
     if (Editor::GameWindow::MouseIsInsideWindow())
     {
-      if (Input::InputSystem::KeyDown(MK_RBUTTON))
+      if (Input::InputSystem::KeyDown(Input::Key::MouseRight))
       {
         yaw -= deltaX * mouseSensitivity;
         pitch -= deltaY * mouseSensitivity;
       }
-      if (Input::InputSystem::KeyPressed(MK_RBUTTON))
+      if (Input::InputSystem::KeyPressed(Input::Key::MouseRight))
       {
         input->SetMousePivot(true);
       }
-      if (Input::InputSystem::KeyReleased(MK_RBUTTON))
+      if (Input::InputSystem::KeyReleased(Input::Key::MouseRight))
       {
         input->ClearPivot();
       }
@@ -222,7 +225,7 @@ const Vector3D Visual::Camera::getRightVector()
 
 void Visual::Camera::setTarget(Entities::Entity* newTarget)
 {
-  target = newTarget;
+  target = newTarget ? newTarget->getHandle() : Entities::EntityHandle();
 }
 
 void Visual::Camera::SetPosition(const Vector3D pos)
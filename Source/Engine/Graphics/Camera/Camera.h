@@ -84,7 +84,7 @@ namespace Visual
     Matrix perspectiveMatrix;
 
     // camera follows an entity
-    Entities::Entity* target;
+    Entities::EntityHandle target;
 
   };
 
@@ -24,7 +24,7 @@ Lighting::ShadowSystem::ShadowSystem(ID3D11Device* device_, ID3D11DeviceContext*
     transformBuffer(nullptr),
     vertexBuffer(nullptr)
 {
-
+	writesResource(Systems::Resource::Renderer);
 }
 
 
@@ -35,7 +35,9 @@ void Materials::MaterialLibrary::add(Materials::Material* material)
 // get a mesh given a name
 Materials::Material* Materials::MaterialLibrary::get(std::string name)
 {
-  return materials[name];
+  // find rather than [], a lookup must never add to the library
+  auto it = materials.find(name);
+  return it != materials.end() ? it->second : nullptr;
 }
 
 // load all of our preset materials 
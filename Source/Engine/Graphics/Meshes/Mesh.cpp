@@ -49,7 +49,7 @@ void Meshes::Mesh::setIndices(std::vector<unsigned short> indexList)
 
 // render the mesh
 // materials are applied to index subsections
-void Meshes::Mesh::render()
+void Meshes::Mesh::render(const std::vector<std::string>* materials)
 {
     // update the buffers if they are not made yet
     if (!vertexBuffer)
@@ -68,10 +68,13 @@ void Meshes::Mesh::render()
     context->IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R16_UINT, 0);
 
     // apply the material properties over each mesh subsection
-    for (const auto& section : sections)
+    for (size_t i = 0; i < sections.size(); ++i)
     {
+        const MeshSubSection& section = sections[i];
+        const std::string& materialName = (materials && i < materials->size()) ? (*materials)[i] : section.materialName;
+
         // bind the material to the renderer
-        Materials::Material* mat = EngineInstance::getEngine()->getMaterialLibrary()->get(section.materialName);
+        Materials::Material* mat = EngineInstance::getEngine()->getMaterialLibrary()->get(materialName);
         EngineInstance::getEngine()->getRenderer()->BindMaterial(mat);
 
         // draw the mesh
@@ -60,8 +60,8 @@ namespace Meshes
     void addVertex(Vertex vertex);
     void addIndex(unsigned short index);
 
-    // render the mesh
-    void render();
+    // render the mesh; materials optionally replaces the material name of each subsection
+    void render(const std::vector<std::string>* materials = nullptr);
 
     // get the name
     std::string getName() { return name; }
@@ -223,7 +223,7 @@ void Meshes::MeshLibrary::drawBox(const Vector3D& pos, const Vector3D& scale, co
 void Meshes::MeshLibrary::drawBox(Components::BoxCollider* box)
 {
     Vector3D scale = box->getHitboxSize();
-    Vector3D pos = getComponentOfType(Transform, box->parent)->getPosition();
+    Vector3D pos = box->parent->get<Components::Transform>()->getPosition();
 
     // Identity rotation unless you have a real quaternion to pass in
     DirectX::XMFLOAT4 rot = { 0, 0, 0, 1 };
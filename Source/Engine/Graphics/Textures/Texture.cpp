@@ -56,6 +56,10 @@ void Textures::Texture::load(std::string fileName)
 // create the texture data - we call this whenever we 
 void Textures::Texture::createTexture(std::string filePath)
 {
+  // headless there is no device to upload to, so the texture is only a name and we skip decoding it
+  if (!renderer)
+    return;
+
   // could not find texture
   data = stbi_load(filePath.c_str(), &width, &height, &channels, STBI_rgb_alpha);
   if (!data)
@@ -64,7 +64,7 @@ void Textures::TextureLibrary::add(std::string name, Textures::Texture* texture)
 // get a texture from the library
 Textures::Texture* Textures::TextureLibrary::get(std::string name)
 {
-    Textures::Texture* texture = textures[name];
-    // return the final texture
-    return texture;
+    // find rather than [], a lookup must never add to the library
+    auto it = textures.find(name);
+    return it != textures.end() ? it->second : nullptr;
 }
\ No newline at end of file
@@ -12,6 +12,8 @@
 #include "Engine/Graphics/Renderer.h"
 #include "Game/Scene/Scene.h"
 #include "Game/Scene/SceneSystem.h"
+#include "Game/System/SystemScheduler.h"
+#include "Engine/Systems/Update/FrameClock.h"
 
 void Editor::EngineInspector::update()
 {
@@ -21,5 +23,40 @@ void Editor::EngineInspector::update()
   // write the FPS values to the console
   ImGui::Text(("FPS: " + std::to_string(engine->getFps())).c_str());
   ImGui::Text(("Delta Time: " + std::to_string(engine->getDeltaTime())).c_str());
+
+  // fixed steps run this frame and how long the frame limiter waited
+  const Systems::FrameClock& clock = Systems::FrameClock::instance();
+  ImGui::Text(("Steps: " + std::to_string(clock.getSteps()) + " at " + std::to_string((int)clock.getStepRate()) + " Hz, waited " + std::to_string(clock.getIdleTime()) + " ms").c_str());
   ImGui::Text(("Entities: " + std::to_string(engine->getSceneSystem()->getCurrentScene()->getEntityCount())).c_str());
+
+  const World::Islands& islands = engine->getSceneSystem()->getCurrentScene()->getIslands();
+  ImGui::Text(("Sleeping: " + std::to_string(islands.getSleepingCount()) + " of " + std::to_string(islands.getBodyCount()) + " bodies, " + std::to_string(islands.getCount()) + " islands").c_str());
+
+  // time spent in each update pass last frame
+  const Systems::UpdatePipeline& pipeline = engine->getSceneSystem()->getCurrentScene()->getUpdatePipeline();
+  ImGui::Text(("Update: " + std::to_string(pipeline.getTotalTime()) + " ms").c_str());
+  for (const Systems::ComponentPass& pass : pipeline.getPasses())
+  {
+    ImGui::Text(("  " + pass.getName() + ": " + std::to_string(pass.getTime()) + " ms (" + std::to_string(pass.getCount()) + ")").c_str());
+  }
+
+  // the system graph; systems on the same level can run at the same time
+  Systems::SystemScheduler* scheduler = engine->getScheduler();
+  if (scheduler && ImGui::TreeNode("Systems"))
+  {
+    for (const Systems::SystemScheduler::Node& node : scheduler->getNodes())
+    {
+      std::string line = std::to_string(node.level) + " " + node.system->getName() + ": ";
+      line += node.skipped ? std::string("paused") : std::to_string(node.averageTime) + " ms";
+      line += node.system->getAccess().mainThread ? " (main)" : " (worker)";
+      ImGui::Text(line.c_str());
+    }
+
+    if (ImGui::Button("Export Schedule"))
+    {
+      scheduler->exportTimings();
+    }
+
+    ImGui::TreePop();
+  }
 }
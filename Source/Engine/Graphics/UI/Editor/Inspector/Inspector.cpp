@@ -9,10 +9,12 @@
 #include "stdafx.h"
 #include "Inspector.h"
 #include "Engine/Entity/Components/Component.h"
+#include "Engine/GlowEngine.h"
+#include "Game/Scene/SceneSystem.h"
 
 // static varibles initialized here
-Entities::Entity* Editor::Inspector::selectedEntity = nullptr;
-Entities::Entity* Editor::Inspector::previousEntity = nullptr;
+Entities::EntityHandle Editor::Inspector::selectedEntity;
+Entities::EntityHandle Editor::Inspector::previousEntity;
 
 Editor::Inspector::Inspector(std::string title, std::string desc, ImGuiWindowFlags flags): Widget(title, desc, flags)
 {
@@ -26,22 +28,23 @@ void Editor::Inspector::update()
 		inspect(nullptr);
 
 	// if we have a selected entity, we allow changing its properties
-	if (selectedEntity)
+	Entities::Entity* entity = selectedEntity.get();
+	if (entity)
 	{
-		selectedEntity->SetSelected(true);
+		entity->SetSelected(true);
 
 		// move the entity with arrow keys
-		Components::Transform* transform = getComponentOfType(Transform, selectedEntity);
+		Components::Transform* transform = entity->get<Components::Transform>();
 
 		float adjustSpeed = 0.1f;
 
-		if (Input::InputSystem::KeyDown(VK_LEFT))
+		if (Input::InputSystem::KeyDown(Input::Key::Left))
 			transform->setPosition(transform->getPosition() + Vector3D(-adjustSpeed,0,0));
-		if (Input::InputSystem::KeyDown(VK_RIGHT))
+		if (Input::InputSystem::KeyDown(Input::Key::Right))
 			transform->setPosition(transform->getPosition() + Vector3D(adjustSpeed, 0, 0));
-		if (Input::InputSystem::KeyDown(VK_UP))
+		if (Input::InputSystem::KeyDown(Input::Key::Up))
 			transform->setPosition(transform->getPosition() + Vector3D(0, 0, -adjustSpeed));
-		if (Input::InputSystem::KeyDown(VK_DOWN))
+		if (Input::InputSystem::KeyDown(Input::Key::Down))
 			transform->setPosition(transform->getPosition() + Vector3D(0, 0, adjustSpeed));
 		if (Input::InputSystem::KeyDown('Z'))
 			transform->setPosition(transform->getPosition() + Vector3D(0, adjustSpeed, 0));
@@ -53,7 +56,7 @@ void Editor::Inspector::update()
 		ImGui::NewLine();
 
 		// for each variable type, allow modification; we can only edit variable types explicitly defined
-		for (auto& variable : selectedEntity->getVariables())
+		for (auto& variable : entity->getVariables())
 		{
 			variable.display();
 		}
@@ -70,7 +73,7 @@ void Editor::Inspector::update()
 			{
 				// delete the selected component
 				Components::Component* component = (Components::Component*) selectedObject;
-				selectedEntity->DeleteComponent(component);
+				EngineInstance::getEngine()->getSceneSystem()->getCurrentScene()->getCommandBuffer().removeComponent(entity, component->getType());
 				selectedObject = nullptr;
 			}
 
@@ -78,7 +81,7 @@ void Editor::Inspector::update()
 			{
 				// delete the selected component
 				Components::Component* component = (Components::Component*)selectedObject;
-				selectedEntity->DeleteComponent(component);
+				entity->DeleteComponent(component);
 				selectedObject = nullptr;
 			}
 
@@ -87,7 +90,7 @@ void Editor::Inspector::update()
 
 		// iterate over every component's properties; each serializable property will be modifiable
 		// this is done using a vector of properties in each component
-		for (const auto& component : selectedEntity->getComponents())
+		for (const auto& component : entity->getComponents())
 		{
 			std::string componentName = component->getName();
 
@@ -104,10 +107,13 @@ void Editor::Inspector::update()
 			{
 				ImGui::NewLine();
 
+				// editing a component shared with the entity's prefab gives the entity its own copy first
+				Components::Component* edited = entity->own(component);
+
 				// some components have specific custom displays
-				component->display();
+				edited->display();
 
-				for (auto& variable : component->getVariables())
+				for (auto& variable : edited->getVariables())
 				{
 					// label the variable; some variables might have custom displays, we will add this layer
 					variable.display();
@@ -133,11 +139,11 @@ void Editor::Inspector::update()
 				std::string name = type.c_str();
 
 				// check if we have the component
-				if (!selectedEntity->hasComponent(type)) 
+				if (!entity->hasComponent(type)) 
 				{
 					if (ImGui::Selectable(type.c_str())) 
 					{
-						selectedEntity->addComponent(type);
+						entity->addComponent(type);
 					}
 				}
 			}
@@ -150,7 +156,7 @@ void Editor::Inspector::update()
 // called while we are dragging an entity or have one selected
 void Editor::Inspector::DragEntity()
 {
-	//Components::Transform* transform = getComponentOfType(Transform, selectedEntity);
+	//Components::Transform* transform = selectedEntity->get<Components::Transform>();
 	//transform->recalculateMatrix();
 
 	//float pos[3] = {transform->getPosition().x,transform->getPosition().y,transform->getPosition().z};
@@ -164,14 +170,11 @@ void Editor::Inspector::DragEntity()
 void Editor::Inspector::inspect(Entities::Entity* ent)
 {
 	previousEntity = selectedEntity;
-	selectedEntity = ent;
+	selectedEntity = ent ? ent->getHandle() : Entities::EntityHandle();
 
-	if (previousEntity)
-	{
-		previousEntity->SetSelected(false);
-	}
-	if (previousEntity && !ent)
+	Entities::Entity* previous = previousEntity.get();
+	if (previous)
 	{
-		previousEntity->SetSelected(false);
+		previous->SetSelected(false);
 	}
 }
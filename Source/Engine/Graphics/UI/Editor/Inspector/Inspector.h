@@ -8,6 +8,7 @@
 
 #pragma once
 #include "Engine/Graphics/UI/Editor/Widget.h"
+#include "Engine/Entity/EntityHandle.h"
 
 namespace Entities
 {
@@ -29,8 +30,9 @@ namespace Editor
     // the entity we want to inspect
     static void inspect(Entities::Entity* ent);
 
-    static Entities::Entity* selectedEntity;
-    static Entities::Entity* previousEntity;
+    // handles, so deleting the inspected entity can't leave us pointing at freed memory
+    static Entities::EntityHandle selectedEntity;
+    static Entities::EntityHandle previousEntity;
 
   private:
 
@@ -17,9 +17,9 @@ void Editor::Resources::update()
 	Entities::EntityFactory* factory = EngineInstance::getEngine()->getEntityFactory();
 	Textures::TextureLibrary* lib = EngineInstance::getEngine()->getTextureLibrary();
 
-	for (auto& entry : factory->GetArchetypes())
+	for (const auto& entry : factory->GetArchetypes())
 	{
-		Entities::Entity* archetype = entry.second;
+		Entities::Prefab* archetype = entry.second;
 		std::string fileName = entry.first;
 
 		// for each archetype, we want to be able to display their name and drag them into our scene
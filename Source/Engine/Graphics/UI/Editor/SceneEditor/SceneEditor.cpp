@@ -37,24 +37,25 @@ void Editor::SceneEditor::update()
 	DrawSceneHierarchy();
 
 	// copy an entity
-	if (Input::InputSystem::KeyDown(VK_CONTROL))
+	if (Input::InputSystem::KeyDown(Input::Key::Control))
 	{
 		if (Input::InputSystem::KeyPressed('C'))
 		{
-			copyPasteEntity = entityButtonSelected;
+			copyPasteEntity = entityButtonSelected ? entityButtonSelected->getHandle() : Entities::EntityHandle();
 		}
 	}
 	// paste an entity
-	if (Input::InputSystem::KeyDown(VK_CONTROL) && Input::InputSystem::KeyPressed('V'))
+	if (Input::InputSystem::KeyDown(Input::Key::Control) && Input::InputSystem::KeyPressed('V'))
 	{
-		if (copyPasteEntity)
+		Entities::Entity* source = copyPasteEntity.get();
+		if (source)
 		{
-			Entities::EntityList* parentList = FindEntityList(currentScene->getRootList(), copyPasteEntity);
+			Entities::EntityList* parentList = FindEntityList(currentScene->getRootList(), source);
 			if (parentList)
 			{
-				Entities::Entity* copy = new Entities::Entity(*copyPasteEntity);
+				Entities::Entity* copy = new Entities::Entity(*source);
 				copy->setName("Entity");
-				parentList->add(copy);
+				currentScene->getCommandBuffer().spawn(copy, parentList);
 			}
 		}
 	}
@@ -76,19 +77,28 @@ void Editor::SceneEditor::DrawSceneHierarchy()
 
 			// drop an entity into a target container
 		case MoveType::DragEntity:
+		{
 			Entities::EntityList* oldParentList = FindEntityList(currentScene->getRootList(), move.entity);
 			if (oldParentList)
 			{
-				oldParentList->remove(move.entity);
-				move.targetList->insert(move.entity, move.targetIndex);
+				currentScene->getCommandBuffer().move(move.entity, oldParentList, move.targetList, move.targetIndex);
 			}
 
 			break;
 		}
 
-		moves.clear();
+			// parent an entity's transform to the entity it was dropped on
+		case MoveType::ParentEntity:
+			currentScene->getHierarchy().setParent(move.entity, move.targetEntity);
+			break;
+
+		default:
+			break;
+		}
 	}
 
+	moves.clear();
+
 	// Below is the logic for adding entities and new lists to the hierarchy
 	// Right click on our empty space to add a new container outside of an existing container
 	if ((selectedContainer || selectedEntity) && ImGui::BeginPopupContextWindow("NewContainer"))
@@ -100,13 +110,13 @@ void Editor::SceneEditor::DrawSceneHierarchy()
 			if (ImGui::MenuItem("Create Entity"))
 			{
 				Entities::Entity* entity = Entities::EntityFactory::CreateBaseEntity();
-				selectedContainer->add(entity);
+				currentScene->getCommandBuffer().spawn(entity, selectedContainer);
 			}
 
 			// Add a new folder to the root list
 			if (ImGui::MenuItem("Create New Folder"))
 			{
-				selectedContainer->getSubLists().push_back(new Entities::EntityList("Container"+std::to_string(rootList->getSubLists().size())));
+				selectedContainer->addSubList(new Entities::EntityList("Container"+std::to_string(rootList->getSubLists().size())));
 			}
 
 			// delete a list and all of its sublists
@@ -136,11 +146,13 @@ void Editor::SceneEditor::DrawSceneHierarchy()
 			// delete an entity
 			if (ImGui::MenuItem("Delete Entity"))
 			{
-				Entities::EntityList* parentList = FindEntityList(rootList, selectedEntity);
-				if (parentList)
-				{
-					parentList->remove(selectedEntity);
-				}
+				currentScene->getCommandBuffer().destroy(selectedEntity);
+			}
+
+			// move an entity back to the top of the transform hierarchy
+			if (selectedEntity->getParent() && ImGui::MenuItem("Detach From Parent"))
+			{
+				currentScene->getHierarchy().detach(selectedEntity);
 			}
 		}
 
@@ -176,10 +188,10 @@ void Editor::SceneEditor::DrawHierarchy(Entities::EntityList* list, int depth)
 		{
 			DrawHierarchy(sublist, depth++);
 		}
-		// Draw entities in the current list
+		// Draw entities in the current list; parented entities are drawn under their parent instead
 		for (const auto& entity : list->getEntities())
 		{
-			if (entity)
+			if (entity && !entity->getParent())
 			{
 				DrawEntity(entity, list, i++);
 			}
@@ -215,7 +227,7 @@ void Editor::SceneEditor::DrawEntity(Entities::Entity* entity, Entities::EntityL
 		if (!renameMode)
 		{
 			// If F2 is pressed and entity is selected, activate rename mode
-			if (entityButtonSelected && !entityButtonSelected->IsLocked() && Input::InputSystem::KeyPressed(VK_F2))
+			if (entityButtonSelected && !entityButtonSelected->IsLocked() && Input::InputSystem::KeyPressed(Input::Key::F2))
 			{
 				renameMode = true;  // Enable rename mode
 				strncpy_s(nameBuffer, selectedEntityName.c_str(), sizeof(nameBuffer));  // Copy current name to buffer
@@ -241,7 +253,7 @@ void Editor::SceneEditor::DrawEntity(Entities::Entity* entity, Entities::EntityL
 	// double click an entity to travel to it
 	if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(0) && !entity->IsLocked())
 	{
-		camera->SetPosition(getComponentOfType(Transform,entity)->getPosition() + Vector3D(0, 0, 15));
+		camera->SetPosition(entity->get<Components::Transform>()->getPosition() + Vector3D(0, 0, 15));
 		camera->SetRotation(-90, 0);
 	}
 
@@ -260,7 +272,10 @@ void Editor::SceneEditor::DrawEntity(Entities::Entity* entity, Entities::EntityL
 		draggedEntity = entity;
 	}
 
-	DragContainer(list, depth);
+	if (list)
+	{
+		DragContainer(list, depth, entity);
+	}
 
 	// Calculate position for the buttons
 	float cursorPosX = ImGui::GetCursorPosX();
@@ -303,6 +318,22 @@ void Editor::SceneEditor::DrawEntity(Entities::Entity* entity, Entities::EntityL
 		ImGui::PopStyleColor();
 		ImGui::PopStyleVar();
 	}
+
+	// draw our transform children under us, whichever list they are in
+	if (!entity->getChildren().empty())
+	{
+		ImGui::Indent();
+		int childIndex = 0;
+		for (const Entities::EntityHandle& handle : entity->getChildren())
+		{
+			Entities::Entity* child = handle.get();
+			if (child && !child->isDestroyed())
+			{
+				DrawEntity(child, child->getList(), childIndex++);
+			}
+		}
+		ImGui::Unindent();
+	}
 }
 
 // Utility function to find the parent of a given entity list
@@ -325,6 +356,10 @@ Entities::EntityList* Editor::SceneEditor::FindParent(Entities::EntityList * roo
 
 Entities::EntityList* Editor::SceneEditor::FindEntityList(Entities::EntityList* root, Entities::Entity* child)
 {
+	// entities remember the list they are in
+	if (child->getList())
+		return child->getList();
+
 	// check for root first
 	for (auto& entity : root->getEntities())
 	{
@@ -352,7 +387,7 @@ void Editor::SceneEditor::interact()
 }
 
 // code to drag and re-place our entity containers and entities within the scene editor list
-void Editor::SceneEditor::DragContainer(Entities::EntityList* list, int index)
+void Editor::SceneEditor::DragContainer(Entities::EntityList* list, int index, Entities::Entity* target)
 {
 	// drag an entity around
 	if (ImGui::BeginDragDropTarget() && draggedEntity)
@@ -362,7 +397,14 @@ void Editor::SceneEditor::DragContainer(Entities::EntityList* list, int index)
 			IM_ASSERT(payload->DataSize == sizeof(Entities::Entity));
 			Entities::Entity* droppedEntity = (Entities::Entity*)payload->Data;
 
-			moves.push_back({draggedEntity,list,index,MoveType::DragEntity});
+			if (target && ImGui::GetIO().KeyShift)
+			{
+				moves.push_back({draggedEntity,list,index,MoveType::ParentEntity,target});
+			}
+			else
+			{
+				moves.push_back({draggedEntity,list,index,MoveType::DragEntity});
+			}
 			draggedEntity = nullptr;
 		}
 		ImGui::EndDragDropTarget();
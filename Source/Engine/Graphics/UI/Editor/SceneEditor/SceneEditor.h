@@ -8,6 +8,7 @@
 
 #pragma once
 #include "Engine/Graphics/UI/Editor/Widget.h"
+#include "Engine/Entity/EntityHandle.h"
 
 
 namespace Entities
@@ -29,7 +30,8 @@ namespace Editor
   enum class MoveType
   {
     DragEntity,
-    DragContainer
+    DragContainer,
+    ParentEntity // shift drop an entity onto another to parent it
   };
 
   struct EntityMove
@@ -38,6 +40,7 @@ namespace Editor
     Entities::EntityList* targetList;
     int targetIndex;
     MoveType moveType;
+    Entities::Entity* targetEntity = nullptr;
   };
 
   class SceneEditor : public Widget
@@ -61,8 +64,8 @@ namespace Editor
     Entities::EntityList* FindParent(Entities::EntityList* root, Entities::EntityList* child);
     Entities::EntityList* FindEntityList(Entities::EntityList* root, Entities::Entity* child);
 
-    // avoid duplicate logic
-    void DragContainer(Entities::EntityList* list, int index);
+    // avoid duplicate logic; dropping on a target entity with shift held parents to it instead
+    void DragContainer(Entities::EntityList* list, int index, Entities::Entity* target = nullptr);
 
   private:
 
@@ -80,7 +83,7 @@ namespace Editor
 
     // for copy paste
     Entities::Entity* entityButtonSelected = nullptr;
-    Entities::Entity* copyPasteEntity = nullptr;
+    Entities::EntityHandle copyPasteEntity; // stays safe if the copied entity is deleted before pasting
   };
 }
 
@@ -0,0 +1,72 @@
+/*
+/
+// filename: CollisionSettings.cpp
+// author: Callen Betts
+// brief: implements CollisionSettings.h
+/
+*/
+
+#include "stdafx.h"
+#include "CollisionSettings.h"
+#include "Engine/Systems/World/CollisionLayers.h"
+
+void Editor::CollisionSettings::update()
+{
+  if (!ImGui::TreeNode("Collision Layers"))
+    return;
+
+  World::CollisionLayers& layers = World::CollisionLayers::instance();
+
+  // rename layers in place
+  for (int i = 0; i < layers.getCount(); ++i)
+  {
+    char name[32] = {};
+    layers.getName(i).copy(name, sizeof(name) - 1);
+
+    if (ImGui::InputText(("##Layer" + std::to_string(i)).c_str(), name, sizeof(name)))
+    {
+      layers.setName(i, name);
+    }
+  }
+
+  ImGui::InputText("##NewLayer", newLayerName, sizeof(newLayerName));
+  ImGui::SameLine();
+  if (ImGui::Button("Add Layer") && newLayerName[0])
+  {
+    layers.addLayer(newLayerName);
+    newLayerName[0] = '\0';
+  }
+
+  // the matrix is symmetric, so only the half on and below the diagonal is shown
+  if (ImGui::TreeNode("Collision Matrix"))
+  {
+    for (int a = 0; a < layers.getCount(); ++a)
+    {
+      ImGui::Text(layers.getName(a).c_str());
+
+      for (int b = 0; b <= a; ++b)
+      {
+        ImGui::SameLine();
+
+        bool collide = layers.canCollide(a, b);
+        if (ImGui::Checkbox(("##" + std::to_string(a) + "x" + std::to_string(b)).c_str(), &collide))
+        {
+          layers.setCanCollide(a, b, collide);
+        }
+
+        if (ImGui::IsItemHovered())
+        {
+          ImGui::SetTooltip("%s / %s", layers.getName(a).c_str(), layers.getName(b).c_str());
+        }
+      }
+    }
+    ImGui::TreePop();
+  }
+
+  if (ImGui::Button("Save Layers"))
+  {
+    layers.save();
+  }
+
+  ImGui::TreePop();
+}
@@ -0,0 +1,28 @@
+/*
+/
+// filename: CollisionSettings.h
+// author: Callen Betts
+// brief: defines the editor's page for naming collision layers and choosing which of them collide
+/
+*/
+
+#pragma once
+
+namespace Editor
+{
+
+	class CollisionSettings
+	{
+
+	public:
+
+		void update();
+
+	private:
+
+		// name typed in for the next layer
+		char newLayerName[32] = "";
+
+	};
+
+}
@@ -14,4 +14,6 @@
 void Editor::Settings::update()
 {
 	gameSettings.update();
+	collisionSettings.update();
+	timingSettings.update();
 }
@@ -9,6 +9,8 @@
 #pragma once
 #include "Engine/Graphics/UI/Editor/Widget.h"
 #include "GameSettings.h"
+#include "CollisionSettings.h"
+#include "TimingSettings.h"
 
 namespace Editor
 {
@@ -26,6 +28,8 @@ namespace Editor
 	private:
 
 		GameSettings gameSettings;
+		CollisionSettings collisionSettings;
+		TimingSettings timingSettings;
 
 	};
 
@@ -0,0 +1,46 @@
+/*
+/
+// filename: TimingSettings.cpp
+// author: Callen Betts
+// brief: implements TimingSettings.h
+/
+*/
+
+#include "stdafx.h"
+#include "TimingSettings.h"
+#include "Engine/Systems/Update/FrameClock.h"
+
+void Editor::TimingSettings::update()
+{
+  if (!ImGui::TreeNode("Timing"))
+    return;
+
+  Systems::FrameClock& clock = Systems::FrameClock::instance();
+
+  float stepRate = clock.getStepRate();
+  if (ImGui::DragFloat("Step Rate (Hz)", &stepRate, 1.f, 1.f, 1000.f))
+  {
+    clock.setStepRate(stepRate);
+  }
+
+  // steps a slow frame may run to catch up before the game slows down instead
+  int maxSteps = clock.getMaxSteps();
+  if (ImGui::DragInt("Max Steps Per Frame", &maxSteps, 0.1f, 1, 60))
+  {
+    clock.setMaxSteps(maxSteps);
+  }
+
+  // 0 runs as fast as vsync allows
+  int frameLimit = clock.getFrameLimit();
+  if (ImGui::DragInt("Frame Limit", &frameLimit, 1.f, 0, 1000))
+  {
+    clock.setFrameLimit(frameLimit);
+  }
+
+  if (ImGui::Button("Save Timing"))
+  {
+    clock.save();
+  }
+
+  ImGui::TreePop();
+}
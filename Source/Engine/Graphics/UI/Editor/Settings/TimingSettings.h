@@ -0,0 +1,23 @@
+/*
+/
+// filename: TimingSettings.h
+// author: Callen Betts
+// brief: defines the editor's page for the project's fixed step rate and frame limit
+/
+*/
+
+#pragma once
+
+namespace Editor
+{
+
+	class TimingSettings
+	{
+
+	public:
+
+		void update();
+
+	};
+
+}
@@ -112,18 +112,18 @@ LRESULT Graphics::Window::windowProc(HWND hWnd, UINT message, WPARAM wParam, LPA
   {
     // when a key is first triggered, set the keystate to active
   case WM_KEYDOWN:
-    input->onKeyTriggered(static_cast<int>(wParam));
+    input->onKeyTriggered(Platform::TranslateKey(static_cast<int>(wParam)));
     break;
 
     // when a key is released, you should reset the keystate and call "released"
   case WM_KEYUP:
-    input->onKeyRelease(static_cast<int>(wParam));
+    input->onKeyRelease(Platform::TranslateKey(static_cast<int>(wParam)));
     break;
 
     // Mouse wheel scrolled
   case WM_MOUSEWHEEL:
   {
-    input->onMouseScroll(static_cast<int>(wParam));
+    input->onMouseScroll(GET_WHEEL_DELTA_WPARAM(wParam));
     break;
   }
 
@@ -132,15 +132,13 @@ LRESULT Graphics::Window::windowProc(HWND hWnd, UINT message, WPARAM wParam, LPA
   case WM_RBUTTONDOWN:
   case WM_MBUTTONDOWN:
   {
-    WPARAM button = 0;
-    if (message == WM_LBUTTONDOWN)
-      button = MK_LBUTTON;
-    else if (message == WM_RBUTTONDOWN)
-      button = MK_RBUTTON;
+    int button = Input::Key::MouseLeft;
+    if (message == WM_RBUTTONDOWN)
+      button = Input::Key::MouseRight;
     else if (message == WM_MBUTTONDOWN)
-      button = MK_MBUTTON;
+      button = Input::Key::MouseMiddle;
 
-    input->onKeyTriggered(static_cast<int>(button));
+    input->onKeyTriggered(button);
     break;
   }
 
@@ -149,15 +147,13 @@ LRESULT Graphics::Window::windowProc(HWND hWnd, UINT message, WPARAM wParam, LPA
   case WM_RBUTTONUP:
   case WM_MBUTTONUP:
   {
-    WPARAM button = 0;
-    if (message == WM_LBUTTONUP)
-      button = MK_LBUTTON;
-    else if (message == WM_RBUTTONUP)
-      button = MK_RBUTTON;
+    int button = Input::Key::MouseLeft;
+    if (message == WM_RBUTTONUP)
+      button = Input::Key::MouseRight;
     else if (message == WM_MBUTTONUP)
-      button = MK_MBUTTON;
+      button = Input::Key::MouseMiddle;
 
-    input->onKeyRelease(static_cast<int>(button));
+    input->onKeyRelease(button);
     break;
   }
 
@@ -0,0 +1,161 @@
+/*
+/
+// filename: Platform.cpp
+// author: Callen Betts
+// brief: implements Platform.h
+/
+*/
+
+#include "stdafx.h"
+#include "Platform.h"
+#include <timeapi.h>
+#include <thread>
+
+#pragma comment(lib, "winmm.lib")
+
+namespace
+{
+  bool headless = false;
+
+  // a waitable timer for each thread that sleeps, worlds limit their frames from their own threads
+  struct SleepTimer
+  {
+    SleepTimer()
+    {
+      handle = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+
+      // high resolution timers came with windows 10 1803, before that the whole system timer has to tick faster
+      if (!handle)
+      {
+        coarse = true;
+        timeBeginPeriod(1);
+        handle = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+      }
+    }
+
+    ~SleepTimer()
+    {
+      if (handle)
+        CloseHandle(handle);
+      if (coarse)
+        timeEndPeriod(1);
+    }
+
+    HANDLE handle = nullptr;
+    bool coarse = false;
+  };
+}
+
+// the engine's key codes were picked to match the virtual keys windows sends, so most keys translate as they are
+static_assert(Input::Key::MouseLeft == VK_LBUTTON && Input::Key::MouseRight == VK_RBUTTON && Input::Key::MouseMiddle == VK_MBUTTON, "mouse buttons");
+static_assert(Input::Key::Tab == VK_TAB && Input::Key::Return == VK_RETURN && Input::Key::Escape == VK_ESCAPE && Input::Key::Space == VK_SPACE, "keys");
+static_assert(Input::Key::Shift == VK_SHIFT && Input::Key::Control == VK_CONTROL && Input::Key::Alt == VK_MENU, "modifiers");
+static_assert(Input::Key::Left == VK_LEFT && Input::Key::Down == VK_DOWN && Input::Key::F1 == VK_F1 && Input::Key::F12 == VK_F12, "arrows and function keys");
+
+void Platform::SetHeadless(bool val)
+{
+  headless = val;
+}
+
+bool Platform::IsHeadless()
+{
+  return headless;
+}
+
+bool Platform::GetCursorPosition(Point& position)
+{
+  if (headless)
+    return false;
+
+  POINT cursor;
+  if (!GetCursorPos(&cursor))
+    return false;
+
+  position = { cursor.x, cursor.y };
+  return true;
+}
+
+void Platform::SetCursorPosition(const Point& position)
+{
+  if (headless)
+    return;
+
+  SetCursorPos(position.x, position.y);
+}
+
+void Platform::ShowCursor(bool show)
+{
+  if (headless)
+    return;
+
+  // windows keeps a display count rather than a flag
+  if (show)
+    while (::ShowCursor(TRUE) <= 0);
+  else
+    while (::ShowCursor(FALSE) > 0);
+}
+
+Platform::Point Platform::GetWindowCenter(WindowHandle window)
+{
+  if (headless || !window)
+    return {};
+
+  HWND handle = static_cast<HWND>(window);
+  RECT clientRect;
+  GetClientRect(handle, &clientRect);
+  POINT center = { (clientRect.right - clientRect.left) / 2, (clientRect.bottom - clientRect.top) / 2 };
+  ClientToScreen(handle, &center);
+  return { center.x, center.y };
+}
+
+int Platform::TranslateKey(int nativeKey)
+{
+  // letters and digits are already their characters
+  if ((nativeKey >= 'A' && nativeKey <= 'Z') || (nativeKey >= '0' && nativeKey <= '9'))
+    return nativeKey;
+
+  if (nativeKey >= VK_F1 && nativeKey <= VK_F12)
+    return nativeKey;
+
+  switch (nativeKey)
+  {
+  case VK_BACK:
+  case VK_TAB:
+  case VK_RETURN:
+  case VK_SHIFT:
+  case VK_CONTROL:
+  case VK_MENU:
+  case VK_ESCAPE:
+  case VK_SPACE:
+  case VK_LEFT:
+  case VK_UP:
+  case VK_RIGHT:
+  case VK_DOWN:
+  case VK_DELETE:
+    return nativeKey;
+  default:
+    return Input::Key::Unknown;
+  }
+}
+
+void Platform::SleepFor(double seconds)
+{
+  // waitable timers count in 100 ns ticks, negative meaning relative to now
+  const LONGLONG ticks = (LONGLONG)(seconds * 10000000.0);
+  if (ticks <= 0)
+    return;
+
+  thread_local SleepTimer timer;
+
+  LARGE_INTEGER due;
+  due.QuadPart = -ticks;
+
+  if (timer.handle && SetWaitableTimer(timer.handle, &due, 0, nullptr, nullptr, FALSE))
+  {
+    WaitForSingleObject(timer.handle, INFINITE);
+  }
+  else
+  {
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+  }
+}
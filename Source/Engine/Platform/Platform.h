@@ -0,0 +1,54 @@
+/*
+/
+// filename: Platform.h
+// author: Callen Betts
+// brief: defines the calls the engine makes into the operating system outside of rendering
+//
+// description: Input and the engine loop go through here for the cursor, the window and key codes instead of
+//  calling Win32 themselves, and only engine types cross this line. Running headless there is no window or cursor,
+//  so everything here quietly does nothing and input only ever sees what windows messages would have put in it,
+//  which is nothing. Timing is std::chrono throughout (see Systems::FrameClock); the only thing it needs from the
+//  platform is a sleep finer than the 15.6 ms the windows scheduler ticks at by default.
+//
+//  Platform.cpp is the only implementation, for Win32. Headless means no window, renderer or editor, not another
+//  operating system: the vcxproj is the only build and stdafx.h still pulls in windows.h and D3D11 everywhere.
+//  Porting means another implementation of these calls and a build that leaves the D3D11, window and ImGui
+//  sources out.
+/
+*/
+
+#pragma once
+
+namespace Platform
+{
+
+  // a window from the operating system; the engine only ever hands it back
+  using WindowHandle = void*;
+
+  // a position on the screen in pixels
+  struct Point
+  {
+    int x = 0;
+    int y = 0;
+  };
+
+  // headless runs have no window, renderer, editor or cursor; set once before the engine starts
+  void SetHeadless(bool val);
+  bool IsHeadless();
+
+  // the cursor in screen coordinates; returns false when there isn't one
+  bool GetCursorPosition(Point& position);
+  void SetCursorPosition(const Point& position);
+  void ShowCursor(bool show);
+
+  // the middle of a window's client area in screen coordinates
+  Point GetWindowCenter(WindowHandle window);
+
+  // turn the operating system's code for a key into an Input::Key
+  int TranslateKey(int nativeKey);
+
+  // block the calling thread for about this many seconds; overshoots by well under a millisecond on windows 10
+  // and later, by up to one on anything older
+  void SleepFor(double seconds);
+
+}
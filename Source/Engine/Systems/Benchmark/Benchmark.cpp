@@ -0,0 +1,94 @@
+/*
+/
+// filename: Benchmark.cpp
+// author: Callen Betts
+// brief: implements Benchmark.h
+/
+*/
+
+#include "stdafx.h"
+#include "Benchmark.h"
+#include <sstream>
+#include <iomanip>
+
+void Benchmark::BenchmarkRegistry::registerBenchmark(const std::string& name, BenchmarkFunc func)
+{
+  if (benchmarks.find(name) == benchmarks.end())
+  {
+    names.push_back(name);
+  }
+  benchmarks[name] = func;
+}
+
+int Benchmark::BenchmarkRegistry::run(const std::string& filter, int count)
+{
+  int ran = 0;
+
+  for (const std::string& name : names)
+  {
+    if (!filter.empty() && name.find(filter) == std::string::npos)
+      continue;
+
+    Logger::write("Benchmark " + name + " (" + std::to_string(count) + ")");
+
+    Stopwatch timer;
+    benchmarks[name](count);
+    Report(name, "total", timer.elapsed(), "ms");
+
+    ran++;
+  }
+
+  if (ran == 0)
+  {
+    Logger::error("No benchmark matches '" + filter + "'");
+  }
+
+  return ran;
+}
+
+// -benchmark                  run everything with the default count
+// -benchmark Storage          run benchmarks containing "Storage"
+// -benchmark Storage 100000   run with 100000 entities
+// -benchmark 100000           run everything with 100000 entities
+bool Benchmark::RunFromCommandLine(int argc, char** argv)
+{
+  int index = -1;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::string(argv[i]) == "-benchmark")
+    {
+      index = i;
+      break;
+    }
+  }
+
+  if (index < 0)
+    return false;
+
+  std::string filter;
+  int count = 10000;
+
+  for (int i = index + 1; i < argc; ++i)
+  {
+    std::string arg = argv[i];
+
+    if (!arg.empty() && std::isdigit(static_cast<unsigned char>(arg[0])))
+    {
+      count = (std::max)(1, std::atoi(arg.c_str()));
+    }
+    else
+    {
+      filter = arg;
+    }
+  }
+
+  BenchmarkRegistry::instance().run(filter, count);
+  return true;
+}
+
+void Benchmark::Report(const std::string& name, const std::string& label, double value, const std::string& unit)
+{
+  std::ostringstream stream;
+  stream << "  " << name << " " << label << ": " << std::fixed << std::setprecision(3) << value << " " << unit;
+  Logger::write(stream.str());
+}
@@ -0,0 +1,85 @@
+/*
+/
+// filename: Benchmark.h
+// author: Callen Betts
+// brief: defines a small registry of headless benchmarks
+//
+// description: Benchmarks are registered with REGISTER_BENCHMARK and run from the command line with
+//  "-benchmark [name] [count]". They never create a window or a renderer, so they can run on any machine.
+/
+*/
+
+#pragma once
+#include <chrono>
+#include <functional>
+
+namespace Benchmark
+{
+
+  // simple high resolution timer
+  class Stopwatch
+  {
+
+  public:
+
+    Stopwatch() { start(); }
+
+    void start() { begin = std::chrono::high_resolution_clock::now(); }
+
+    // get the time since start in milliseconds
+    double elapsed() const
+    {
+      return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+    }
+
+  private:
+
+    std::chrono::high_resolution_clock::time_point begin;
+
+  };
+
+  // a benchmark takes the amount of entities (or objects) it should work with
+  using BenchmarkFunc = std::function<void(int count)>;
+
+  class BenchmarkRegistry
+  {
+
+  public:
+
+    static BenchmarkRegistry& instance() {
+      static BenchmarkRegistry registry;
+      return registry;
+    }
+
+    void registerBenchmark(const std::string& name, BenchmarkFunc func);
+
+    // run every benchmark whose name contains the filter, an empty filter runs all of them
+    // returns the amount of benchmarks that were run
+    int run(const std::string& filter, int count);
+
+    const std::vector<std::string>& getNames() const { return names; }
+
+  private:
+
+    std::map<std::string, BenchmarkFunc> benchmarks;
+    std::vector<std::string> names;
+
+  };
+
+  // parse "-benchmark [name] [count]" from the command line and run it
+  // returns false if the arguments did not ask for a benchmark
+  bool RunFromCommandLine(int argc, char** argv);
+
+  // write a single result line in a consistent format
+  void Report(const std::string& name, const std::string& label, double value, const std::string& unit);
+
+}
+
+#define REGISTER_BENCHMARK(NAME, FUNC) \
+    namespace { \
+        inline bool registerBenchmark_##NAME() { \
+            Benchmark::BenchmarkRegistry::instance().registerBenchmark(#NAME, FUNC); \
+            return true; \
+        } \
+        static const bool registeredBenchmark_##NAME = registerBenchmark_##NAME(); \
+    }
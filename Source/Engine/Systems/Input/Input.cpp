@@ -12,10 +12,13 @@
 #include "Engine/EngineInstance.h"
 #include "Engine/Graphics/Renderer.h"
 #include "Game/Scene/SceneSystem.h"
+#include "Engine/Platform/Platform.h"
 
 Input::InputSystem::InputSystem(std::string systemName) 
   : System(systemName)
 {
+  writesResource(Systems::Resource::Input);
+
   windowHandle = EngineInstance::getEngine()->getWindowHandle();
   previousMousePosition = { 0 };
   currentMousePosition = { 0 };
@@ -26,7 +29,6 @@ Input::InputSystem::InputSystem(std::string systemName)
   showCursor = true;
   isSimulation = true;
   center = { 0, 0 };
-  clientRect = { 0,0,0,0 };
   pivotPoint = { 0,0 };
 }
 
@@ -78,13 +80,13 @@ void Input::InputSystem::UpdateController()
     showCursor = false;
 
     // calculate mouse position and delta 
-    if (GetCursorPos(&currentMousePosition))
+    if (Platform::GetCursorPosition(currentMousePosition))
     {
       mouseDelta.x = currentMousePosition.x - pivotPoint.x;
       mouseDelta.y = currentMousePosition.y - pivotPoint.y;
 
       previousMousePosition = currentMousePosition;
-      SetCursorPos(pivotPoint.x, pivotPoint.y);
+      Platform::SetCursorPosition(pivotPoint);
     }
     else
     {
@@ -97,17 +99,15 @@ void Input::InputSystem::UpdateController()
     showCursor = false;
 
     // game mouse controller
-    if (GetCursorPos(&currentMousePosition))
+    if (Platform::GetCursorPosition(currentMousePosition))
     {
       // Calculate mouse delta
       mouseDelta.x = currentMousePosition.x - previousMousePosition.x;
       mouseDelta.y = currentMousePosition.y - previousMousePosition.y;
     }
     // focus the mouse in the center of the screen
-    GetClientRect(windowHandle, &clientRect);
-    center = { (clientRect.right - clientRect.left) / 2, (clientRect.bottom - clientRect.top) / 2 };
-    ClientToScreen(windowHandle, &center);
-    SetCursorPos(center.x, center.y);
+    center = Platform::GetWindowCenter(windowHandle);
+    Platform::SetCursorPosition(center);
 
     // update previous mouse position to the center
     previousMousePosition.x = center.x;
@@ -119,7 +119,7 @@ void Input::InputSystem::UpdateController()
     showCursor = true;
 
     // default controller
-    GetCursorPos(&currentMousePosition);
+    Platform::GetCursorPosition(currentMousePosition);
     previousMousePosition = currentMousePosition;
   }
 
@@ -139,13 +139,10 @@ void Input::InputSystem::updateKeyStates()
 
 void Input::InputSystem::updateHotkeys()
 {
-  if (showCursor)
-    while (ShowCursor(TRUE) <= 0);
-  else
-    while (ShowCursor(FALSE) > 0);
+  Platform::ShowCursor(showCursor);
 
   // toggle fullscreen
-  if (keyReleased(VK_TAB))
+  if (keyReleased(Key::Tab))
   {  
     // Flush input so no spam
     Flush();
@@ -153,7 +150,7 @@ void Input::InputSystem::updateHotkeys()
   }
 
   // quick save
-  if (keyDown(VK_CONTROL))
+  if (keyDown(Key::Control))
   {
     if (keyTriggered('S'))
     {
@@ -162,7 +159,7 @@ void Input::InputSystem::updateHotkeys()
   }
 
   // terminate engine on escape
-  if (keyTriggered(VK_ESCAPE))
+  if (keyTriggered(Key::Escape))
   {
     if (!engine->isPlaying())
     {
@@ -175,7 +172,7 @@ void Input::InputSystem::updateHotkeys()
   }
 
   // refocus
-  if (keyTriggered(VK_RETURN))
+  if (keyTriggered(Key::Return))
   {
     if (engine->isPlaying())
     {
@@ -184,7 +181,7 @@ void Input::InputSystem::updateHotkeys()
   }
 }
 
-POINT Input::InputSystem::GetMousePosition()
+Platform::Point Input::InputSystem::GetMousePosition()
 {
   return currentMousePosition;
 }
@@ -196,7 +193,7 @@ void Input::InputSystem::ClearPivot()
 
 void Input::InputSystem::CenterMouse()
 {
-  SetCursorPos(center.x, center.y);
+  Platform::SetCursorPosition(center);
 }
 
 void Input::InputSystem::SetMousePivot(bool val)
@@ -218,9 +215,9 @@ void Input::InputSystem::onKeyRelease(int keycode)
   keystates[keycode] = false;
 }
 
-void Input::InputSystem::onMouseScroll(int param)
+void Input::InputSystem::onMouseScroll(int delta)
 {
-  scrollDelta = GET_WHEEL_DELTA_WPARAM(param);
+  scrollDelta = delta;
 }
 
 void Input::InputSystem::onMouseClick(int param)
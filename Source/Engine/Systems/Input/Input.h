@@ -8,6 +8,8 @@
 
 #pragma once
 #include "Game/System/System.h"
+#include "Engine/Platform/Platform.h"
+#include "Keys.h"
 
 namespace Input
 {
@@ -37,7 +39,7 @@ namespace Input
     // update hotkeys
     void updateHotkeys();
     // get the mouse's position
-    POINT GetMousePosition();
+    Platform::Point GetMousePosition();
     // disable pivot mode
     void ClearPivot();
     // update controller
@@ -51,14 +53,14 @@ namespace Input
     // get the mouse delta
     Vector3D getMouseDelta() { return { (float)mouseDelta.x, (float)mouseDelta.y,0 }; }
 
-    // called when windows triggered a key
+    // called when a key went down; keycode is an Input::Key
     void onKeyTriggered(int keycode);
 
-    // called when windows released a key
+    // called when a key came up; keycode is an Input::Key
     void onKeyRelease(int keycode);
 
-    // called when our mouse was scrolled
-    void onMouseScroll(int param);
+    // called when our mouse was scrolled, positive is up
+    void onMouseScroll(int delta);
 
     // clicking
     void onMouseClick(int param);
@@ -84,20 +86,19 @@ namespace Input
 
     // mouse data
     int scrollDelta;
-    POINT mouseDelta;
-    POINT currentMousePosition;
-    POINT previousMousePosition;
-    POINT pivotPoint;
+    Platform::Point mouseDelta;
+    Platform::Point currentMousePosition;
+    Platform::Point previousMousePosition;
+    Platform::Point pivotPoint;
 
     bool focused;
     bool pivot; // allows us to lock our mouse on a position, letting us 'pivot' if need be
     bool showCursor;
 
-    HWND windowHandle;
+    Platform::WindowHandle windowHandle;
 
     // for handling previous mouse states
-    RECT clientRect;
-    POINT center;
+    Platform::Point center;
 
     // keystates
     std::unordered_map<int, bool> keystates;
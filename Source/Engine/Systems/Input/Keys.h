@@ -0,0 +1,58 @@
+/*
+/
+// filename: Keys.h
+// author: Callen Betts
+// brief: defines the key and mouse button codes the engine's input uses
+//
+// description: Letters and digits are their upper case characters, so 'W' and '1' work as they are. Everything
+//  else goes through here instead of an operating system's codes; Platform::TranslateKey turns those into these.
+/
+*/
+
+#pragma once
+
+namespace Input
+{
+
+  namespace Key
+  {
+    enum : int
+    {
+      // mouse buttons
+      MouseLeft = 0x01,
+      MouseRight = 0x02,
+      MouseMiddle = 0x04,
+
+      Backspace = 0x08,
+      Tab = 0x09,
+      Return = 0x0D,
+      Shift = 0x10,
+      Control = 0x11,
+      Alt = 0x12,
+      Escape = 0x1B,
+      Space = 0x20,
+      Left = 0x25,
+      Up = 0x26,
+      Right = 0x27,
+      Down = 0x28,
+      Delete = 0x2E,
+
+      F1 = 0x70,
+      F2 = 0x71,
+      F3 = 0x72,
+      F4 = 0x73,
+      F5 = 0x74,
+      F6 = 0x75,
+      F7 = 0x76,
+      F8 = 0x77,
+      F9 = 0x78,
+      F10 = 0x79,
+      F11 = 0x7A,
+      F12 = 0x7B,
+
+      // anything that isn't one of the above
+      Unknown = 0xFF
+    };
+  }
+
+}
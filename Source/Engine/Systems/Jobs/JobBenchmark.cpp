@@ -0,0 +1,73 @@
+/*
+/
+// filename: JobBenchmark.cpp
+// author: Callen Betts
+// brief: compares single threaded and job system transform rebuilds
+//
+// description: Rebuilds the matrix of every transform each frame, once with a single threaded job system (every
+//  job inline on the caller) and once with a worker per hardware thread, using the same parallelFor call.
+/
+*/
+
+#include "stdafx.h"
+#include "JobSystem.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+
+namespace
+{
+  constexpr int Frames = 50;
+
+  double RunTransforms(Jobs::JobSystem& jobs, std::vector<Components::Transform*>& transforms)
+  {
+    Benchmark::Stopwatch timer;
+    for (int frame = 0; frame < Frames; ++frame)
+    {
+      jobs.parallelFor((int)transforms.size(), [&transforms, frame](int begin, int end) {
+        for (int i = begin; i < end; ++i)
+        {
+          transforms[i]->setRotation({ 0.f, (float)frame, 0.f });
+          transforms[i]->update();
+        }
+        });
+    }
+    return timer.elapsed() / Frames;
+  }
+
+  void JobBenchmark(int count)
+  {
+    std::vector<Components::Transform*> transforms;
+    transforms.reserve(count);
+
+    for (int i = 0; i < count; ++i)
+    {
+      transforms.push_back(new Components::Transform({ (float)i, 0.f, 0.f }, { 1.f, 1.f, 1.f }, { 0.f, 0.f, 0.f }));
+    }
+
+    double single = 0;
+    double parallel = 0;
+    int threads = 1;
+
+    {
+      Jobs::JobSystem jobs(1);
+      single = RunTransforms(jobs, transforms);
+    }
+
+    {
+      Jobs::JobSystem jobs(0);
+      threads = jobs.getThreadCount();
+      parallel = RunTransforms(jobs, transforms);
+    }
+
+    Benchmark::Report("Jobs", "threads", threads, "");
+    Benchmark::Report("Jobs", "single threaded rebuild", single, "ms/frame");
+    Benchmark::Report("Jobs", "parallel rebuild", parallel, "ms/frame");
+    Benchmark::Report("Jobs", "speedup", parallel > 0 ? single / parallel : 0, "x");
+
+    for (Components::Transform* transform : transforms)
+    {
+      delete transform;
+    }
+  }
+}
+
+REGISTER_BENCHMARK(Jobs, JobBenchmark);
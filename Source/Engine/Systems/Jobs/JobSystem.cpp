@@ -0,0 +1,237 @@
+/*
+/
+// filename: JobSystem.cpp
+// author: Callen Betts
+// brief: implements JobSystem.h
+/
+*/
+
+#include "stdafx.h"
+#include "JobSystem.h"
+
+namespace
+{
+  // which job system and queue the current thread works for
+  thread_local const Jobs::JobSystem* workerOwner = nullptr;
+  thread_local int workerIndex = 0;
+}
+
+Jobs::JobSystem::JobSystem(int threadCount)
+{
+  if (threadCount <= 0)
+  {
+    threadCount = (std::max)(1, (int)std::thread::hardware_concurrency());
+  }
+
+  for (int i = 0; i < threadCount; ++i)
+  {
+    queues.push_back(std::make_unique<WorkerQueue>());
+  }
+
+  // the main thread is worker 0, everything else gets its own thread
+  for (int i = 1; i < threadCount; ++i)
+  {
+    threads.emplace_back(&JobSystem::workerLoop, this, i);
+  }
+
+  Logger::write("Job system running on " + std::to_string(threadCount) + (threadCount == 1 ? " thread (single threaded)" : " threads"));
+}
+
+Jobs::JobSystem::~JobSystem()
+{
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    running = false;
+  }
+  wake.notify_all();
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+}
+
+void Jobs::JobSystem::run(Job job, JobCounter* counter)
+{
+  if (counter)
+  {
+    counter->count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  schedule({ std::move(job), counter });
+}
+
+void Jobs::JobSystem::runAfter(JobCounter* dependency, Job job, JobCounter* counter)
+{
+  // counted right away so waiting on the counter also covers a job that hasn't started yet
+  if (counter)
+  {
+    counter->count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  if (dependency)
+  {
+    std::lock_guard<std::mutex> lock(dependency->mutex);
+    if (dependency->count.load(std::memory_order_acquire) > 0)
+    {
+      dependency->continuations.push_back({ std::move(job), counter });
+      return;
+    }
+  }
+
+  schedule({ std::move(job), counter });
+}
+
+void Jobs::JobSystem::wait(JobCounter* counter)
+{
+  int index = currentIndex();
+
+  while (!counter->isDone())
+  {
+    if (!tryRunOne(index))
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  // the last job may still be inside finish(); taking the lock makes sure it has let go of the counter
+  std::lock_guard<std::mutex> lock(counter->mutex);
+}
+
+bool Jobs::JobSystem::help()
+{
+  return tryRunOne(currentIndex());
+}
+
+void Jobs::JobSystem::schedule(Task task)
+{
+  // single threaded; run right now so the order is exactly the order jobs were scheduled in
+  if (isSingleThreaded())
+  {
+    execute(task);
+    return;
+  }
+
+  WorkerQueue& queue = *queues[currentIndex()];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  pending.fetch_add(1, std::memory_order_release);
+
+  // take the lock so a worker can't miss the wake up between checking for work and going to sleep
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+  }
+  wake.notify_one();
+}
+
+void Jobs::JobSystem::execute(Task& task)
+{
+  task.job();
+  finish(task.counter);
+}
+
+void Jobs::JobSystem::finish(JobCounter* counter)
+{
+  if (!counter)
+    return;
+
+  std::vector<JobCounter::Continuation> ready;
+  {
+    std::lock_guard<std::mutex> lock(counter->mutex);
+    if (counter->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      ready.swap(counter->continuations);
+    }
+  }
+
+  // these were counted when they were queued with runAfter
+  for (JobCounter::Continuation& continuation : ready)
+  {
+    schedule({ std::move(continuation.job), continuation.counter });
+  }
+}
+
+// our own newest job first, it's the most likely to still be in cache
+bool Jobs::JobSystem::pop(int index, Task& task)
+{
+  WorkerQueue& queue = *queues[index];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+
+  if (queue.tasks.empty())
+    return false;
+
+  task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  pending.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+// take the oldest job of another thread, starting with our neighbour so thieves spread out
+bool Jobs::JobSystem::steal(int index, Task& task)
+{
+  int count = (int)queues.size();
+
+  for (int i = 1; i < count; ++i)
+  {
+    WorkerQueue& queue = *queues[(index + i) % count];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.tasks.empty())
+      continue;
+
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    pending.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  return false;
+}
+
+bool Jobs::JobSystem::tryRunOne(int index)
+{
+  Task task;
+
+  if (pop(index, task) || steal(index, task))
+  {
+    execute(task);
+    return true;
+  }
+
+  return false;
+}
+
+int Jobs::JobSystem::currentIndex() const
+{
+  return workerOwner == this ? workerIndex : 0;
+}
+
+void Jobs::JobSystem::workerLoop(int index)
+{
+  workerOwner = this;
+  workerIndex = index;
+
+  while (running)
+  {
+    if (tryRunOne(index))
+      continue;
+
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    wake.wait(lock, [this]() { return pending.load(std::memory_order_acquire) > 0 || !running; });
+  }
+}
+
+int Jobs::ThreadCountFromCommandLine(int argc, char** argv)
+{
+  for (int i = 1; i < argc - 1; ++i)
+  {
+    if (std::string(argv[i]) == "-threads")
+    {
+      return (std::max)(0, std::atoi(argv[i + 1]));
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,161 @@
+/*
+/
+// filename: JobSystem.h
+// author: Callen Betts
+// brief: defines a work stealing thread pool
+//
+// description: Every thread (the main thread included) owns a queue of jobs. A thread takes new work from the
+//  back of its own queue, and when that runs dry it steals from the front of someone else's, so work spreads out
+//  without a single shared queue everyone fights over. Jobs report to a JobCounter; waiting on a counter from the
+//  main thread helps run jobs until everything attached to it has finished. A job can also be held back until
+//  another counter is done, which is how dependencies are expressed.
+//
+//  With a thread count of 1 no workers are started and every job runs inline, in the order it was scheduled.
+//  This is the deterministic mode for debugging.
+/
+*/
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Jobs
+{
+
+  using Job = std::function<void()>;
+
+  // counts unfinished jobs; it is done once every job attached to it has run
+  class JobCounter
+  {
+
+  public:
+
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool isDone() const { return count.load(std::memory_order_acquire) == 0; }
+
+  private:
+
+    friend class JobSystem;
+
+    struct Continuation
+    {
+      Job job;
+      JobCounter* counter;
+    };
+
+    std::atomic<int> count{ 0 };
+    std::mutex mutex;
+    std::vector<Continuation> continuations; // jobs waiting for us to reach zero
+
+  };
+
+  class JobSystem
+  {
+
+  public:
+
+    // 0 uses every hardware thread, 1 runs every job inline on the calling thread
+    JobSystem(int threadCount = 0);
+    ~JobSystem();
+
+    // schedule a job; if a counter is given it stays busy until the job has run
+    void run(Job job, JobCounter* counter = nullptr);
+    // schedule a job that only starts once dependency is done
+    void runAfter(JobCounter* dependency, Job job, JobCounter* counter = nullptr);
+
+    // join; run jobs on the calling thread until the counter is done
+    void wait(JobCounter* counter);
+    // run one queued job on the calling thread, false if there was nothing to do
+    bool help();
+
+    // call func(begin, end) over [0, count) in ranges of at most grain items across every thread, returns once all have run
+    template <typename Func>
+    void parallelFor(int count, int grain, Func&& func)
+    {
+      if (count <= 0)
+        return;
+
+      grain = (std::max)(1, grain);
+
+      // not worth splitting, or we are debugging
+      if (isSingleThreaded() || count <= grain)
+      {
+        func(0, count);
+        return;
+      }
+
+      JobCounter counter;
+      for (int begin = 0; begin < count; begin += grain)
+      {
+        int end = (std::min)(count, begin + grain);
+        run([&func, begin, end]() { func(begin, end); }, &counter);
+      }
+      wait(&counter);
+    }
+
+    // same as above with a grain that gives every thread a few ranges to balance with
+    template <typename Func>
+    void parallelFor(int count, Func&& func)
+    {
+      parallelFor(count, (std::max)(MinGrain, count / (getThreadCount() * 4)), std::forward<Func>(func));
+    }
+
+    // threads doing work, the main thread included
+    int getThreadCount() const { return (int)queues.size(); }
+    bool isSingleThreaded() const { return threads.empty(); }
+
+    // smallest range handed to a single job by default
+    static constexpr int MinGrain = 64;
+
+  private:
+
+    struct Task
+    {
+      Job job;
+      JobCounter* counter = nullptr;
+    };
+
+    struct WorkerQueue
+    {
+      std::mutex mutex;
+      std::deque<Task> tasks;
+    };
+
+    // queue a job that has already been counted
+    void schedule(Task task);
+    void execute(Task& task);
+    // mark a job of a counter finished and release anything waiting on it
+    void finish(JobCounter* counter);
+
+    bool pop(int index, Task& task);
+    bool steal(int index, Task& task);
+    bool tryRunOne(int index);
+
+    // index of the calling thread's queue, the main thread and outside threads use 0
+    int currentIndex() const;
+
+    void workerLoop(int index);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues; // index 0 belongs to the main thread
+    std::vector<std::thread> threads;
+
+    std::atomic<bool> running{ true };
+    std::atomic<int> pending{ 0 }; // jobs sitting in a queue
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+  };
+
+  // read -threads N from the command line, 0 (every hardware thread) if it isn't there
+  int ThreadCountFromCommandLine(int argc, char** argv);
+
+}
@@ -3,53 +3,104 @@
 // filename: Log.cpp
 // author: Callen Betts
 // brief: implements Log.h
+//
+// description: Worlds step on worker threads and log from there, so the file, the streams and the message list
+//  are shared behind one lock. They used to be statics in the header, which gave every file that wrote to the
+//  log its own copy of each and had all of them truncating Log.txt. They're made on first use, since systems
+//  log from static constructors before this file's globals would exist.
 /
 */
 
 #include "stdafx.h"
 #include "Log.h"
+#include <mutex>
+
+namespace
+{
+  struct Log
+  {
+    // define the file to trace to
+    std::ofstream file{ "Log.txt" };
+    std::mutex lock;
+
+    // messages are queued here and moved to the console's list when it asks for them
+    std::vector<std::string> pending;
+    std::vector<std::string> messages;
+    bool addedNewMessage = false;
+  };
+
+  Log& GetLog()
+  {
+    static Log log;
+    return log;
+  }
+
+  // write a line to the file and a stream, the caller holds the lock
+  void WriteLine(Log& log, std::ostream& stream, const char* prefix, const std::string& text)
+  {
+    stream << text << std::endl;
+    log.file << prefix << text << std::endl;
+    log.pending.push_back(text);
+    log.addedNewMessage = true;
+  }
+}
 
 std::vector<std::string>& Logger::getMessages()
 {
-  return messages;
+  Log& log = GetLog();
+  std::lock_guard<std::mutex> guard(log.lock);
+
+  for (std::string& message : log.pending)
+  {
+    log.messages.push_back(std::move(message));
+  }
+  log.pending.clear();
+
+  return log.messages;
 }
 
 bool Logger::AddedNewMessage()
 {
-  return addedNewMessage;
+  Log& log = GetLog();
+  std::lock_guard<std::mutex> guard(log.lock);
+  return log.addedNewMessage;
 }
 
 void Logger::SetNewMessage(bool val)
 {
-  addedNewMessage = val;
+  Log& log = GetLog();
+  std::lock_guard<std::mutex> guard(log.lock);
+  log.addedNewMessage = val;
 }
 
 // write text to the trace log file
 void Logger::write(const std::string text)
 {
-  if (file.is_open())
+  Log& log = GetLog();
+  std::lock_guard<std::mutex> guard(log.lock);
+
+  if (log.file.is_open())
   {
-    // write text 
-    std::cout << text << std::endl;
-    file << "Console: " << text << std::endl;
-    addMessage(text);
+    WriteLine(log, std::cout, "Console: ", text);
   }
 }
 
 // write text to the trace log file with error context
 void Logger::error(const std::string text)
 {
-  if (file.is_open())
+  Log& log = GetLog();
+  std::lock_guard<std::mutex> guard(log.lock);
+
+  if (log.file.is_open())
   {
-    // write text 
-    std::cerr << text << std::endl;
-    file << "ERROR: " << text << std::endl;
-    addMessage(text);
+    WriteLine(log, std::cerr, "ERROR: ", text);
   }
 }
 
 void Logger::addMessage(const std::string text)
 {
-  messages.push_back(text);
-  addedNewMessage = true;
+  Log& log = GetLog();
+  std::lock_guard<std::mutex> guard(log.lock);
+  log.pending.push_back(text);
+  log.addedNewMessage = true;
 }
@@ -7,16 +7,13 @@
 */
 
 #pragma once
+#include <sstream>
 
 namespace Logger
 {
 
-  // define the file to trace to
-  static std::ofstream file("Log.txt");
-  static std::vector<std::string> messages;
-  static bool addedNewMessage = false;
-
-  // retrieve our message vector
+  // retrieve our message vector; messages written from other threads are moved in here when it's asked for,
+  // so only the thread drawing the console should call this
   std::vector<std::string>& getMessages();
 
   // if we've added a new message
@@ -34,13 +31,9 @@ namespace Logger
   template <typename T>
   void write(std::string text, const T value)
   {
-    if (file.is_open())
-    {
-      // write text 
-      std::cout << text << value << std::endl;
-      file << text << value << std::endl;
-      addMessage(text);
-    }
+    std::ostringstream line;
+    line << text << value;
+    write(line.str());
   }
 
 } // Logger
@@ -0,0 +1,217 @@
+/*
+/
+// filename: PoolAllocator.cpp
+// author: Callen Betts
+// brief: implements PoolAllocator.h
+/
+*/
+
+#include "stdafx.h"
+#include "PoolAllocator.h"
+#include <new>
+#include <sstream>
+
+// round a size up to the pool alignment
+static std::size_t RoundSize(std::size_t size)
+{
+  return (size + Memory::PoolAlignment - 1) & ~(Memory::PoolAlignment - 1);
+}
+
+Memory::FixedPool::FixedPool(std::size_t size, PoolAllocator* owner_)
+  :
+  blockSize(RoundSize((std::max)(size, sizeof(FreeBlock)))),
+  owner(owner_)
+{
+  // very large objects still get at least a few blocks per slab
+  blocksPerSlab = (std::max)(4, static_cast<int>(SlabSize / blockSize));
+}
+
+Memory::FixedPool::~FixedPool()
+{
+  for (void* slab : slabs)
+  {
+    ::operator delete(slab, std::align_val_t(PoolAlignment));
+  }
+}
+
+void* Memory::FixedPool::allocate()
+{
+  if (!freeList)
+  {
+    grow();
+  }
+
+  FreeBlock* block = freeList;
+  freeList = block->next;
+  liveCount++;
+  return block;
+}
+
+void Memory::FixedPool::deallocate(void* block)
+{
+  FreeBlock* freed = static_cast<FreeBlock*>(block);
+  freed->next = freeList;
+  freeList = freed;
+  liveCount--;
+}
+
+bool Memory::FixedPool::release()
+{
+  if (liveCount > 0 || slabs.empty())
+    return false;
+
+  for (void* slab : slabs)
+  {
+    ::operator delete(slab, std::align_val_t(PoolAlignment));
+  }
+  slabs.clear();
+  freeList = nullptr;
+  return true;
+}
+
+// carve a new slab into blocks; they are pushed in reverse so allocation walks the slab forwards
+void Memory::FixedPool::grow()
+{
+  unsigned char* slab = static_cast<unsigned char*>(::operator new(blockSize * blocksPerSlab, std::align_val_t(PoolAlignment)));
+  slabs.push_back(slab);
+
+  for (int i = blocksPerSlab - 1; i >= 0; --i)
+  {
+    FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + blockSize * i);
+    block->next = freeList;
+    freeList = block;
+  }
+}
+
+Memory::PoolAllocator::~PoolAllocator()
+{
+  for (auto& [size, pool] : pools)
+  {
+    delete pool;
+  }
+
+  for (FixedPool* pool : typePools)
+  {
+    delete pool;
+  }
+}
+
+Memory::FixedPool* Memory::PoolAllocator::getPool(std::size_t size)
+{
+  std::size_t rounded = RoundSize(size);
+
+  auto it = pools.find(rounded);
+  if (it != pools.end())
+  {
+    return it->second;
+  }
+
+  FixedPool* pool = new FixedPool(rounded, this);
+  pools[rounded] = pool;
+  return pool;
+}
+
+void* Memory::PoolAllocator::take(FixedPool* pool)
+{
+  int slabCount = pool->getSlabCount();
+
+  unsigned char* block = static_cast<unsigned char*>(pool->allocate());
+  *reinterpret_cast<FixedPool**>(block) = pool;
+
+  if (pool->getSlabCount() != slabCount)
+  {
+    stats.slabAllocations++;
+    stats.reservedBytes += pool->getSlabBytes();
+  }
+
+  stats.allocations++;
+  stats.liveBytes += pool->getBlockSize();
+  return block + BlockHeader;
+}
+
+void* Memory::PoolAllocator::allocate(std::size_t size)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  return take(getPool(size + BlockHeader));
+}
+
+void* Memory::PoolAllocator::allocate(std::size_t size, int type, std::size_t typeSize)
+{
+  std::lock_guard<std::mutex> guard(lock);
+
+  if (size > typeSize || type < 0)
+    return take(getPool(size + BlockHeader));
+
+  if (type >= (int)typePools.size())
+  {
+    typePools.resize(type + 1, nullptr);
+  }
+
+  FixedPool*& pool = typePools[type];
+  if (!pool)
+  {
+    pool = new FixedPool(typeSize + BlockHeader, this);
+  }
+
+  return take(pool);
+}
+
+void Memory::PoolAllocator::deallocate(void* block)
+{
+  if (!block)
+    return;
+
+  unsigned char* start = static_cast<unsigned char*>(block) - BlockHeader;
+  FixedPool* pool = *reinterpret_cast<FixedPool**>(start);
+  PoolAllocator* owner = pool->getOwner();
+
+  std::lock_guard<std::mutex> guard(owner->lock);
+  pool->deallocate(start);
+
+  owner->stats.frees++;
+  owner->stats.liveBytes -= pool->getBlockSize();
+}
+
+Memory::PoolAllocator* Memory::PoolAllocator::OwnerOf(const void* block)
+{
+  const unsigned char* start = static_cast<const unsigned char*>(block) - BlockHeader;
+  return (*reinterpret_cast<FixedPool* const*>(start))->getOwner();
+}
+
+// pools that still have live blocks are left alone, anything fully unused goes back to the heap in one go
+void Memory::PoolAllocator::trim()
+{
+  std::lock_guard<std::mutex> guard(lock);
+
+  auto release = [this](FixedPool* pool) {
+    int slabCount = pool->getSlabCount();
+
+    if (pool->release())
+    {
+      stats.slabFrees += slabCount;
+      stats.reservedBytes -= pool->getSlabBytes() * slabCount;
+    }
+  };
+
+  for (auto& [size, pool] : pools)
+  {
+    release(pool);
+  }
+
+  for (FixedPool* pool : typePools)
+  {
+    if (pool)
+      release(pool);
+  }
+}
+
+void Memory::PoolAllocator::logStats(const std::string& label)
+{
+  std::lock_guard<std::mutex> guard(lock);
+
+  std::ostringstream stream;
+  stream << label << ": " << stats.allocations << " allocations, " << stats.frees << " frees, "
+    << stats.slabAllocations << " heap slabs (" << stats.slabFrees << " released), "
+    << stats.liveBytes / 1024 << " KB live, " << stats.reservedBytes / 1024 << " KB reserved";
+  Logger::write(stream.str());
+}
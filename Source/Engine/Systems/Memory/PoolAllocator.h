@@ -0,0 +1,168 @@
+/*
+/
+// filename: PoolAllocator.h
+// author: Callen Betts
+// brief: defines free list pools for entities and components
+//
+// description: Entities and components are small objects that get created and destroyed constantly (spawning,
+//  play/stop, snapshot reloads). Rather than asking the heap for every one of them, they come from pools. A pool
+//  grabs large slabs and carves them into equal blocks kept on a free list, so allocating and freeing is a
+//  pointer swap. Registered component types each get a pool of their own, so a pass over one type walks one run
+//  of slabs; everything else shares a pool per size.
+//
+//  Every scene has its own allocator, an arena that everything it spawns, loads or updates is pooled from. Once
+//  the scene has been cleared or reloaded and its entities are gone, its slabs go back to the heap at once,
+//  without waiting on the camera or prefabs that live in the process's pools. Worlds have one each as well.
+//  A scene deletes its entities before its arena goes, so nothing may keep an entity from a scene's arena past
+//  that scene: moving one into another scene means copying it with the new scene's arena bound and destroying
+//  the original.
+//
+//  Every block remembers the pool it came from, so it goes back there whichever allocator is bound when it is
+//  freed, and each allocator takes a lock, since spawns can come from any thread of an update pass and worlds
+//  free into their own pools from worker threads.
+/
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <mutex>
+
+namespace Memory
+{
+
+  class PoolAllocator;
+
+  // counters so we can see how much work the allocator is doing
+  struct AllocationStats
+  {
+    std::uint64_t allocations = 0; // blocks handed out
+    std::uint64_t frees = 0; // blocks returned
+    std::uint64_t slabAllocations = 0; // times we actually went to the heap
+    std::uint64_t slabFrees = 0;
+    std::size_t liveBytes = 0; // bytes in blocks that are in use
+    std::size_t reservedBytes = 0; // bytes held in slabs
+  };
+
+  // a pool of equally sized blocks
+  class FixedPool
+  {
+
+  public:
+
+    FixedPool(std::size_t blockSize, PoolAllocator* owner);
+    ~FixedPool();
+
+    void* allocate();
+    void deallocate(void* block);
+
+    // free every slab at once, only allowed once no blocks are in use
+    bool release();
+
+    std::size_t getBlockSize() const { return blockSize; }
+    PoolAllocator* getOwner() const { return owner; }
+    int getLiveCount() const { return liveCount; }
+    int getSlabCount() const { return (int)slabs.size(); }
+    std::size_t getSlabBytes() const { return blockSize * blocksPerSlab; }
+
+  private:
+
+    // grab a new slab and push its blocks onto the free list
+    void grow();
+
+    struct FreeBlock
+    {
+      FreeBlock* next;
+    };
+
+    std::size_t blockSize;
+    PoolAllocator* owner;
+    int blocksPerSlab;
+    int liveCount = 0;
+
+    FreeBlock* freeList = nullptr;
+    std::vector<void*> slabs;
+
+  };
+
+  class PoolAllocator
+  {
+
+  public:
+
+    PoolAllocator() = default;
+    ~PoolAllocator();
+
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    // the allocator bound to this thread, a scene's or a world's, or the process's own
+    static PoolAllocator& instance() {
+      static PoolAllocator allocator;
+      return bound ? *bound : allocator;
+    }
+
+    // binds an allocator to the calling thread while it lives, putting back whatever was bound before
+    class Scope
+    {
+
+    public:
+
+      Scope(PoolAllocator& allocator) : previous(bound) { bound = &allocator; }
+      ~Scope() { bound = previous; }
+
+    private:
+
+      PoolAllocator* previous;
+
+    };
+
+    // get a block of at least size bytes, aligned to 16, from the pool for its size
+    void* allocate(std::size_t size);
+    // get a block from the pool kept for one type id; anything bigger than the type, a class derived from it,
+    // falls back to the pool for its size
+    void* allocate(std::size_t size, int type, std::size_t typeSize);
+    // return a block to the pool it came from, whichever allocator that belongs to
+    static void deallocate(void* block);
+
+    // release the slabs of every pool that has no live blocks
+    void trim();
+
+    // the allocator a pooled block came from
+    static PoolAllocator* OwnerOf(const void* block);
+    // scenes mark their allocator, every block in it goes away with the scene
+    void markArena() { arena = true; }
+    bool isArena() const { return arena; }
+
+    const AllocationStats& getStats() const { return stats; }
+    // write the current counters to the log
+    void logStats(const std::string& label);
+
+  private:
+
+    // take a block from a pool of ours; the caller holds the lock
+    void* take(FixedPool* pool);
+    FixedPool* getPool(std::size_t size);
+
+    // set while a scene updates or a world steps, see Scope
+    static inline thread_local PoolAllocator* bound = nullptr;
+
+    std::unordered_map<std::size_t, FixedPool*> pools; // rounded block size to pool
+    std::vector<FixedPool*> typePools; // indexed by type id, nullptr until the type allocates
+    AllocationStats stats;
+    bool arena = false;
+    std::mutex lock;
+
+  };
+
+  // every block is a multiple of this so pooled objects keep their SIMD alignment
+  constexpr std::size_t PoolAlignment = 16;
+
+  // each block starts with the pool it belongs to, padded so the object after it keeps the pool alignment
+  constexpr std::size_t BlockHeader = 16;
+
+  // size of a slab in bytes
+  constexpr std::size_t SlabSize = 64 * 1024;
+
+}
@@ -0,0 +1,147 @@
+/*
+/
+// filename: PoolBenchmark.cpp
+// author: Callen Betts
+// brief: measures spawn/destroy churn through the entity and component pools
+//
+// description: Spawns and destroys the same batch of actor-like entities several times over, the way a scene
+//  reload or a burst of projectiles would. After the first cycle every block should come from a free list, so
+//  the heap slab count should stay flat. The heap baseline allocates objects of the same sizes with the global
+//  operator new for comparison.
+/
+*/
+
+#include "stdafx.h"
+#include "PoolAllocator.h"
+#include "Engine/Entity/Entity.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+
+namespace
+{
+  constexpr int Cycles = 10;
+
+  void SpawnEntities(std::vector<Entities::Entity*>& entities, int count)
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      Entities::Entity* entity = new Entities::Entity();
+      entity->addComponent(new Components::Transform());
+      entity->addComponent(new Components::Physics());
+      entity->addComponent(new Components::BoxCollider());
+      entities.push_back(entity);
+    }
+  }
+
+  void DestroyEntities(std::vector<Entities::Entity*>& entities)
+  {
+    for (Entities::Entity* entity : entities)
+    {
+      delete entity;
+    }
+    entities.clear();
+  }
+
+  // same object sizes straight from the global heap
+  double RunHeap(int count)
+  {
+    const std::size_t sizes[] = {
+      sizeof(Entities::Entity), sizeof(Components::Transform), sizeof(Components::Physics), sizeof(Components::BoxCollider)
+    };
+
+    std::vector<void*> blocks;
+    blocks.reserve(count * 4);
+
+    Benchmark::Stopwatch timer;
+    for (int cycle = 0; cycle < Cycles; ++cycle)
+    {
+      for (int i = 0; i < count; ++i)
+      {
+        for (std::size_t size : sizes)
+        {
+          blocks.push_back(::operator new(size));
+        }
+      }
+
+      for (void* block : blocks)
+      {
+        ::operator delete(block);
+      }
+      blocks.clear();
+    }
+    return timer.elapsed() / Cycles;
+  }
+
+  // same object sizes through the pools
+  double RunPooled(int count)
+  {
+    Memory::PoolAllocator& allocator = Memory::PoolAllocator::instance();
+
+    const std::size_t sizes[] = {
+      sizeof(Entities::Entity), sizeof(Components::Transform), sizeof(Components::Physics), sizeof(Components::BoxCollider)
+    };
+
+    std::vector<void*> blocks;
+    blocks.reserve(count * 4);
+
+    Benchmark::Stopwatch timer;
+    for (int cycle = 0; cycle < Cycles; ++cycle)
+    {
+      for (int i = 0; i < count; ++i)
+      {
+        for (std::size_t size : sizes)
+        {
+          blocks.push_back(allocator.allocate(size));
+        }
+      }
+
+      for (size_t i = 0; i < blocks.size(); ++i)
+      {
+        Memory::PoolAllocator::deallocate(blocks[i]);
+      }
+      blocks.clear();
+    }
+    return timer.elapsed() / Cycles;
+  }
+
+  void PoolBenchmark(int count)
+  {
+    double heap = RunHeap(count);
+    double pooled = RunPooled(count);
+
+    Benchmark::Report("Pool", "heap alloc/free", heap, "ms/cycle");
+    Benchmark::Report("Pool", "pooled alloc/free", pooled, "ms/cycle");
+    Benchmark::Report("Pool", "speedup", pooled > 0 ? heap / pooled : 0, "x");
+
+    // full entity churn in an arena of its own, the way a scene spawns; the first cycle warms the pools and
+    // the rest should reuse them
+    Memory::PoolAllocator arena;
+    Memory::PoolAllocator::Scope scope(arena);
+    std::vector<Entities::Entity*> entities;
+    entities.reserve(count);
+
+    SpawnEntities(entities, count);
+    DestroyEntities(entities);
+
+    std::uint64_t slabsBefore = arena.getStats().slabAllocations;
+
+    Benchmark::Stopwatch timer;
+    for (int cycle = 1; cycle < Cycles; ++cycle)
+    {
+      SpawnEntities(entities, count);
+      DestroyEntities(entities);
+    }
+    double churn = timer.elapsed() / (Cycles - 1);
+
+    std::uint64_t slabsAfter = arena.getStats().slabAllocations;
+
+    Benchmark::Report("Pool", "entity spawn/destroy", churn, "ms/cycle");
+    Benchmark::Report("Pool", "heap slabs after warmup", static_cast<double>(slabsAfter - slabsBefore), "");
+    Benchmark::Report("Pool", "reserved", static_cast<double>(arena.getStats().reservedBytes) / 1024.0, "KB");
+
+    // everything is dead, so a trim should hand every slab back
+    arena.trim();
+    Benchmark::Report("Pool", "reserved after trim", static_cast<double>(arena.getStats().reservedBytes) / 1024.0, "KB");
+  }
+}
+
+REGISTER_BENCHMARK(Pool, PoolBenchmark);
@@ -0,0 +1,144 @@
+/*
+/
+// filename: FrameClock.cpp
+// author: Callen Betts
+// brief: implements FrameClock.h
+/
+*/
+
+#include "stdafx.h"
+#include "FrameClock.h"
+#include "Engine/Platform/Platform.h"
+#include <thread>
+
+Systems::FrameClock::FrameClock()
+{
+  // a project without saved timing steps at 60 Hz
+  std::ifstream file("Data/Timing.json");
+  if (file.is_open())
+  {
+    file.close();
+    load();
+  }
+
+  reset();
+}
+
+void Systems::FrameClock::reset()
+{
+  frameStart = Clock::now();
+  accumulator = 0;
+  alpha = 1.f;
+}
+
+float Systems::FrameClock::tick()
+{
+  const Clock::time_point now = Clock::now();
+  const float frameTime = std::chrono::duration<float>(now - frameStart).count();
+  frameStart = now;
+  return frameTime;
+}
+
+int Systems::FrameClock::advance(float frameTime)
+{
+  const double step = getStep();
+  accumulator += frameTime;
+
+  steps = (int)(accumulator / step);
+
+  // running every step a long hitch asks for only makes the next frame longer, so let the game slow down instead
+  if (steps > maxSteps)
+  {
+    droppedTime += accumulator - maxSteps * step;
+    steps = maxSteps;
+    accumulator = maxSteps * step;
+  }
+
+  accumulator -= steps * step;
+  alpha = (float)std::clamp(accumulator / step, 0.0, 1.0);
+  return steps;
+}
+
+void Systems::FrameClock::limit()
+{
+  idleTime = 0;
+
+  // slowly forget a late wake-up, on frames that don't sleep too, in case it was a one off
+  sleepOvershoot *= 0.99;
+
+  if (frameLimit <= 0)
+    return;
+
+  const Clock::time_point end = frameStart + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / frameLimit));
+  const Clock::time_point waitStart = Clock::now();
+
+  // one sleep for all but the overshoot we expect, then spin the rest
+  const double remaining = std::chrono::duration<double>(end - waitStart).count();
+  if (remaining > sleepOvershoot)
+  {
+    const double request = remaining - sleepOvershoot;
+    Platform::SleepFor(request);
+
+    const double slept = std::chrono::duration<double>(Clock::now() - waitStart).count();
+    sleepOvershoot = (std::max)(sleepOvershoot, slept - request);
+  }
+
+  while (Clock::now() < end)
+  {
+    std::this_thread::yield();
+  }
+
+  idleTime = std::chrono::duration<double, std::milli>(Clock::now() - waitStart).count();
+}
+
+void Systems::FrameClock::setStepRate(float rate)
+{
+  stepRate = std::clamp(rate, 1.f, 1000.f);
+}
+
+void Systems::FrameClock::setMaxSteps(int val)
+{
+  maxSteps = (std::max)(1, val);
+}
+
+void Systems::FrameClock::setFrameLimit(int limit)
+{
+  frameLimit = (std::max)(0, limit);
+}
+
+bool Systems::FrameClock::load(const std::string& filePath)
+{
+  std::ifstream file(filePath);
+  if (!file.is_open())
+  {
+    Logger::write("Failed to find timing " + filePath);
+    return false;
+  }
+
+  nlohmann::json data;
+  file >> data;
+
+  if (data.contains("Step Rate"))
+    setStepRate(data["Step Rate"].get<float>());
+  if (data.contains("Max Steps"))
+    setMaxSteps(data["Max Steps"].get<int>());
+  if (data.contains("Frame Limit"))
+    setFrameLimit(data["Frame Limit"].get<int>());
+
+  Logger::write("Loaded timing from " + filePath + ", stepping at " + std::to_string((int)stepRate) + " Hz");
+  return true;
+}
+
+void Systems::FrameClock::save(const std::string& filePath) const
+{
+  nlohmann::json data;
+  data["Step Rate"] = stepRate;
+  data["Max Steps"] = maxSteps;
+  data["Frame Limit"] = frameLimit;
+
+  std::ofstream file(filePath);
+  file << data.dump(4);
+  file.close();
+
+  Logger::write("Saved timing to " + filePath);
+}
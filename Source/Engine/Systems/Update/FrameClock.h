@@ -0,0 +1,114 @@
+/*
+/
+// filename: FrameClock.h
+// author: Callen Betts
+// brief: defines the clock that runs the simulation at a fixed rate and limits how fast frames go
+//
+// description: Frames take however long they take, but every system updates in steps of exactly one fixed delta
+//  time. Each frame's real time goes into an accumulator and as many whole steps as fit in it run, so physics and
+//  gameplay behave the same at 30 frames a second as at 300. A hitch would otherwise ask for dozens of steps at
+//  once and make the next frame slower still, so past a cap the extra time is dropped and the game slows down
+//  instead. Whatever is left over says how far the frame is between the last two steps, and transforms are
+//  drawn that far between their previous and current matrix.
+//
+//  When a frame finishes early the limiter sleeps once on a high resolution timer (see Platform::SleepFor), asking
+//  for what's left less how much sleeps have lately run over, and spins the last bit. The overshoot it remembers
+//  fades a little every frame whether or not it slept, so one late wake-up doesn't keep it spinning. The step rate,
+//  the catch-up cap and the frame limit belong to the project and are saved next to the scenes.
+/
+*/
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+namespace Engine
+{
+  class WorldContext;
+}
+
+namespace Systems
+{
+
+  class FrameClock
+  {
+
+  public:
+
+    // the clock of the world stepping on this thread, or the engine's
+    static FrameClock& instance() {
+      static FrameClock clock;
+      return bound ? *bound : clock;
+    }
+
+    // start timing from now, forgetting whatever was accumulated
+    void reset();
+    // seconds since the last tick, starting the frame
+    float tick();
+
+    // add a frame's time and return how many fixed steps to run for it, never more than the catch-up cap
+    int advance(float frameTime);
+    // called before every step
+    void beginStep() { ++stepCount; }
+    // steps run since the clock was made, transforms use it to tell which ones moved in the current step
+    std::uint32_t getStepCount() const { return stepCount; }
+
+    // how far the frame is from the last step to the next one, 0 to 1; always 1 when not interpolating
+    float getAlpha() const { return interpolating ? alpha : 1.f; }
+    // in the editor things are drawn exactly where they are
+    void setInterpolating(bool val) { interpolating = val; }
+    bool isInterpolating() const { return interpolating; }
+
+    // wait until the frame limit says the next frame may start, sleeping then spinning
+    void limit();
+
+    // project settings
+    float getStepRate() const { return stepRate; }
+    void setStepRate(float rate);
+    float getStep() const { return 1.f / stepRate; }
+    int getMaxSteps() const { return maxSteps; }
+    void setMaxSteps(int steps);
+    // frames per second to stop at, 0 for no limit
+    int getFrameLimit() const { return frameLimit; }
+    void setFrameLimit(int limit);
+
+    // statistics of the last frame
+    int getSteps() const { return steps; }
+    // seconds the catch-up cap has thrown away since the clock started
+    double getDroppedTime() const { return droppedTime; }
+    // milliseconds the limiter waited
+    double getIdleTime() const { return idleTime; }
+
+    bool load(const std::string& filePath = "Data/Timing.json");
+    void save(const std::string& filePath = "Data/Timing.json") const;
+
+  private:
+
+    friend class Engine::WorldContext;
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    FrameClock();
+
+    // set while a world steps, see Engine::WorldContext
+    static inline thread_local FrameClock* bound = nullptr;
+
+    float stepRate = 60.f;
+    int maxSteps = 5;
+    int frameLimit = 240;
+
+    Clock::time_point frameStart;
+    double accumulator = 0;
+    float alpha = 1.f;
+    bool interpolating = false;
+    std::uint32_t stepCount = 0;
+
+    int steps = 0;
+    double droppedTime = 0;
+    double idleTime = 0;
+    // seconds sleeps have lately woken up past what they asked for, we sleep that much less and spin it instead
+    double sleepOvershoot = 0.001;
+
+  };
+
+}
@@ -0,0 +1,159 @@
+/*
+/
+// filename: UpdatePipeline.cpp
+// author: Callen Betts
+// brief: implements UpdatePipeline.h
+/
+*/
+
+#include "stdafx.h"
+#include "UpdatePipeline.h"
+#include "Engine/Entity/Entity.h"
+#include "Engine/Entity/Components/Physical/TransformBatch.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+#include "Engine/Systems/Jobs/JobSystem.h"
+#include "Engine/GlowEngine.h"
+#include "Game/System/SystemScheduler.h"
+
+namespace
+{
+  // generic pass for mixed classes, goes through the vtable
+  void RunVirtual(Components::Component** components, int count)
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      components[i]->update();
+    }
+  }
+
+  // pass for a single concrete class; the qualified call skips the vtable so the loop body can be inlined
+  template <typename T>
+  void RunExact(Components::Component** components, int count)
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      static_cast<T*>(components[i])->T::update();
+    }
+  }
+}
+
+Systems::ComponentPass::ComponentPass(std::string name, bool simulation, bool parallel, std::initializer_list<Components::Component::ComponentType> types, RunFunc run)
+  :
+  name(name),
+  simulation(simulation),
+  parallel(parallel),
+  types(types),
+  run(run ? run : &RunVirtual)
+{
+}
+
+Systems::UpdatePipeline::UpdatePipeline()
+{
+  // the order here is the order components update in
+  passes.emplace_back("Behaviors", false, false, std::initializer_list<Components::Component::ComponentType>{ Components::Component::Behavior, Components::Component::PlayerBehavior });
+  // physics components only hold a handle now, the scene's physics world integrates them all after this pass
+  passes.emplace_back("Physics", false, false, std::initializer_list<Components::Component::ComponentType>{ Components::Component::Physics }, &RunExact<Components::Physics>);
+  // the scene propagates its transform hierarchy right after this pass, before colliders read world positions
+  passes.emplace_back("Transforms", true, true, std::initializer_list<Components::Component::ComponentType>{ Components::Component::Transform }, &Components::TransformBatch::Run);
+  passes.emplace_back("Colliders", false, true, std::initializer_list<Components::Component::ComponentType>{ Components::Component::Collider, Components::Component::BoxCollider, Components::Component::BoundingBox });
+  passes.emplace_back("Other", true, false, std::initializer_list<Components::Component::ComponentType>{ Components::Component::Animation3D, Components::Component::Sprite3D, Components::Component::Sprite2D });
+
+  // anything without a pass of its own goes in the last one
+  std::fill(std::begin(passOf), std::end(passOf), (int)passes.size() - 1);
+
+  for (int i = 0; i < (int)passes.size(); ++i)
+  {
+    for (Components::Component::ComponentType type : passes[i].types)
+    {
+      passOf[type] = i;
+    }
+  }
+}
+
+void Systems::UpdatePipeline::gather(Entities::Entity* entity)
+{
+  for (Components::Component* component : entity->getComponents())
+  {
+    // a component still shared with the entity's prefab has nothing of the entity's to update
+    if (component->getParent() != entity)
+      continue;
+
+    Components::Component::ComponentType type = component->getType();
+    int pass = (type >= 0 && type < Components::Component::None) ? passOf[type] : (int)passes.size() - 1;
+
+    passes[pass].components.push_back(component);
+  }
+}
+
+void Systems::UpdatePipeline::run()
+{
+  // checked once for the whole frame instead of per component
+  const bool paused = EngineInstance::IsPaused();
+  Jobs::JobSystem* jobs = EngineInstance::GetJobSystem();
+
+  for (ComponentPass& pass : passes)
+  {
+    pass.count = (int)pass.components.size();
+    pass.time = 0;
+
+    // only simulated passes keep running in the editor
+    if (!paused || pass.simulation)
+    {
+#ifdef _DEBUG
+      if (pass.count > 0)
+      {
+        for (Components::Component::ComponentType type : pass.types)
+        {
+          CHECK_COMPONENT_WRITE(type);
+        }
+      }
+#endif
+
+      Benchmark::Stopwatch timer;
+
+      if (pass.parallel && jobs)
+      {
+        Components::Component** components = pass.components.data();
+        ComponentPass::RunFunc run = pass.run;
+        jobs->parallelFor(pass.count, [components, run](int begin, int end) { run(components + begin, end - begin); });
+      }
+      else
+      {
+        pass.run(pass.components.data(), pass.count);
+      }
+
+      if (pass.finish)
+      {
+        pass.finish();
+      }
+
+      pass.time = timer.elapsed();
+    }
+
+    pass.components.clear();
+  }
+}
+
+void Systems::UpdatePipeline::after(const std::string& passName, std::function<void()> step)
+{
+  for (ComponentPass& pass : passes)
+  {
+    if (pass.name == passName)
+    {
+      pass.finish = std::move(step);
+      return;
+    }
+  }
+
+  Logger::error("No update pass named " + passName);
+}
+
+double Systems::UpdatePipeline::getTotalTime() const
+{
+  double total = 0;
+  for (const ComponentPass& pass : passes)
+  {
+    total += pass.time;
+  }
+  return total;
+}
@@ -0,0 +1,102 @@
+/*
+/
+// filename: UpdatePipeline.h
+// author: Callen Betts
+// brief: defines the per component type update passes
+//
+// description: Rather than every entity updating its own components one after another, components are
+//  gathered by type once per frame and each type is updated in its own loop. The passes run in a fixed order:
+//  behaviors, physics integration, transform matrices, collider bounds, then anything else (animations, sprites).
+//  Keeping one type per loop keeps that type's update code hot, and whether a pass runs while the editor is
+//  paused is decided once per pass instead of once per component.
+//
+//  Passes whose components only touch their own entity (transforms, colliders) are marked parallel and split
+//  across the engine's job system. Behaviors run game code and always stay on the main thread. Physics components
+//  only hold a handle into the scene's physics world, so their pass is a short serial loop; the world integrates
+//  every body at once in the step the scene runs after the "Physics" pass.
+//
+//  Entity lists gather by walking each live entity's component vector, so the cost of a frame grows with every
+//  component in the scene, including ones whose pass is skipped while paused. The scene's QueryIndex views can't
+//  replace the walk yet: they hold entities rather than components, an entity can carry more than one component
+//  of a type where only the first fills its slot, and behaviors rely on updating in list order.
+/
+*/
+
+#pragma once
+#include <initializer_list>
+#include <functional>
+
+namespace Entities
+{
+  class Entity;
+}
+
+namespace Systems
+{
+
+  // updates every gathered component of one or more component types in a single loop
+  class ComponentPass
+  {
+
+  public:
+
+    // update a range of gathered components
+    using RunFunc = void (*)(Components::Component** components, int count);
+
+    ComponentPass(std::string name, bool simulation, bool parallel, std::initializer_list<Components::Component::ComponentType> types, RunFunc run = nullptr);
+
+    const std::string& getName() const { return name; }
+    const std::vector<Components::Component::ComponentType>& getTypes() const { return types; }
+    // if this pass runs while the editor is paused
+    bool IsSimulation() const { return simulation; }
+    // if this pass can be split across threads
+    bool IsParallel() const { return parallel; }
+
+    // time taken by the pass last frame in milliseconds, and how many components it updated
+    double getTime() const { return time; }
+    int getCount() const { return count; }
+
+  private:
+
+    friend class UpdatePipeline;
+
+    std::string name;
+    bool simulation;
+    bool parallel;
+    std::vector<Components::Component::ComponentType> types;
+    RunFunc run;
+    std::function<void()> finish; // runs on the main thread once every component of the pass has updated
+
+    std::vector<Components::Component*> components; // gathered this frame
+
+    double time = 0;
+    int count = 0;
+
+  };
+
+  class UpdatePipeline
+  {
+
+  public:
+
+    UpdatePipeline();
+
+    // collect the components of an entity into the passes; called by entity lists during their update
+    void gather(Entities::Entity* entity);
+    // run every pass in order and clear what was gathered
+    void run();
+    // run a step right after a pass, e.g. propagating the transform hierarchy after the transforms update
+    void after(const std::string& passName, std::function<void()> step);
+
+    const std::vector<ComponentPass>& getPasses() const { return passes; }
+    // total time of every pass last frame in milliseconds
+    double getTotalTime() const;
+
+  private:
+
+    std::vector<ComponentPass> passes;
+    int passOf[Components::Component::None]; // component type to pass index, the last pass catches the rest
+
+  };
+
+}
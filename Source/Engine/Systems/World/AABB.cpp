@@ -0,0 +1,182 @@
+/*
+/
+// filename: AABB.cpp
+// author: Callen Betts
+// brief: implements AABB.h
+/
+*/
+
+#include "stdafx.h"
+#include "AABB.h"
+#include <cmath>
+
+World::Ray::Ray(Vector3D rayOrigin, Vector3D rayDirection, float distance)
+  :
+  origin{ rayOrigin.x, rayOrigin.y, rayOrigin.z },
+  direction{ rayDirection.x, rayDirection.y, rayDirection.z },
+  maxDistance(distance)
+{
+  // axes the ray runs parallel to are handled separately by the slab test
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    inverse[axis] = direction[axis] != 0 ? 1.0f / direction[axis] : 0.0f;
+  }
+}
+
+World::AABB World::AABB::Union(const AABB& a, const AABB& b)
+{
+  AABB result;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    result.min[axis] = (std::min)(a.min[axis], b.min[axis]);
+    result.max[axis] = (std::max)(a.max[axis], b.max[axis]);
+  }
+  return result;
+}
+
+World::AABB World::AABB::Around(const float center[3], float radius)
+{
+  AABB result;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    result.min[axis] = center[axis] - radius;
+    result.max[axis] = center[axis] + radius;
+  }
+  return result;
+}
+
+float World::AABB::area() const
+{
+  const float x = max[0] - min[0];
+  const float y = max[1] - min[1];
+  const float z = max[2] - min[2];
+  return x * y + y * z + z * x;
+}
+
+World::AABB World::AABB::fattened(float margin) const
+{
+  AABB result;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    result.min[axis] = min[axis] - margin;
+    result.max[axis] = max[axis] + margin;
+  }
+  return result;
+}
+
+bool World::AABB::contains(const AABB& other) const
+{
+  return min[0] <= other.min[0] && min[1] <= other.min[1] && min[2] <= other.min[2]
+    && max[0] >= other.max[0] && max[1] >= other.max[1] && max[2] >= other.max[2];
+}
+
+bool World::AABB::overlaps(const AABB& other) const
+{
+  return min[0] <= other.max[0] && max[0] >= other.min[0]
+    && min[1] <= other.max[1] && max[1] >= other.min[1]
+    && min[2] <= other.max[2] && max[2] >= other.min[2];
+}
+
+bool World::AABB::operator==(const AABB& other) const
+{
+  return std::equal(min, min + 3, other.min) && std::equal(max, max + 3, other.max);
+}
+
+float World::AABB::distanceSquared(const float point[3]) const
+{
+  float total = 0;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    float outside = (std::max)((std::max)(min[axis] - point[axis], 0.0f), point[axis] - max[axis]);
+    total += outside * outside;
+  }
+  return total;
+}
+
+bool World::AABB::raycast(const Ray& ray, float maxDistance, float& distance) const
+{
+  float enter = 0;
+  float exit = maxDistance;
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    if (ray.direction[axis] == 0)
+    {
+      // parallel to this slab, we either always or never are inside it
+      if (ray.origin[axis] < min[axis] || ray.origin[axis] > max[axis])
+        return false;
+
+      continue;
+    }
+
+    float entering = (min[axis] - ray.origin[axis]) * ray.inverse[axis];
+    float leaving = (max[axis] - ray.origin[axis]) * ray.inverse[axis];
+
+    if (entering > leaving)
+      std::swap(entering, leaving);
+
+    enter = (std::max)(enter, entering);
+    exit = (std::min)(exit, leaving);
+
+    if (enter > exit)
+      return false;
+  }
+
+  distance = enter;
+  return true;
+}
+
+// a ray from the moving box against the other box grown by the moving box's size, one slab at a time
+bool World::AABB::sweep(const AABB& other, const float displacement[3], float& time, int& axis) const
+{
+  float enter = -FLT_MAX;
+  float exit = FLT_MAX;
+  int enterAxis = 0;
+
+  for (int i = 0; i < 3; ++i)
+  {
+    if (displacement[i] == 0)
+    {
+      // not moving on this axis, faces that only touch let us slide past
+      if (max[i] <= other.min[i] || min[i] >= other.max[i])
+        return false;
+
+      continue;
+    }
+
+    const float inverse = 1.f / displacement[i];
+    float entering = (displacement[i] > 0 ? other.min[i] - max[i] : other.max[i] - min[i]) * inverse;
+    float leaving = (displacement[i] > 0 ? other.max[i] - min[i] : other.min[i] - max[i]) * inverse;
+
+    if (entering > enter)
+    {
+      enter = entering;
+      enterAxis = i;
+    }
+    exit = (std::min)(exit, leaving);
+  }
+
+  // overlapping already is the narrowphase's to resolve
+  if (enter > exit || enter < 0 || enter >= 1)
+    return false;
+
+  time = enter;
+  axis = enterAxis;
+  return true;
+}
+
+void World::KeepNearest(std::vector<Neighbor>& nearest, int k, const Neighbor& candidate)
+{
+  if (k <= 0 || ((int)nearest.size() == k && candidate.distanceSquared >= nearest.back().distanceSquared))
+    return;
+
+  auto it = std::upper_bound(nearest.begin(), nearest.end(), candidate, [](const Neighbor& a, const Neighbor& b) {
+    return a.distanceSquared < b.distanceSquared;
+  });
+  nearest.insert(it, candidate);
+
+  if ((int)nearest.size() > k)
+  {
+    nearest.pop_back();
+  }
+}
@@ -0,0 +1,85 @@
+/*
+/
+// filename: AABB.h
+// author: Callen Betts
+// brief: defines axis aligned boxes, rays and the results of spatial queries
+/
+*/
+
+#pragma once
+#include <functional>
+#include <cfloat>
+
+namespace Entities
+{
+  class Entity;
+}
+
+namespace World
+{
+
+  // a ray with its inverse direction precomputed for box tests; distances are in lengths of direction
+  struct Ray
+  {
+    Ray(Vector3D origin, Vector3D direction, float maxDistance = FLT_MAX);
+
+    float origin[3];
+    float direction[3];
+    float inverse[3];
+    float maxDistance;
+  };
+
+  struct AABB
+  {
+    float min[3] = { 0, 0, 0 };
+    float max[3] = { 0, 0, 0 };
+
+    static AABB Union(const AABB& a, const AABB& b);
+    // a box around a sphere
+    static AABB Around(const float center[3], float radius);
+
+    // half the surface area, the cost used to decide how to split and where to insert
+    float area() const;
+    // grow the box by a margin on every side
+    AABB fattened(float margin) const;
+
+    bool contains(const AABB& other) const;
+    bool overlaps(const AABB& other) const;
+    bool operator==(const AABB& other) const;
+
+    // squared distance from a point to the box, 0 inside it
+    float distanceSquared(const float point[3]) const;
+    // where a ray enters the box, false if it misses or enters past maxDistance; 0 if it starts inside
+    bool raycast(const Ray& ray, float maxDistance, float& distance) const;
+    // the fraction of a move by displacement this box makes before touching another box, and the axis it touches
+    // on; false if it never gets there, or if the boxes already overlap at the start
+    bool sweep(const AABB& other, const float displacement[3], float& time, int& axis) const;
+  };
+
+  struct RayHit
+  {
+    Entities::Entity* entity = nullptr;
+    float distance = FLT_MAX;
+  };
+
+  // the first entity a moving box runs into, time is the fraction of the move made before touching it
+  struct SweepHit
+  {
+    Entities::Entity* entity = nullptr;
+    float time = 1;
+    int axis = 0;
+  };
+
+  struct Neighbor
+  {
+    Entities::Entity* entity;
+    float distanceSquared;
+  };
+
+  // which entities a query may return; queries from the job system call it from several threads
+  using QueryFilter = std::function<bool(Entities::Entity*)>;
+
+  // keep the k closest neighbors sorted nearest first
+  void KeepNearest(std::vector<Neighbor>& nearest, int k, const Neighbor& candidate);
+
+}
@@ -0,0 +1,455 @@
+/*
+/
+// filename: AABBTree.cpp
+// author: Callen Betts
+// brief: implements AABBTree.h
+/
+*/
+
+#include "stdafx.h"
+#include "AABBTree.h"
+#include "Engine/Entity/Entity.h"
+#include <queue>
+
+void World::AABBTree::update(Entities::Entity* entity, const AABB& box)
+{
+  const Entities::EntityHandle handle = entity->getHandle();
+  int leaf = find(entity);
+
+  // the slot was reused by a new entity before the old leaf was swept
+  if (leaf == Null && handle.index < leafOf.size() && leafOf[handle.index] != Null)
+  {
+    int old = leafOf[handle.index];
+    removeLeaf(old);
+    release(old);
+    leafOf[handle.index] = Null;
+    count--;
+  }
+
+  if (leaf == Null)
+  {
+    leaf = allocate();
+    Node& node = nodes[leaf];
+    node.entity = entity;
+    node.handle = handle;
+    node.tight = box;
+    node.box = box.fattened(Margin);
+    node.seen = sweep;
+    insertLeaf(leaf);
+
+    if (handle.index >= leafOf.size())
+    {
+      leafOf.resize(handle.index + 1, Null);
+    }
+    leafOf[handle.index] = leaf;
+    count++;
+    return;
+  }
+
+  Node& node = nodes[leaf];
+  node.entity = entity;
+  node.tight = box;
+  node.seen = sweep;
+
+  // still inside the grown box, the tree doesn't change
+  if (node.box.contains(box))
+    return;
+
+  removeLeaf(leaf);
+  nodes[leaf].box = box.fattened(Margin);
+  insertLeaf(leaf);
+  reinserts++;
+}
+
+void World::AABBTree::remove(Entities::Entity* entity)
+{
+  int leaf = find(entity);
+  if (leaf == Null)
+    return;
+
+  removeLeaf(leaf);
+  release(leaf);
+  leafOf[entity->getHandle().index] = Null;
+  count--;
+}
+
+void World::AABBTree::removeStale()
+{
+  for (int i = 0; i < (int)nodes.size(); ++i)
+  {
+    Node& node = nodes[i];
+    if (node.height != 0 || node.seen == sweep)
+      continue;
+
+    leafOf[node.handle.index] = Null;
+    removeLeaf(i);
+    release(i);
+    count--;
+  }
+
+  sweep++;
+  reinserts = 0;
+}
+
+bool World::AABBTree::contains(const Entities::Entity* entity) const
+{
+  return find(entity) != Null;
+}
+
+void World::AABBTree::clear()
+{
+  nodes.clear();
+  leafOf.clear();
+  root = Null;
+  freeList = Null;
+  count = 0;
+  reinserts = 0;
+}
+
+World::RayHit World::AABBTree::raycast(const Ray& ray, const QueryFilter& filter) const
+{
+  RayHit hit;
+  hit.distance = ray.maxDistance;
+
+  if (root == Null)
+    return hit;
+
+  std::vector<int> stack;
+  stack.push_back(root);
+
+  while (!stack.empty())
+  {
+    const Node& node = nodes[stack.back()];
+    stack.pop_back();
+
+    // anything past the closest hit so far can't win
+    float distance;
+    if (!node.box.raycast(ray, hit.distance, distance))
+      continue;
+
+    if (node.isLeaf())
+    {
+      if (node.tight.raycast(ray, hit.distance, distance) && distance < hit.distance && (!filter || filter(node.entity)))
+      {
+        hit.entity = node.entity;
+        hit.distance = distance;
+      }
+      continue;
+    }
+
+    stack.push_back(node.children[0]);
+    stack.push_back(node.children[1]);
+  }
+
+  if (!hit.entity)
+  {
+    hit.distance = FLT_MAX;
+  }
+  return hit;
+}
+
+void World::AABBTree::overlap(const AABB& box, std::vector<Entities::Entity*>& results, const QueryFilter& filter) const
+{
+  if (root == Null)
+    return;
+
+  std::vector<int> stack;
+  stack.push_back(root);
+
+  while (!stack.empty())
+  {
+    const Node& node = nodes[stack.back()];
+    stack.pop_back();
+
+    if (!node.box.overlaps(box))
+      continue;
+
+    if (node.isLeaf())
+    {
+      if (node.tight.overlaps(box) && (!filter || filter(node.entity)))
+      {
+        results.push_back(node.entity);
+      }
+      continue;
+    }
+
+    stack.push_back(node.children[0]);
+    stack.push_back(node.children[1]);
+  }
+}
+
+void World::AABBTree::overlapSphere(const float center[3], float radius, std::vector<Entities::Entity*>& results, const QueryFilter& filter) const
+{
+  if (root == Null)
+    return;
+
+  const float radiusSquared = radius * radius;
+
+  std::vector<int> stack;
+  stack.push_back(root);
+
+  while (!stack.empty())
+  {
+    const Node& node = nodes[stack.back()];
+    stack.pop_back();
+
+    if (node.box.distanceSquared(center) > radiusSquared)
+      continue;
+
+    if (node.isLeaf())
+    {
+      if (node.tight.distanceSquared(center) <= radiusSquared && (!filter || filter(node.entity)))
+      {
+        results.push_back(node.entity);
+      }
+      continue;
+    }
+
+    stack.push_back(node.children[0]);
+    stack.push_back(node.children[1]);
+  }
+}
+
+void World::AABBTree::nearest(const float point[3], int k, std::vector<Neighbor>& nearest, const QueryFilter& filter) const
+{
+  if (root == Null || k <= 0)
+    return;
+
+  // visit the closest branches first, and stop once no branch can beat the k found so far
+  using Entry = std::pair<float, int>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+  open.push({ nodes[root].box.distanceSquared(point), root });
+
+  while (!open.empty())
+  {
+    auto [distance, index] = open.top();
+    open.pop();
+
+    if ((int)nearest.size() == k && distance >= nearest.back().distanceSquared)
+      break;
+
+    const Node& node = nodes[index];
+
+    if (node.isLeaf())
+    {
+      if (!filter || filter(node.entity))
+      {
+        KeepNearest(nearest, k, { node.entity, node.tight.distanceSquared(point) });
+      }
+      continue;
+    }
+
+    for (int child : node.children)
+    {
+      open.push({ nodes[child].box.distanceSquared(point), child });
+    }
+  }
+}
+
+int World::AABBTree::allocate()
+{
+  if (freeList == Null)
+  {
+    nodes.emplace_back();
+    return (int)nodes.size() - 1;
+  }
+
+  int node = freeList;
+  freeList = nodes[node].parent;
+  nodes[node] = Node();
+  return node;
+}
+
+void World::AABBTree::release(int node)
+{
+  nodes[node].parent = freeList;
+  nodes[node].height = -1;
+  nodes[node].entity = nullptr;
+  freeList = node;
+}
+
+void World::AABBTree::insertLeaf(int leaf)
+{
+  if (root == Null)
+  {
+    root = leaf;
+    nodes[root].parent = Null;
+    return;
+  }
+
+  // walk down to the sibling that makes the tree's total area grow the least
+  const AABB leafBox = nodes[leaf].box;
+  int index = root;
+
+  while (!nodes[index].isLeaf())
+  {
+    const Node& node = nodes[index];
+    const float area = node.box.area();
+    const float combinedArea = AABB::Union(node.box, leafBox).area();
+
+    // pairing with this whole branch
+    const float cost = 2.0f * combinedArea;
+    // every node above a child we descend into grows by this much as well
+    const float inheritedCost = 2.0f * (combinedArea - area);
+
+    float childCost[2];
+    for (int i = 0; i < 2; ++i)
+    {
+      const Node& child = nodes[node.children[i]];
+      const float grown = AABB::Union(leafBox, child.box).area();
+      childCost[i] = (child.isLeaf() ? grown : grown - child.box.area()) + inheritedCost;
+    }
+
+    if (cost < childCost[0] && cost < childCost[1])
+      break;
+
+    index = childCost[0] < childCost[1] ? node.children[0] : node.children[1];
+  }
+
+  const int sibling = index;
+  const int oldParent = nodes[sibling].parent;
+  const int newParent = allocate();
+
+  Node& parent = nodes[newParent];
+  parent.parent = oldParent;
+  parent.box = AABB::Union(leafBox, nodes[sibling].box);
+  parent.height = nodes[sibling].height + 1;
+  parent.children[0] = sibling;
+  parent.children[1] = leaf;
+
+  if (oldParent != Null)
+  {
+    Node& grandParent = nodes[oldParent];
+    grandParent.children[grandParent.children[0] == sibling ? 0 : 1] = newParent;
+  }
+  else
+  {
+    root = newParent;
+  }
+
+  nodes[sibling].parent = newParent;
+  nodes[leaf].parent = newParent;
+
+  refit(newParent);
+}
+
+void World::AABBTree::removeLeaf(int leaf)
+{
+  if (leaf == root)
+  {
+    root = Null;
+    return;
+  }
+
+  const int parent = nodes[leaf].parent;
+  const int grandParent = nodes[parent].parent;
+  const int sibling = nodes[parent].children[0] == leaf ? nodes[parent].children[1] : nodes[parent].children[0];
+
+  // the sibling takes the parent's place
+  if (grandParent != Null)
+  {
+    Node& node = nodes[grandParent];
+    node.children[node.children[0] == parent ? 0 : 1] = sibling;
+    nodes[sibling].parent = grandParent;
+    release(parent);
+    refit(grandParent);
+  }
+  else
+  {
+    root = sibling;
+    nodes[sibling].parent = Null;
+    release(parent);
+  }
+
+  nodes[leaf].parent = Null;
+}
+
+void World::AABBTree::refit(int index)
+{
+  while (index != Null)
+  {
+    index = balance(index);
+
+    Node& node = nodes[index];
+    const Node& a = nodes[node.children[0]];
+    const Node& b = nodes[node.children[1]];
+
+    node.height = 1 + (std::max)(a.height, b.height);
+    node.box = AABB::Union(a.box, b.box);
+
+    index = node.parent;
+  }
+}
+
+int World::AABBTree::balance(int indexA)
+{
+  Node& a = nodes[indexA];
+  if (a.isLeaf() || a.height < 2)
+    return indexA;
+
+  const int indexB = a.children[0];
+  const int indexC = a.children[1];
+  Node& b = nodes[indexB];
+  Node& c = nodes[indexC];
+
+  const int difference = c.height - b.height;
+
+  // the taller child takes A's place, A takes the taller child's shorter grandchild
+  auto rotateUp = [&](int indexUp, Node& up, int side, Node& other) {
+    const int indexF = up.children[0];
+    const int indexG = up.children[1];
+    Node& f = nodes[indexF];
+    Node& g = nodes[indexG];
+
+    up.children[0] = indexA;
+    up.parent = a.parent;
+    a.parent = indexUp;
+
+    if (up.parent != Null)
+    {
+      Node& parent = nodes[up.parent];
+      parent.children[parent.children[0] == indexA ? 0 : 1] = indexUp;
+    }
+    else
+    {
+      root = indexUp;
+    }
+
+    // the taller grandchild stays with the node moving up, the shorter one goes to A in the up node's old place
+    const bool keepF = f.height > g.height;
+    const int indexKeep = keepF ? indexF : indexG;
+    const int indexGive = keepF ? indexG : indexF;
+    Node& keep = nodes[indexKeep];
+    Node& give = nodes[indexGive];
+
+    up.children[1] = indexKeep;
+    a.children[side] = indexGive;
+    give.parent = indexA;
+
+    a.box = AABB::Union(other.box, give.box);
+    a.height = 1 + (std::max)(other.height, give.height);
+    up.box = AABB::Union(a.box, keep.box);
+    up.height = 1 + (std::max)(a.height, keep.height);
+
+    return indexUp;
+  };
+
+  if (difference > 1)
+    return rotateUp(indexC, c, 1, b);
+
+  if (difference < -1)
+    return rotateUp(indexB, b, 0, c);
+
+  return indexA;
+}
+
+int World::AABBTree::find(const Entities::Entity* entity) const
+{
+  const Entities::EntityHandle handle = entity->getHandle();
+
+  if (handle.index >= leafOf.size() || leafOf[handle.index] == Null)
+    return Null;
+
+  const int leaf = leafOf[handle.index];
+  return nodes[leaf].handle == handle ? leaf : Null;
+}
@@ -0,0 +1,95 @@
+/*
+/
+// filename: AABBTree.h
+// author: Callen Betts
+// brief: defines a dynamic bounding volume tree of entity boxes
+//
+// description: Every leaf holds an entity's box grown by a margin, and every branch holds the box around its two
+//  children. Queries skip any branch whose box they miss, so a ray or overlap only visits the few leaves near it
+//  instead of every entity.
+//
+//  When an entity moves but its box stays inside its grown leaf box, nothing changes. Once it leaves, the leaf is
+//  taken out and inserted again next to whichever sibling grows the tree's area the least. The branches on the
+//  way back up are rotated whenever one side gets more than one level taller than the other, so the tree stays
+//  balanced however entities move.
+/
+*/
+
+#pragma once
+#include "AABB.h"
+#include "Engine/Entity/EntityHandle.h"
+
+namespace World
+{
+
+  class AABBTree
+  {
+
+  public:
+
+    // how far a leaf box reaches past its entity's box, small moves inside it don't touch the tree
+    static constexpr float Margin = 0.25f;
+
+    // insert an entity's box or move it; marks the leaf as seen for removeStale
+    void update(Entities::Entity* entity, const AABB& box);
+    void remove(Entities::Entity* entity);
+    // remove every leaf that wasn't updated since the last call
+    void removeStale();
+    bool contains(const Entities::Entity* entity) const;
+    void clear();
+
+    // the closest entity the ray hits within its max distance
+    RayHit raycast(const Ray& ray, const QueryFilter& filter = nullptr) const;
+    // entities whose box overlaps a box or a sphere
+    void overlap(const AABB& box, std::vector<Entities::Entity*>& results, const QueryFilter& filter = nullptr) const;
+    void overlapSphere(const float center[3], float radius, std::vector<Entities::Entity*>& results, const QueryFilter& filter = nullptr) const;
+    // merge the k entities closest to a point into nearest, which is kept sorted nearest first
+    void nearest(const float point[3], int k, std::vector<Neighbor>& nearest, const QueryFilter& filter = nullptr) const;
+
+    int getCount() const { return count; }
+    int getHeight() const { return root == Null ? 0 : nodes[root].height; }
+    // leaves that had to be reinserted since the last removeStale
+    int getReinsertCount() const { return reinserts; }
+
+  private:
+
+    static constexpr int Null = -1;
+
+    struct Node
+    {
+      AABB box; // grown by the margin for leaves
+      AABB tight; // the entity's real box, leaves only
+      Entities::Entity* entity = nullptr;
+      Entities::EntityHandle handle;
+      int parent = Null; // the next free node while on the free list
+      int children[2] = { Null, Null };
+      int height = 0; // leaves are 0, free nodes -1
+      std::uint32_t seen = 0;
+
+      bool isLeaf() const { return children[0] == Null; }
+    };
+
+    int allocate();
+    void release(int node);
+
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    // rotate the taller grandchild up if a node is unbalanced, returns the node now in its place
+    int balance(int node);
+    // refit boxes and heights from a node up to the root, balancing on the way
+    void refit(int node);
+
+    int find(const Entities::Entity* entity) const;
+
+    std::vector<Node> nodes;
+    int root = Null;
+    int freeList = Null;
+
+    std::vector<int> leafOf; // registry slot to leaf node
+    int count = 0;
+    int reinserts = 0;
+    std::uint32_t sweep = 1;
+
+  };
+
+}
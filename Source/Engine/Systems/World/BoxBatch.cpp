@@ -0,0 +1,155 @@
+/*
+/
+// filename: BoxBatch.cpp
+// author: Callen Betts
+// brief: implements BoxBatch.h
+/
+*/
+
+#include "stdafx.h"
+#include "BoxBatch.h"
+#include <cfloat>
+
+bool World::BoxBatch::Overlap(const float minA[3], const float maxA[3], const float minB[3], const float maxB[3], Penetration& penetration)
+{
+  const bool overlapX = minA[0] < maxB[0] && maxA[0] > minB[0];
+  const bool overlapY = minA[1] <= maxB[1] && maxA[1] > minB[1];
+  const bool overlapZ = minA[2] < maxB[2] && maxA[2] > minB[2];
+
+  if (!(overlapX && overlapY && overlapZ))
+    return false;
+
+  // both sizes less the distance between the centers, halved
+  penetration.depth = FLT_MAX;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const float sizes = (maxA[axis] - minA[axis]) + (maxB[axis] - minB[axis]);
+    const float distance = std::abs((minA[axis] + maxA[axis]) - (minB[axis] + maxB[axis]));
+    const float depth = (sizes - distance) * 0.5f;
+
+    if (depth < penetration.depth)
+    {
+      penetration.depth = depth;
+      penetration.axis = axis;
+    }
+  }
+
+  return true;
+}
+
+void World::BoxBatch::clear()
+{
+  minX.clear(); minY.clear(); minZ.clear();
+  maxX.clear(); maxY.clear(); maxZ.clear();
+  count = 0;
+}
+
+int World::BoxBatch::add(const float min[3], const float max[3])
+{
+  // pad a whole block of empty boxes at a time, they fail every overlap test
+  if (count % Width == 0)
+  {
+    minX.resize(count + Width, FLT_MAX); minY.resize(count + Width, FLT_MAX); minZ.resize(count + Width, FLT_MAX);
+    maxX.resize(count + Width, -FLT_MAX); maxY.resize(count + Width, -FLT_MAX); maxZ.resize(count + Width, -FLT_MAX);
+  }
+
+  minX[count] = min[0]; minY[count] = min[1]; minZ[count] = min[2];
+  maxX[count] = max[0]; maxY[count] = max[1]; maxZ[count] = max[2];
+  return count++;
+}
+
+int World::BoxBatch::add(const BoxBatch& other, int index)
+{
+  float min[3], max[3];
+  other.get(index, min, max);
+  return add(min, max);
+}
+
+void World::BoxBatch::get(int index, float min[3], float max[3]) const
+{
+  min[0] = minX[index]; min[1] = minY[index]; min[2] = minZ[index];
+  max[0] = maxX[index]; max[1] = maxY[index]; max[2] = maxZ[index];
+}
+
+void World::BoxBatch::overlap(const float min[3], const float max[3], std::vector<Hit>& hits) const
+{
+  using namespace DirectX;
+
+  const XMVECTOR aMinX = XMVectorReplicate(min[0]), aMinY = XMVectorReplicate(min[1]), aMinZ = XMVectorReplicate(min[2]);
+  const XMVECTOR aMaxX = XMVectorReplicate(max[0]), aMaxY = XMVectorReplicate(max[1]), aMaxZ = XMVectorReplicate(max[2]);
+
+  // sizes and doubled centers of the tested box, the same for every block
+  const XMVECTOR aSizeX = XMVectorSubtract(aMaxX, aMinX), aSizeY = XMVectorSubtract(aMaxY, aMinY), aSizeZ = XMVectorSubtract(aMaxZ, aMinZ);
+  const XMVECTOR aCenterX = XMVectorAdd(aMinX, aMaxX), aCenterY = XMVectorAdd(aMinY, aMaxY), aCenterZ = XMVectorAdd(aMinZ, aMaxZ);
+
+  const XMVECTOR none = XMVectorFalseInt();
+  const XMVECTOR half = XMVectorReplicate(0.5f);
+  const XMVECTOR axisY = XMVectorReplicate(1.0f);
+  const XMVECTOR axisZ = XMVectorReplicate(2.0f);
+
+  for (int i = 0; i < count; i += Width)
+  {
+    auto load = [i](const std::vector<float>& values) { return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&values[i])); };
+
+    const XMVECTOR bMinX = load(minX), bMinY = load(minY), bMinZ = load(minZ);
+    const XMVECTOR bMaxX = load(maxX), bMaxY = load(maxY), bMaxZ = load(maxZ);
+
+    XMVECTOR overlaps = XMVectorAndInt(XMVectorLess(aMinX, bMaxX), XMVectorGreater(aMaxX, bMinX));
+    overlaps = XMVectorAndInt(overlaps, XMVectorAndInt(XMVectorLessOrEqual(aMinY, bMaxY), XMVectorGreater(aMaxY, bMinY)));
+    overlaps = XMVectorAndInt(overlaps, XMVectorAndInt(XMVectorLess(aMinZ, bMaxZ), XMVectorGreater(aMaxZ, bMinZ)));
+
+    // most blocks miss entirely
+    if (XMVector4EqualInt(overlaps, none))
+      continue;
+
+    auto depthOf = [half](XMVECTOR aSize, XMVECTOR aCenter, XMVECTOR bMin, XMVECTOR bMax) {
+      const XMVECTOR sizes = XMVectorAdd(aSize, XMVectorSubtract(bMax, bMin));
+      const XMVECTOR distance = XMVectorAbs(XMVectorSubtract(aCenter, XMVectorAdd(bMin, bMax)));
+      return XMVectorMultiply(XMVectorSubtract(sizes, distance), half);
+    };
+
+    const XMVECTOR depthX = depthOf(aSizeX, aCenterX, bMinX, bMaxX);
+    const XMVECTOR depthY = depthOf(aSizeY, aCenterY, bMinY, bMaxY);
+    const XMVECTOR depthZ = depthOf(aSizeZ, aCenterZ, bMinZ, bMaxZ);
+
+    // the smallest depth wins, ties go to the earlier axis
+    const XMVECTOR useY = XMVectorLess(depthY, depthX);
+    XMVECTOR depth = XMVectorSelect(depthX, depthY, useY);
+    XMVECTOR axis = XMVectorSelect(XMVectorZero(), axisY, useY);
+
+    const XMVECTOR useZ = XMVectorLess(depthZ, depth);
+    depth = XMVectorSelect(depth, depthZ, useZ);
+    axis = XMVectorSelect(axis, axisZ, useZ);
+
+    std::uint32_t laneHits[Width];
+    XMFLOAT4 laneDepth, laneAxis;
+    XMStoreInt4(laneHits, overlaps);
+    XMStoreFloat4(&laneDepth, depth);
+    XMStoreFloat4(&laneAxis, axis);
+
+    const float* depths = &laneDepth.x;
+    const float* axes = &laneAxis.x;
+    for (int lane = 0; lane < Width; ++lane)
+    {
+      if (laneHits[lane])
+      {
+        hits.push_back({ i + lane, { depths[lane], (int)axes[lane] } });
+      }
+    }
+  }
+}
+
+void World::BoxBatch::overlapScalar(const float min[3], const float max[3], std::vector<Hit>& hits) const
+{
+  float otherMin[3], otherMax[3];
+  Penetration penetration;
+
+  for (int i = 0; i < count; ++i)
+  {
+    get(i, otherMin, otherMax);
+    if (Overlap(min, max, otherMin, otherMax, penetration))
+    {
+      hits.push_back({ i, penetration });
+    }
+  }
+}
@@ -0,0 +1,68 @@
+/*
+/
+// filename: BoxBatch.h
+// author: Callen Betts
+// brief: defines a structure of arrays set of boxes and the kernel that tests a box against it
+//
+// description: Each bound is split per axis into six arrays, so one vector register holds the same bound of four
+//  boxes. The kernel tests one box against four boxes per instruction and works out the penetration depth and
+//  axis of every overlap in the same pass, so resolving a collision doesn't have to rebuild the boxes.
+//
+//  Like the transform batch the math goes through DirectXMath, which compiles to SSE2 or AVX depending on the
+//  build's instruction set and to plain scalar code with _XM_NO_INTRINSICS_. The arrays are padded with empty
+//  boxes up to a multiple of four, and an empty box never overlaps anything.
+/
+*/
+
+#pragma once
+
+namespace World
+{
+
+  // how far two boxes push into each other along the axis they overlap the least on
+  struct Penetration
+  {
+    float depth = 0;
+    int axis = 0; // 0, 1 or 2 for x, y or z
+  };
+
+  class BoxBatch
+  {
+
+  public:
+
+    // boxes tested per vector register
+    static constexpr int Width = 4;
+
+    struct Hit
+    {
+      int index;
+      Penetration penetration;
+    };
+
+    // the overlap test the narrowphase has always used; y touching at the top counts, x and z must cross
+    static bool Overlap(const float minA[3], const float maxA[3], const float minB[3], const float maxB[3], Penetration& penetration);
+
+    void clear();
+    // add a box, returns its index
+    int add(const float min[3], const float max[3]);
+    // copy a box out of another batch, returns its index here
+    int add(const BoxBatch& other, int index);
+    void get(int index, float min[3], float max[3]) const;
+    int getCount() const { return count; }
+
+    // every box overlapping the given one, in index order
+    void overlap(const float min[3], const float max[3], std::vector<Hit>& hits) const;
+    // the same results one box at a time
+    void overlapScalar(const float min[3], const float max[3], std::vector<Hit>& hits) const;
+
+  private:
+
+    // one array per bound and axis, padded to a multiple of Width
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+    int count = 0;
+
+  };
+
+}
@@ -0,0 +1,110 @@
+/*
+/
+// filename: BoxBatchBenchmark.cpp
+// author: Callen Betts
+// brief: measures the box batch kernel against testing collider pairs one at a time
+//
+// description: Box colliders are scattered through a cube sized so each one overlaps a few others. A set of them
+//  is tested against every collider three ways: through BoxCollider::isAABBColliding one pair at a time, through
+//  the batch's scalar path, and through the vector kernel. Throughput is reported in millions of pair tests per
+//  second, and all three have to find the same overlaps. "-benchmark BoxBatch 10000" tests against 10k colliders.
+/
+*/
+
+#include "stdafx.h"
+#include "BoxBatch.h"
+#include "Engine/Entity/Entity.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+
+namespace
+{
+  constexpr int Queries = 1000;
+  constexpr float SpacePerCollider = 16.f; // cubic units of world per collider
+
+  double PairsPerSecond(long long pairs, double milliseconds)
+  {
+    return milliseconds > 0 ? pairs / (milliseconds * 1000.0) : 0;
+  }
+
+  void BoxBatchBenchmark(int count)
+  {
+    std::mt19937 random(1234);
+    const float extent = std::cbrt(count * SpacePerCollider);
+    std::uniform_real_distribution<float> position(0.f, extent);
+    std::uniform_real_distribution<float> size(1.f, 3.f);
+
+    std::vector<Entities::Entity*> entities;
+    World::BoxBatch batch;
+    float min[3], max[3];
+
+    for (int i = 0; i < count; ++i)
+    {
+      Entities::Entity* entity = new Entities::Entity();
+      entity->addComponent(new Components::Transform({ position(random), position(random), position(random) }, { 1.f, 1.f, 1.f }, { 0.f, 0.f, 0.f }));
+      entity->addComponent(new Components::BoxCollider({ size(random), size(random), size(random) }, true, false));
+      entities.push_back(entity);
+
+      entity->get<Components::Collider>()->getBounds(min, max);
+      batch.add(min, max);
+    }
+
+    const int queries = (std::min)(Queries, count);
+    const long long pairs = (long long)queries * count;
+
+    // one pair at a time through the collider
+    Benchmark::Stopwatch timer;
+    long long pairHits = 0;
+    for (int q = 0; q < queries; ++q)
+    {
+      Components::Collider* collider = entities[q]->get<Components::Collider>();
+      for (Entities::Entity* other : entities)
+      {
+        pairHits += collider->isColliding(other->get<Components::Collider>());
+      }
+    }
+    const double pairTime = timer.elapsed();
+
+    std::vector<World::BoxBatch::Hit> hits;
+
+    timer.start();
+    long long scalarHits = 0;
+    for (int q = 0; q < queries; ++q)
+    {
+      hits.clear();
+      batch.get(q, min, max);
+      batch.overlapScalar(min, max, hits);
+      scalarHits += hits.size();
+    }
+    const double scalarTime = timer.elapsed();
+
+    timer.start();
+    long long kernelHits = 0;
+    for (int q = 0; q < queries; ++q)
+    {
+      hits.clear();
+      batch.get(q, min, max);
+      batch.overlap(min, max, hits);
+      kernelHits += hits.size();
+    }
+    const double kernelTime = timer.elapsed();
+
+    const std::string label = std::to_string(queries) + " x " + std::to_string(count) + " pairs, ";
+    Benchmark::Report("BoxBatch", label + "collider pairs", PairsPerSecond(pairs, pairTime), "M tests/s");
+    Benchmark::Report("BoxBatch", label + "batch scalar", PairsPerSecond(pairs, scalarTime), "M tests/s");
+    Benchmark::Report("BoxBatch", label + "batch kernel", PairsPerSecond(pairs, kernelTime), "M tests/s");
+    Benchmark::Report("BoxBatch", label + "kernel speedup over pairs", kernelTime > 0 ? pairTime / kernelTime : 0, "x");
+    Benchmark::Report("BoxBatch", label + "overlaps", (double)kernelHits, "");
+
+    if (pairHits != scalarHits || pairHits != kernelHits)
+    {
+      Logger::error("BoxBatch overlaps don't match: pairs " + std::to_string(pairHits) + ", scalar " + std::to_string(scalarHits) + ", kernel " + std::to_string(kernelHits));
+    }
+
+    for (Entities::Entity* entity : entities)
+    {
+      delete entity;
+    }
+  }
+}
+
+REGISTER_BENCHMARK(BoxBatch, BoxBatchBenchmark);
@@ -0,0 +1,139 @@
+/*
+/
+// filename: CollisionLayers.cpp
+// author: Callen Betts
+// brief: implements CollisionLayers.h
+/
+*/
+
+#include "stdafx.h"
+#include "CollisionLayers.h"
+
+World::CollisionLayers::CollisionLayers()
+{
+  names.push_back("Default");
+  std::fill(matrix, matrix + MaxLayers, AllLayers);
+
+  // a project without a saved matrix has one layer that collides with everything
+  std::ifstream file("Data/CollisionLayers.json");
+  if (file.is_open())
+  {
+    file.close();
+    load();
+  }
+}
+
+World::CollisionFilter World::CollisionLayers::filter(int layer, std::uint32_t mask) const
+{
+  layer = std::clamp(layer, 0, MaxLayers - 1);
+  return { 1u << layer, mask & matrix[layer] };
+}
+
+bool World::CollisionLayers::canCollide(int a, int b) const
+{
+  if (a < 0 || b < 0 || a >= MaxLayers || b >= MaxLayers)
+    return false;
+
+  return (matrix[a] >> b) & 1u;
+}
+
+void World::CollisionLayers::setCanCollide(int a, int b, bool collide)
+{
+  if (a < 0 || b < 0 || a >= MaxLayers || b >= MaxLayers)
+    return;
+
+  if (collide)
+  {
+    matrix[a] |= 1u << b;
+    matrix[b] |= 1u << a;
+  }
+  else
+  {
+    matrix[a] &= ~(1u << b);
+    matrix[b] &= ~(1u << a);
+  }
+}
+
+const std::string& World::CollisionLayers::getName(int layer) const
+{
+  static const std::string unnamed = "Unnamed";
+  return (layer >= 0 && layer < (int)names.size()) ? names[layer] : unnamed;
+}
+
+void World::CollisionLayers::setName(int layer, const std::string& name)
+{
+  if (layer >= 0 && layer < (int)names.size())
+  {
+    names[layer] = name;
+  }
+}
+
+int World::CollisionLayers::addLayer(const std::string& name)
+{
+  if ((int)names.size() >= MaxLayers)
+  {
+    Logger::error("Can't add collision layer " + name + ", all " + std::to_string(MaxLayers) + " are in use");
+    return -1;
+  }
+
+  const int layer = (int)names.size();
+  names.push_back(name);
+
+  for (int other = 0; other < MaxLayers; ++other)
+  {
+    setCanCollide(layer, other, true);
+  }
+
+  return layer;
+}
+
+bool World::CollisionLayers::load(const std::string& filePath)
+{
+  std::ifstream file(filePath);
+  if (!file.is_open())
+  {
+    Logger::write("Failed to find collision layers " + filePath);
+    return false;
+  }
+
+  nlohmann::json data;
+  file >> data;
+
+  if (data.contains("Layers") && data["Layers"].is_array() && !data["Layers"].empty())
+  {
+    names.clear();
+    for (const auto& name : data["Layers"])
+    {
+      if ((int)names.size() < MaxLayers)
+        names.push_back(name.get<std::string>());
+    }
+  }
+
+  if (data.contains("Matrix") && data["Matrix"].is_array())
+  {
+    int layer = 0;
+    for (const auto& row : data["Matrix"])
+    {
+      if (layer >= MaxLayers)
+        break;
+
+      matrix[layer++] = row.get<std::uint32_t>();
+    }
+  }
+
+  Logger::write("Loaded " + std::to_string(names.size()) + " collision layers from " + filePath);
+  return true;
+}
+
+void World::CollisionLayers::save(const std::string& filePath) const
+{
+  nlohmann::json data;
+  data["Layers"] = names;
+  data["Matrix"] = std::vector<std::uint32_t>(matrix, matrix + MaxLayers);
+
+  std::ofstream file(filePath);
+  file << data.dump(4);
+  file.close();
+
+  Logger::write("Saved collision layers to " + filePath);
+}
@@ -0,0 +1,70 @@
+/*
+/
+// filename: CollisionLayers.h
+// author: Callen Betts
+// brief: defines the project's collision layers and which of them collide with each other
+//
+// description: Every collider sits on one layer and has a mask of the layers it wants to touch. The project keeps
+//  a name for each layer in use and a symmetric matrix of which layers can collide at all, saved next to the
+//  scenes so every scene shares it. A collider's layer, its own mask and its layer's row of the matrix are folded
+//  into a filter, so the broadphase can reject a pair (the player and a decorative mushroom) with two ANDs
+//  before looking at either box.
+/
+*/
+
+#pragma once
+#include <cstdint>
+
+namespace World
+{
+
+  // the bits the broadphase compares; two colliders can touch only if each is on a layer the other collides with
+  struct CollisionFilter
+  {
+    std::uint32_t layers = ~0u;
+    std::uint32_t collidesWith = ~0u;
+
+    bool accepts(const CollisionFilter& other) const { return (layers & other.collidesWith) && (other.layers & collidesWith); }
+  };
+
+  class CollisionLayers
+  {
+
+  public:
+
+    static CollisionLayers& instance() {
+      static CollisionLayers layers;
+      return layers;
+    }
+
+    // layers fit in one bit each of a mask
+    static constexpr int MaxLayers = 32;
+    static constexpr std::uint32_t AllLayers = ~0u;
+
+    // the filter of a collider on a layer with its own mask
+    CollisionFilter filter(int layer, std::uint32_t mask) const;
+
+    bool canCollide(int a, int b) const;
+    // change whether two layers collide, both directions at once
+    void setCanCollide(int a, int b, bool collide);
+
+    // layers in use, named "Default" and whatever the project adds after it
+    int getCount() const { return (int)names.size(); }
+    const std::string& getName(int layer) const;
+    void setName(int layer, const std::string& name);
+    // add a layer that collides with everything, returns its index or -1 when every bit is taken
+    int addLayer(const std::string& name);
+
+    bool load(const std::string& filePath = "Data/CollisionLayers.json");
+    void save(const std::string& filePath = "Data/CollisionLayers.json") const;
+
+  private:
+
+    CollisionLayers();
+
+    std::vector<std::string> names;
+    std::uint32_t matrix[MaxLayers]; // row per layer, bit set for every layer it collides with
+
+  };
+
+}
@@ -0,0 +1,176 @@
+/*
+/
+// filename: ContactBenchmark.cpp
+// author: Callen Betts
+// brief: measures the contact cache against tracking contacts in a set per collider
+//
+// description: Every frame keeps most of last frame's touching pairs, drops the rest and adds new ones, with each
+//  pair reported from both sides like two moving colliders would. The cache turns that into began, stayed and
+//  ended pairs. The comparison gives every collider a std::set of the colliders it touches and works out the
+//  same events from it, the way colliders tracked contacts before the cache. Both have to agree on the number of
+//  each event. "-benchmark Contacts 100000" runs with 100k touching pairs.
+/
+*/
+
+#include "stdafx.h"
+#include "ContactCache.h"
+#include "Engine/Entity/Entity.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+#include <set>
+
+namespace
+{
+  constexpr int Frames = 30;
+  constexpr int KeepPercent = 80;
+
+  using Pair = std::pair<int, int>;
+
+  struct Events
+  {
+    long long began = 0;
+    long long stayed = 0;
+    long long ended = 0;
+
+    bool operator==(const Events& other) const { return began == other.began && stayed == other.stayed && ended == other.ended; }
+  };
+
+  // the touching pairs for every frame, made up front so both sides time only their own work
+  std::vector<std::vector<Pair>> MakeFrames(int pairs, int entities, std::mt19937& random)
+  {
+    std::uniform_int_distribution<int> pick(0, entities - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    std::vector<std::vector<Pair>> frames(Frames);
+    std::vector<Pair> touching;
+
+    for (std::vector<Pair>& frame : frames)
+    {
+      std::vector<Pair> next;
+      for (const Pair& pair : touching)
+      {
+        if (percent(random) < KeepPercent)
+          next.push_back(pair);
+      }
+
+      while ((int)next.size() < pairs)
+      {
+        const int a = pick(random);
+        const int b = pick(random);
+        if (a != b)
+          next.push_back({ a, b });
+      }
+
+      touching = next;
+      frame = std::move(next);
+    }
+
+    return frames;
+  }
+
+  Events RunCache(const std::vector<std::vector<Pair>>& frames, std::vector<Entities::Entity*>& entities, double& time)
+  {
+    World::ContactCache cache;
+    Events events;
+
+    Benchmark::Stopwatch timer;
+    for (const std::vector<Pair>& frame : frames)
+    {
+      for (const Pair& pair : frame)
+      {
+        cache.touch(entities[pair.first], entities[pair.second]);
+        cache.touch(entities[pair.second], entities[pair.first]);
+      }
+      cache.update();
+
+      events.began += cache.getBegan().size();
+      events.stayed += cache.getStayed().size();
+      events.ended += cache.getEnded().size();
+    }
+    time = timer.elapsed();
+
+    return events;
+  }
+
+  Events RunSets(const std::vector<std::vector<Pair>>& frames, int entityCount, double& time)
+  {
+    std::vector<std::set<int>> touching(entityCount);
+    std::vector<std::set<int>> touchedThisFrame(entityCount);
+    Events events;
+
+    Benchmark::Stopwatch timer;
+    for (const std::vector<Pair>& frame : frames)
+    {
+      for (const Pair& pair : frame)
+      {
+        touchedThisFrame[pair.first].insert(pair.second);
+        touchedThisFrame[pair.second].insert(pair.first);
+      }
+
+      // each pair is in both colliders' sets, count it from the lower one
+      for (int i = 0; i < entityCount; ++i)
+      {
+        for (int other : touchedThisFrame[i])
+        {
+          if (other > i)
+            (touching[i].count(other) ? events.stayed : events.began)++;
+        }
+
+        for (int other : touching[i])
+        {
+          if (other > i && !touchedThisFrame[i].count(other))
+            events.ended++;
+        }
+      }
+
+      touching.swap(touchedThisFrame);
+      for (std::set<int>& set : touchedThisFrame)
+      {
+        set.clear();
+      }
+    }
+    time = timer.elapsed();
+
+    return events;
+  }
+
+  void ContactBenchmark(int count)
+  {
+    const int entityCount = (std::max)(count, 2);
+
+    std::mt19937 random(1234);
+    std::vector<std::vector<Pair>> frames = MakeFrames(count, entityCount, random);
+
+    // the cache only reads handles, so bare entities are enough
+    std::vector<Entities::Entity*> entities;
+    entities.reserve(entityCount);
+    for (int i = 0; i < entityCount; ++i)
+    {
+      entities.push_back(new Entities::Entity());
+    }
+
+    double cacheTime = 0, setTime = 0;
+    const Events cached = RunCache(frames, entities, cacheTime);
+    const Events sets = RunSets(frames, entityCount, setTime);
+
+    const std::string label = std::to_string(count) + " pairs, ";
+    Benchmark::Report("Contacts", label + "contact cache", cacheTime / Frames, "ms/frame");
+    Benchmark::Report("Contacts", label + "set per collider", setTime / Frames, "ms/frame");
+    Benchmark::Report("Contacts", label + "speedup", cacheTime > 0 ? setTime / cacheTime : 0, "x");
+    Benchmark::Report("Contacts", label + "began", (double)cached.began / Frames, "per frame");
+    Benchmark::Report("Contacts", label + "ended", (double)cached.ended / Frames, "per frame");
+
+    if (!(cached == sets))
+    {
+      Logger::error("Contact cache events don't match the sets: began " + std::to_string(cached.began) + "/" + std::to_string(sets.began)
+        + ", stayed " + std::to_string(cached.stayed) + "/" + std::to_string(sets.stayed)
+        + ", ended " + std::to_string(cached.ended) + "/" + std::to_string(sets.ended));
+    }
+
+    for (Entities::Entity* entity : entities)
+    {
+      delete entity;
+    }
+  }
+}
+
+REGISTER_BENCHMARK(Contacts, ContactBenchmark);
@@ -0,0 +1,168 @@
+/*
+/
+// filename: ContactCache.cpp
+// author: Callen Betts
+// brief: implements ContactCache.h
+/
+*/
+
+#include "stdafx.h"
+#include "ContactCache.h"
+#include "Engine/Entity/Entity.h"
+
+namespace
+{
+  constexpr size_t StartCapacity = 64;
+
+  // slot indices that sit next to each other shouldn't land in neighbouring buckets
+  size_t Hash(std::uint64_t key)
+  {
+    const std::uint64_t mixed = key * 0x9E3779B97F4A7C15ull;
+    return (size_t)(mixed ^ (mixed >> 32));
+  }
+}
+
+World::ContactCache::ContactCache()
+{
+  slots.resize(StartCapacity);
+}
+
+void World::ContactCache::touch(const Entities::Entity* a, const Entities::Entity* b, const Penetration& penetration)
+{
+  Entities::EntityHandle first = a->getHandle();
+  Entities::EntityHandle second = b->getHandle();
+
+  if (first.index == second.index)
+    return;
+
+  if (first.index > second.index)
+    std::swap(first, second);
+
+  const std::uint64_t key = (static_cast<std::uint64_t>(first.index) << 32) | second.index;
+
+  // keep at least half the table empty so probes stay short
+  if ((count + removed + 1) * 2 > (int)slots.size())
+  {
+    rehash((count + 1) * 4 > (int)slots.size() ? slots.size() * 2 : slots.size());
+  }
+
+  const size_t mask = slots.size() - 1;
+  size_t index = Hash(key) & mask;
+  size_t reuse = slots.size();
+
+  while (slots[index].key != Empty)
+  {
+    Slot& slot = slots[index];
+
+    if (slot.key == key)
+    {
+      // an entity died and its slot was reused before the old pair had a chance to end
+      if (slot.first != first || slot.second != second)
+      {
+        replaced.push_back({ slot.first, slot.second, slot.penetration });
+        slot.first = first;
+        slot.second = second;
+        slot.start = frame;
+      }
+
+      slot.penetration = penetration;
+      slot.touched = frame;
+      return;
+    }
+
+    if (slot.key == Removed && reuse == slots.size())
+    {
+      reuse = index;
+    }
+
+    index = (index + 1) & mask;
+  }
+
+  if (reuse != slots.size())
+  {
+    index = reuse;
+    removed--;
+  }
+
+  Slot& slot = slots[index];
+  slot.key = key;
+  slot.first = first;
+  slot.second = second;
+  slot.penetration = penetration;
+  slot.touched = frame;
+  slot.start = frame;
+  count++;
+}
+
+void World::ContactCache::update()
+{
+  update(nullptr);
+}
+
+void World::ContactCache::update(const std::function<bool(const Contact&)>& keep)
+{
+  began.clear();
+  stayed.clear();
+  kept.clear();
+  ended.swap(replaced);
+  replaced.clear();
+
+  for (Slot& slot : slots)
+  {
+    if (slot.key == Empty || slot.key == Removed)
+      continue;
+
+    if (slot.touched == frame)
+    {
+      (slot.start == frame ? began : stayed).push_back({ slot.first, slot.second, slot.penetration });
+      continue;
+    }
+
+    const Contact contact = { slot.first, slot.second, slot.penetration };
+    if (keep && keep(contact))
+    {
+      kept.push_back(contact);
+      continue;
+    }
+
+    ended.push_back(contact);
+    slot.key = Removed;
+    count--;
+    removed++;
+  }
+
+  frame++;
+}
+
+void World::ContactCache::clear()
+{
+  slots.assign(StartCapacity, Slot());
+  count = 0;
+  removed = 0;
+  began.clear();
+  stayed.clear();
+  ended.clear();
+  kept.clear();
+  replaced.clear();
+}
+
+void World::ContactCache::rehash(size_t capacity)
+{
+  std::vector<Slot> old(capacity);
+  old.swap(slots);
+  removed = 0;
+
+  const size_t mask = slots.size() - 1;
+  for (const Slot& slot : old)
+  {
+    if (slot.key == Empty || slot.key == Removed)
+      continue;
+
+    size_t index = Hash(slot.key) & mask;
+    while (slots[index].key != Empty)
+    {
+      index = (index + 1) & mask;
+    }
+    slots[index] = slot;
+  }
+}
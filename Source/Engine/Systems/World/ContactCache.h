@@ -0,0 +1,89 @@
+/*
+/
+// filename: ContactCache.h
+// author: Callen Betts
+// brief: defines the table of touching collider pairs that turns each frame's contacts into events
+//
+// description: The narrowphase reports every pair it finds touching, in any order and as many times as it likes.
+//  Pairs are keyed by their two registry slots, lowest first, in one flat open addressed table, and stamped with
+//  the frame they were last touched on. After the narrowphase one pass over the table sorts every pair into
+//  began (new this frame), stayed (touched last frame too) or ended (not touched this frame), and drops the ended
+//  ones. Each collider can be in any number of pairs, so a body resting on two boxes leaves each one separately.
+//  Pairs between bodies that have gone to sleep aren't looked for, so the caller can keep an untouched pair
+//  without any event until one of its bodies wakes up and touches it again or lets it end.
+/
+*/
+
+#pragma once
+#include "Engine/Entity/EntityHandle.h"
+#include "BoxBatch.h"
+#include <functional>
+
+namespace World
+{
+
+  // two entities whose colliders touch, the one in the lower registry slot first
+  struct Contact
+  {
+    Entities::EntityHandle first;
+    Entities::EntityHandle second;
+    Penetration penetration;
+  };
+
+  class ContactCache
+  {
+
+  public:
+
+    ContactCache();
+
+    // record that two entities are touching this frame and how far they overlap
+    void touch(const Entities::Entity* a, const Entities::Entity* b, const Penetration& penetration = Penetration());
+    // sort the pairs into began, stayed and ended, pairs not touched since the last update end and are removed
+    void update();
+    // same, but untouched pairs the predicate accepts are kept quietly instead of ending
+    void update(const std::function<bool(const Contact&)>& keep);
+    void clear();
+
+    const std::vector<Contact>& getBegan() const { return began; }
+    const std::vector<Contact>& getStayed() const { return stayed; }
+    const std::vector<Contact>& getEnded() const { return ended; }
+    // untouched pairs that were kept by the last update
+    const std::vector<Contact>& getKept() const { return kept; }
+
+    // touching pairs in the table
+    int getCount() const { return count; }
+    int getCapacity() const { return (int)slots.size(); }
+
+  private:
+
+    static constexpr std::uint64_t Empty = ~0ull;
+    static constexpr std::uint64_t Removed = ~0ull - 1;
+
+    struct Slot
+    {
+      std::uint64_t key = Empty;
+      Entities::EntityHandle first;
+      Entities::EntityHandle second;
+      Penetration penetration;
+      std::uint32_t touched = 0; // frame the pair was last touched on
+      std::uint32_t start = 0; // frame the pair began on
+    };
+
+    // move every pair into a table of a new size, dropping removed slots
+    void rehash(size_t capacity);
+
+    std::vector<Slot> slots; // size is always a power of two
+    int count = 0;
+    int removed = 0;
+    std::uint32_t frame = 1;
+
+    std::vector<Contact> began;
+    std::vector<Contact> stayed;
+    std::vector<Contact> ended;
+    std::vector<Contact> kept;
+    std::vector<Contact> replaced; // pairs whose slot was reused by a new entity before they ended
+
+  };
+
+}
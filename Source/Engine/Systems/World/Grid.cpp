@@ -1,10 +1,337 @@
 /*
 /
-// filename: stub.cpp
+// filename: Grid.cpp
 // author: Callen Betts
-// brief: implements stub.h
+// brief: implements Grid.h
 /
 */
 
 #include "stdafx.h"
-#include "stub.h"
\ No newline at end of file
+#include "Grid.h"
+#include "Engine/Entity/Entity.h"
+#include <cmath>
+
+namespace
+{
+  // cell coordinates are packed into 21 bits each
+  constexpr int CellLimit = (1 << 20) - 1;
+}
+
+World::Grid::Grid(float cellSize)
+{
+  setCellSize(cellSize);
+}
+
+void World::Grid::setCellSize(float size)
+{
+  if (size <= 0)
+  {
+    Logger::error("Grid cell size must be positive, got " + std::to_string(size));
+    return;
+  }
+
+  cellSize = size;
+  inverseCellSize = 1.0f / size;
+
+  cells.clear();
+  large.clear();
+
+  for (Proxy& proxy : proxies)
+  {
+    setCells(proxy);
+    link(proxy, proxy.handle.index);
+  }
+}
+
+float World::Grid::FitCellSize(std::vector<float> widths, float fallback)
+{
+  if (widths.empty())
+    return fallback;
+
+  // the few big boxes don't drag the cells up for the many small ones
+  auto median = widths.begin() + widths.size() / 2;
+  std::nth_element(widths.begin(), median, widths.end());
+
+  return *median > 0 ? *median * 2.0f : fallback;
+}
+
+void World::Grid::update(Entities::Entity* entity, const float min[3], const float max[3], const CollisionFilter& filter)
+{
+  const Entities::EntityHandle handle = entity->getHandle();
+  Proxy* proxy = find(handle.index);
+
+  // the slot was reused by a new entity before the old proxy was swept
+  if (proxy && proxy->handle != handle)
+  {
+    removeSlot(handle.index);
+    proxy = nullptr;
+  }
+
+  if (!proxy)
+  {
+    Proxy created = {};
+    created.entity = entity;
+    created.handle = handle;
+    std::copy(min, min + 3, created.min);
+    std::copy(max, max + 3, created.max);
+    created.filter = filter;
+    created.seen = sweep;
+    setCells(created);
+    link(created, handle.index);
+
+    if (handle.index >= proxyOf.size())
+    {
+      proxyOf.resize(handle.index + 1, Entities::EntityHandle::InvalidIndex);
+    }
+    proxyOf[handle.index] = (std::uint32_t)proxies.size();
+    proxies.push_back(created);
+    return;
+  }
+
+  proxy->entity = entity;
+  proxy->filter = filter;
+  proxy->seen = sweep;
+  std::copy(min, min + 3, proxy->min);
+  std::copy(max, max + 3, proxy->max);
+
+  // moving inside the same cells only changes the box
+  Proxy moved = *proxy;
+  setCells(moved);
+
+  if (std::equal(moved.cellMin, moved.cellMin + 3, proxy->cellMin) && std::equal(moved.cellMax, moved.cellMax + 3, proxy->cellMax))
+    return;
+
+  unlink(*proxy, handle.index);
+  *proxy = moved;
+  link(*proxy, handle.index);
+}
+
+void World::Grid::remove(Entities::Entity* entity)
+{
+  const Entities::EntityHandle handle = entity->getHandle();
+  Proxy* proxy = find(handle.index);
+
+  if (proxy && proxy->handle == handle)
+  {
+    removeSlot(handle.index);
+  }
+}
+
+void World::Grid::removeStale()
+{
+  // walk backwards so the proxy swapped into a removed one's place was already checked
+  for (size_t i = proxies.size(); i-- > 0;)
+  {
+    if (proxies[i].seen != sweep)
+    {
+      removeSlot(proxies[i].handle.index);
+    }
+  }
+
+  sweep++;
+}
+
+bool World::Grid::contains(const Entities::Entity* entity) const
+{
+  const Entities::EntityHandle handle = entity->getHandle();
+
+  if (handle.index >= proxyOf.size() || proxyOf[handle.index] == Entities::EntityHandle::InvalidIndex)
+    return false;
+
+  return proxies[proxyOf[handle.index]].handle == handle;
+}
+
+void World::Grid::query(const Entities::Entity* entity, std::vector<Entities::Entity*>& candidates)
+{
+  if (!contains(entity))
+    return;
+
+  const std::uint32_t self = entity->getHandle().index;
+  const Proxy& proxy = proxies[proxyOf[self]];
+
+  // a proxy spanning several cells meets the same neighbor more than once, the stamp reports it only once
+  if (visited.size() < proxyOf.size())
+  {
+    visited.resize(proxyOf.size(), 0);
+  }
+
+  if (++queryStamp == 0)
+  {
+    std::fill(visited.begin(), visited.end(), 0);
+    queryStamp = 1;
+  }
+
+  visited[self] = queryStamp;
+
+  auto visit = [&](std::uint32_t slot) {
+    if (visited[slot] == queryStamp)
+      return;
+
+    visited[slot] = queryStamp;
+
+    // layers that never collide are rejected before the boxes are looked at
+    const Proxy& other = proxies[proxyOf[slot]];
+    if (proxy.filter.accepts(other.filter) && overlaps(proxy, other))
+    {
+      candidates.push_back(other.entity);
+    }
+  };
+
+  if (proxy.isLarge)
+  {
+    // a large proxy would walk more cells than there are proxies nearby, so test every proxy
+    for (const Proxy& other : proxies)
+    {
+      visit(other.handle.index);
+    }
+    return;
+  }
+
+  for (int x = proxy.cellMin[0]; x <= proxy.cellMax[0]; ++x)
+  {
+    for (int y = proxy.cellMin[1]; y <= proxy.cellMax[1]; ++y)
+    {
+      for (int z = proxy.cellMin[2]; z <= proxy.cellMax[2]; ++z)
+      {
+        auto cell = cells.find(key(x, y, z));
+        if (cell == cells.end())
+          continue;
+
+        for (std::uint32_t slot : cell->second)
+        {
+          visit(slot);
+        }
+      }
+    }
+  }
+
+  for (std::uint32_t slot : large)
+  {
+    visit(slot);
+  }
+}
+
+void World::Grid::clear()
+{
+  proxies.clear();
+  proxyOf.clear();
+  cells.clear();
+  large.clear();
+  visited.clear();
+}
+
+int World::Grid::cellOf(float value) const
+{
+  float cell = std::floor(value * inverseCellSize);
+  return (int)std::clamp(cell, (float)-CellLimit, (float)CellLimit);
+}
+
+std::uint64_t World::Grid::key(int x, int y, int z)
+{
+  const std::uint64_t mask = 0x1FFFFF;
+  return ((std::uint64_t(x) & mask) << 42) | ((std::uint64_t(y) & mask) << 21) | (std::uint64_t(z) & mask);
+}
+
+void World::Grid::link(const Proxy& proxy, std::uint32_t slot)
+{
+  if (proxy.isLarge)
+  {
+    large.push_back(slot);
+    return;
+  }
+
+  for (int x = proxy.cellMin[0]; x <= proxy.cellMax[0]; ++x)
+  {
+    for (int y = proxy.cellMin[1]; y <= proxy.cellMax[1]; ++y)
+    {
+      for (int z = proxy.cellMin[2]; z <= proxy.cellMax[2]; ++z)
+      {
+        cells[key(x, y, z)].push_back(slot);
+      }
+    }
+  }
+}
+
+void World::Grid::unlink(const Proxy& proxy, std::uint32_t slot)
+{
+  // order inside a cell doesn't matter, so swap the last slot into the gap
+  auto erase = [slot](std::vector<std::uint32_t>& slots) {
+    auto it = std::find(slots.begin(), slots.end(), slot);
+    if (it != slots.end())
+    {
+      *it = slots.back();
+      slots.pop_back();
+    }
+  };
+
+  if (proxy.isLarge)
+  {
+    erase(large);
+    return;
+  }
+
+  for (int x = proxy.cellMin[0]; x <= proxy.cellMax[0]; ++x)
+  {
+    for (int y = proxy.cellMin[1]; y <= proxy.cellMax[1]; ++y)
+    {
+      for (int z = proxy.cellMin[2]; z <= proxy.cellMax[2]; ++z)
+      {
+        auto cell = cells.find(key(x, y, z));
+        if (cell == cells.end())
+          continue;
+
+        erase(cell->second);
+
+        // drop empty cells so the map only holds occupied space
+        if (cell->second.empty())
+        {
+          cells.erase(cell);
+        }
+      }
+    }
+  }
+}
+
+void World::Grid::setCells(Proxy& proxy)
+{
+  std::int64_t count = 1;
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    proxy.cellMin[axis] = cellOf(proxy.min[axis]);
+    proxy.cellMax[axis] = (std::max)(cellOf(proxy.max[axis]), proxy.cellMin[axis]);
+    count *= std::int64_t(proxy.cellMax[axis]) - proxy.cellMin[axis] + 1;
+  }
+
+  proxy.isLarge = count > MaxCellsPerProxy;
+}
+
+World::Grid::Proxy* World::Grid::find(std::uint32_t slot)
+{
+  if (slot >= proxyOf.size() || proxyOf[slot] == Entities::EntityHandle::InvalidIndex)
+    return nullptr;
+
+  return &proxies[proxyOf[slot]];
+}
+
+void World::Grid::removeSlot(std::uint32_t slot)
+{
+  const std::uint32_t index = proxyOf[slot];
+  unlink(proxies[index], slot);
+
+  // fill the gap with the last proxy
+  const std::uint32_t lastSlot = proxies.back().handle.index;
+  proxies[index] = proxies.back();
+  proxyOf[lastSlot] = index;
+
+  proxies.pop_back();
+  proxyOf[slot] = Entities::EntityHandle::InvalidIndex;
+}
+
+bool World::Grid::overlaps(const Proxy& a, const Proxy& b)
+{
+  // touching counts, the narrowphase makes the final call
+  return a.min[0] <= b.max[0] && a.max[0] >= b.min[0]
+    && a.min[1] <= b.max[1] && a.max[1] >= b.min[1]
+    && a.min[2] <= b.max[2] && a.max[2] >= b.min[2];
+}
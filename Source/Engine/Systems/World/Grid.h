@@ -7,12 +7,21 @@
 */
 
 /* desc:
-* The world is split up into a grid. Each grid cell has its own entity lists of colliders and entities.
-* Each scene has its own container of grid cells, with a maximum amount cells depending on the world size.
-* This means far less comparisons; however, we cannot have objects larger than the grid size
+* The world is split up into a grid of uniform cells. Each collider is a proxy holding its box, and every cell its
+* box touches holds the proxy. Cells are hashed from their coordinates, so the world has no fixed size and empty
+* cells cost nothing. Finding what a collider might touch only looks at the cells it covers, which means far less
+* comparisons than testing every collider against every other one.
+*
+* Moving a proxy only touches the cell lists when the range of cells it covers changes. Proxies that would cover
+* too many cells are kept in a separate list that every query checks instead. Scenes keep the grid for colliders
+* that move, so the cells are sized to those (see FitCellSize) and baked level geometry is found through the
+* scene's static tree rather than sitting in that list.
 */
 
 #pragma once
+#include "Engine/Entity/EntityHandle.h"
+#include "CollisionLayers.h"
+#include <unordered_map>
 
 namespace World
 {
@@ -22,9 +31,78 @@ namespace World
 
   public:
 
+    // proxies covering more cells than this are kept out of the cells
+    static constexpr int MaxCellsPerProxy = 64;
+
+    Grid(float cellSize = 4.0f);
+
+    // change the size of a cell, every proxy is re-inserted
+    void setCellSize(float size);
+    // a cell size for boxes of these widths: twice the median, so a typical box covers one to eight cells; the
+    // fallback when there are none
+    static float FitCellSize(std::vector<float> widths, float fallback);
+    float getCellSize() const { return cellSize; }
+
+    // insert an entity's box or move it; marks the proxy as seen for removeStale
+    void update(Entities::Entity* entity, const float min[3], const float max[3], const CollisionFilter& filter = CollisionFilter());
+    // take an entity out of the grid
+    void remove(Entities::Entity* entity);
+    // remove every proxy that wasn't updated since the last call, e.g. entities that were deleted or lost their collider
+    void removeStale();
+    bool contains(const Entities::Entity* entity) const;
+
+    // add every entity whose box overlaps the entity's box to candidates, the entity itself and entities on layers
+    // it doesn't collide with excluded
+    void query(const Entities::Entity* entity, std::vector<Entities::Entity*>& candidates);
+
+    void clear();
+
+    int getProxyCount() const { return (int)proxies.size(); }
+    int getCellCount() const { return (int)cells.size(); }
+    int getLargeCount() const { return (int)large.size(); }
 
   private:
 
+    struct Proxy
+    {
+      Entities::Entity* entity;
+      Entities::EntityHandle handle;
+      float min[3];
+      float max[3];
+      CollisionFilter filter;
+      int cellMin[3];
+      int cellMax[3];
+      bool isLarge; // in the large list rather than the cells
+      std::uint32_t seen; // the sweep the proxy was last updated in
+    };
+
+    // the cell a coordinate falls in
+    int cellOf(float value) const;
+    // pack cell coordinates into a hash key
+    static std::uint64_t key(int x, int y, int z);
+
+    // add or remove a proxy's slot to or from the cells it covers
+    void link(const Proxy& proxy, std::uint32_t slot);
+    void unlink(const Proxy& proxy, std::uint32_t slot);
+    void setCells(Proxy& proxy);
+
+    Proxy* find(std::uint32_t slot);
+    void removeSlot(std::uint32_t slot);
+
+    static bool overlaps(const Proxy& a, const Proxy& b);
+
+    float cellSize;
+    float inverseCellSize;
+
+    std::vector<Proxy> proxies;
+    std::vector<std::uint32_t> proxyOf; // registry slot to index in proxies
+
+    std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> cells; // cell key to registry slots
+    std::vector<std::uint32_t> large; // registry slots of proxies too big for the cells
+
+    std::vector<std::uint32_t> visited; // registry slot to the query that last reported it
+    std::uint32_t queryStamp = 0;
+    std::uint32_t sweep = 1;
 
   };
-}
\ No newline at end of file
+}
@@ -0,0 +1,183 @@
+/*
+/
+// filename: GridBenchmark.cpp
+// author: Callen Betts
+// brief: measures how the grid broadphase scales against testing every pair
+//
+// description: Box colliders are scattered through a cube that grows with their count, so the density stays the
+//  same, and a tenth of them move every frame. Each size runs the scene's collision step: update the grid, query
+//  it for every moving collider and run the box narrowphase on what it finds. The old step, every moving collider
+//  against every collider, runs alongside up to 20k colliders; past that it takes minutes. Sizes go from 1k up by
+//  ten times to the given count, so "-benchmark Grid 100000" runs 1k, 10k and 100k.
+/
+*/
+
+#include "stdafx.h"
+#include "Grid.h"
+#include "Engine/Entity/Entity.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+
+namespace
+{
+  constexpr int Frames = 10;
+  constexpr int BruteForceLimit = 20000;
+  constexpr float SpacePerCollider = 64.f; // cubic units of world per collider
+
+  struct Scatter
+  {
+    std::vector<Entities::Entity*> all;
+    std::vector<Entities::Entity*> moving;
+  };
+
+  Scatter Spawn(int count, std::mt19937& random)
+  {
+    const float extent = std::cbrt(count * SpacePerCollider);
+    std::uniform_real_distribution<float> position(0.f, extent);
+    std::uniform_real_distribution<float> size(1.f, 3.f);
+
+    Scatter scatter;
+    scatter.all.reserve(count);
+
+    for (int i = 0; i < count; ++i)
+    {
+      const bool isMoving = i % 10 == 0;
+
+      Entities::Entity* entity = new Entities::Entity();
+      entity->addComponent(new Components::Transform({ position(random), position(random), position(random) }, { 1.f, 1.f, 1.f }, { 0.f, 0.f, 0.f }));
+      entity->addComponent(new Components::BoxCollider({ size(random), size(random), size(random) }, !isMoving, false));
+
+      scatter.all.push_back(entity);
+      if (isMoving)
+      {
+        scatter.moving.push_back(entity);
+      }
+    }
+
+    return scatter;
+  }
+
+  void Move(Scatter& scatter, std::mt19937& random)
+  {
+    std::uniform_real_distribution<float> step(-0.5f, 0.5f);
+
+    for (Entities::Entity* entity : scatter.moving)
+    {
+      Vector3D position = entity->transform->getPosition();
+      entity->transform->setPosition({ position.x + step(random), position.y + step(random), position.z + step(random) });
+    }
+  }
+
+  // returns the number of touching pairs found
+  int GridStep(World::Grid& grid, Scatter& scatter, std::vector<Entities::Entity*>& candidates, double& updateTime, double& queryTime)
+  {
+    Benchmark::Stopwatch timer;
+    float min[3], max[3];
+    for (Entities::Entity* entity : scatter.all)
+    {
+      entity->get<Components::Collider>()->getBounds(min, max);
+      grid.update(entity, min, max);
+    }
+    grid.removeStale();
+    updateTime += timer.elapsed();
+
+    timer.start();
+    int contacts = 0;
+    for (Entities::Entity* entity : scatter.moving)
+    {
+      Components::Collider* collider = entity->get<Components::Collider>();
+
+      candidates.clear();
+      grid.query(entity, candidates);
+
+      for (Entities::Entity* other : candidates)
+      {
+        contacts += collider->isColliding(other->get<Components::Collider>());
+      }
+    }
+    queryTime += timer.elapsed();
+
+    return contacts;
+  }
+
+  int BruteForceStep(Scatter& scatter, double& time)
+  {
+    Benchmark::Stopwatch timer;
+    int contacts = 0;
+    for (Entities::Entity* entity : scatter.moving)
+    {
+      Components::Collider* collider = entity->get<Components::Collider>();
+
+      for (Entities::Entity* other : scatter.all)
+      {
+        if (other != entity)
+        {
+          contacts += collider->isColliding(other->get<Components::Collider>());
+        }
+      }
+    }
+    time += timer.elapsed();
+
+    return contacts;
+  }
+
+  void RunSize(int count)
+  {
+    std::mt19937 random(1234);
+    Scatter scatter = Spawn(count, random);
+
+    World::Grid grid;
+    std::vector<Entities::Entity*> candidates;
+
+    const bool bruteForce = count <= BruteForceLimit;
+    double updateTime = 0, queryTime = 0, bruteTime = 0;
+    long long gridContacts = 0, bruteContacts = 0;
+
+    for (int frame = 0; frame < Frames; ++frame)
+    {
+      Move(scatter, random);
+
+      gridContacts += GridStep(grid, scatter, candidates, updateTime, queryTime);
+
+      if (bruteForce)
+      {
+        bruteContacts += BruteForceStep(scatter, bruteTime);
+      }
+    }
+
+    const std::string label = std::to_string(count) + " colliders, ";
+    const double gridTime = (updateTime + queryTime) / Frames;
+
+    Benchmark::Report("Grid", label + "grid update", updateTime / Frames, "ms/frame");
+    Benchmark::Report("Grid", label + "grid query + narrowphase", queryTime / Frames, "ms/frame");
+    Benchmark::Report("Grid", label + "grid total", gridTime, "ms/frame");
+    Benchmark::Report("Grid", label + "occupied cells", grid.getCellCount(), "");
+    Benchmark::Report("Grid", label + "contacts per frame", (double)gridContacts / Frames, "");
+
+    if (bruteForce)
+    {
+      Benchmark::Report("Grid", label + "every pair", bruteTime / Frames, "ms/frame");
+      Benchmark::Report("Grid", label + "speedup over every pair", gridTime > 0 ? (bruteTime / Frames) / gridTime : 0, "x");
+
+      // the broadphase can't lose a contact the narrowphase would have found
+      if (gridContacts != bruteContacts)
+      {
+        Logger::error("Grid found " + std::to_string(gridContacts) + " contacts, every pair found " + std::to_string(bruteContacts));
+      }
+    }
+
+    for (Entities::Entity* entity : scatter.all)
+    {
+      delete entity;
+    }
+  }
+
+  void GridBenchmark(int count)
+  {
+    for (int size = 1000; size <= count; size *= 10)
+    {
+      RunSize(size);
+    }
+  }
+}
+
+REGISTER_BENCHMARK(Grid, GridBenchmark);
@@ -0,0 +1,134 @@
+/*
+/
+// filename: Islands.cpp
+// author: Callen Betts
+// brief: implements Islands.h
+/
+*/
+
+#include "stdafx.h"
+#include "Islands.h"
+#include "Engine/Entity/Entity.h"
+
+namespace
+{
+  Components::Physics* PhysicsOf(const Entities::EntityHandle& handle)
+  {
+    Entities::Entity* entity = handle.get();
+    return entity ? entity->get<Components::Physics>() : nullptr;
+  }
+}
+
+void World::Islands::update(const std::vector<Entities::Entity*>& bodies, const ContactCache& contacts)
+{
+  // whatever was holding a body up may be gone
+  for (const Contact& contact : contacts.getEnded())
+  {
+    for (const Entities::EntityHandle& handle : { contact.first, contact.second })
+    {
+      Components::Physics* physics = PhysicsOf(handle);
+      if (physics)
+        physics->wake();
+    }
+  }
+
+  const int bodyCount = (int)bodies.size();
+  parents.resize(bodyCount);
+
+  for (int i = 0; i < bodyCount; ++i)
+  {
+    parents[i] = i;
+
+    const std::uint32_t slot = bodies[i]->getHandle().index;
+    if (slot >= bodyOf.size())
+    {
+      bodyOf.resize(slot + 1, -1);
+    }
+
+    // anchored bodies hold things up like the floor does, they don't tie what rests on them together
+    bodyOf[slot] = bodies[i]->get<Components::Physics>()->isAnchored() ? -1 : i;
+  }
+
+  // sleeping pairs aren't touched, the cache kept them for us instead
+  for (const std::vector<Contact>* touching : { &contacts.getBegan(), &contacts.getStayed(), &contacts.getKept() })
+  {
+    for (const Contact& contact : *touching)
+    {
+      join(bodies, contact);
+    }
+  }
+
+  moving.assign(bodyCount, 0);
+  for (int i = 0; i < bodyCount; ++i)
+  {
+    Components::Physics* physics = bodies[i]->get<Components::Physics>();
+    if (!physics->isAnchored() && !physics->isSleeping() && !physics->isRestful())
+    {
+      moving[find(i)] = 1;
+    }
+  }
+
+  count = 0;
+  sleepingCount = 0;
+  for (int i = 0; i < bodyCount; ++i)
+  {
+    Components::Physics* physics = bodies[i]->get<Components::Physics>();
+    if (physics->isAnchored())
+      continue;
+
+    const int island = find(i);
+
+    if (moving[island])
+    {
+      physics->wake();
+    }
+    else
+    {
+      physics->sleep();
+    }
+
+    count += island == i;
+    sleepingCount += physics->isSleeping();
+  }
+}
+
+void World::Islands::clear()
+{
+  parents.clear();
+  bodyOf.clear();
+  moving.clear();
+  count = 0;
+  sleepingCount = 0;
+}
+
+int World::Islands::find(int body)
+{
+  while (parents[body] != body)
+  {
+    parents[body] = parents[parents[body]];
+    body = parents[body];
+  }
+
+  return body;
+}
+
+void World::Islands::join(const std::vector<Entities::Entity*>& bodies, const Contact& contact)
+{
+  if (contact.first.index >= bodyOf.size() || contact.second.index >= bodyOf.size())
+    return;
+
+  const int a = bodyOf[contact.first.index];
+  const int b = bodyOf[contact.second.index];
+  const int bodyCount = (int)bodies.size();
+
+  // either side may be static, or have died and left its slot to an entity without a body
+  if (a < 0 || b < 0 || a >= bodyCount || b >= bodyCount || bodies[a]->getHandle() != contact.first || bodies[b]->getHandle() != contact.second)
+    return;
+
+  const int islandA = find(a);
+  const int islandB = find(b);
+  if (islandA != islandB)
+  {
+    parents[islandB] = islandA;
+  }
+}
@@ -0,0 +1,50 @@
+/*
+/
+// filename: Islands.h
+// author: Callen Betts
+// brief: defines the groups of touching bodies that fall asleep and wake up together
+//
+// description: Every frame the bodies are joined along the contacts between them into islands, a stack of crates
+//  being one island and a crate alone on the floor another. Anchored bodies and static colliders don't join
+//  anything, so two crates on the same floor stay apart. An island falls asleep once every body in it has been
+//  resting for a while, and wakes as a whole when any of its bodies starts moving again, which is also how a
+//  moving body wakes up whatever it runs into. A body that loses a contact is woken in case it lost its support.
+/
+*/
+
+#pragma once
+#include "ContactCache.h"
+
+namespace World
+{
+
+  class Islands
+  {
+
+  public:
+
+    // join bodies with physics along this frame's contacts, then put islands to sleep or wake them
+    void update(const std::vector<Entities::Entity*>& bodies, const ContactCache& contacts);
+    void clear();
+
+    // islands and sleeping bodies found by the last update
+    int getCount() const { return count; }
+    int getBodyCount() const { return (int)parents.size(); }
+    int getSleepingCount() const { return sleepingCount; }
+
+  private:
+
+    // the first body of a body's island, halving the path on the way up
+    int find(int body);
+    void join(const std::vector<Entities::Entity*>& bodies, const Contact& contact);
+
+    std::vector<int> parents; // per body, another body in its island or itself if it's the first one
+    std::vector<int> bodyOf; // registry slot to body index, -1 for slots without a body that joins islands
+    std::vector<std::uint8_t> moving; // per first body, if any body in the island is awake and not resting
+
+    int count = 0;
+    int sleepingCount = 0;
+
+  };
+
+}
@@ -0,0 +1,126 @@
+/*
+/
+// filename: Narrowphase.cpp
+// author: Callen Betts
+// brief: implements Narrowphase.h
+/
+*/
+
+#include "stdafx.h"
+#include "Narrowphase.h"
+#include "Engine/Entity/Entity.h"
+#include "Engine/Systems/Jobs/JobSystem.h"
+#include <algorithm>
+
+namespace
+{
+  // movers per job; each one is a handful of candidates, so a range needs a few dozen to be worth a job
+  constexpr int MinMovers = 32;
+}
+
+void World::Narrowphase::clear()
+{
+  bounds.clear();
+  movers.clear();
+  candidates.clear();
+  touching.clear();
+}
+
+void World::Narrowphase::addBox(Entities::Entity* entity, const float min[3], const float max[3])
+{
+  const std::uint32_t slot = entity->getHandle().index;
+  if (slot >= boundsOf.size())
+  {
+    boundsOf.resize(slot + 1);
+  }
+  boundsOf[slot] = bounds.add(min, max);
+}
+
+void World::Narrowphase::addMover(Entities::Entity* entity, const std::vector<Entities::Entity*>& nearby)
+{
+  movers.push_back({ entity, (int)candidates.size(), (int)nearby.size() });
+  candidates.insert(candidates.end(), nearby.begin(), nearby.end());
+}
+
+void World::Narrowphase::run(Jobs::JobSystem* jobs)
+{
+  const int count = (int)movers.size();
+  touching.clear();
+
+  if (count == 0)
+    return;
+
+  // fixed ranges, so each knows which buffer is its own from where it starts
+  const int threads = jobs ? jobs->getThreadCount() : 1;
+  const int grain = (std::max)(MinMovers, count / (threads * 4));
+  const int rangeCount = (count + grain - 1) / grain;
+
+  if ((int)ranges.size() < rangeCount)
+  {
+    ranges.resize(rangeCount);
+  }
+
+  auto testRange = [this, grain](int begin, int end) { test(ranges[begin / grain], begin, end); };
+  if (jobs)
+  {
+    jobs->parallelFor(count, grain, testRange);
+  }
+  else
+  {
+    for (int begin = 0; begin < count; begin += grain)
+    {
+      testRange(begin, (std::min)(count, begin + grain));
+    }
+  }
+
+  // a single threaded job system runs the whole list as one range, so join whatever each range found
+  for (int i = 0; i < rangeCount; ++i)
+  {
+    touching.insert(touching.end(), ranges[i].found.begin(), ranges[i].found.end());
+    ranges[i].found.clear();
+  }
+
+  std::sort(touching.begin(), touching.end(), [](const Touch& a, const Touch& b) {
+    if (a.pair != b.pair)
+      return a.pair < b.pair;
+    return a.mover->getHandle().index < b.mover->getHandle().index;
+  });
+}
+
+std::uint64_t World::Narrowphase::PairOf(const Entities::Entity* a, const Entities::Entity* b)
+{
+  std::uint64_t first = a->getHandle().index;
+  std::uint64_t second = b->getHandle().index;
+
+  if (first > second)
+    std::swap(first, second);
+
+  return (first << 32) | second;
+}
+
+void World::Narrowphase::test(Range& range, int begin, int end)
+{
+  float min[3], max[3];
+
+  for (int i = begin; i < end; ++i)
+  {
+    const Mover& mover = movers[i];
+    Entities::Entity* const* nearby = candidates.data() + mover.first;
+
+    range.nearby.clear();
+    for (int c = 0; c < mover.count; ++c)
+    {
+      range.nearby.add(bounds, boundsOf[nearby[c]->getHandle().index]);
+    }
+
+    range.hits.clear();
+    bounds.get(boundsOf[mover.entity->getHandle().index], min, max);
+    range.nearby.overlap(min, max, range.hits);
+
+    for (const BoxBatch::Hit& hit : range.hits)
+    {
+      Entities::Entity* other = nearby[hit.index];
+      range.found.push_back({ PairOf(mover.entity, other), mover.entity, other, hit.penetration });
+    }
+  }
+}
@@ -0,0 +1,91 @@
+/*
+/
+// filename: Narrowphase.h
+// author: Callen Betts
+// brief: defines the box tests between moving colliders and the candidates the broadphase found for them
+//
+// description: The scene hands over every collider's box for the frame and, for each moving collider, the list
+//  of candidates the grid found near it. The movers are split into ranges that the job system tests at the same
+//  time, each range gathering its candidates' boxes into a batch of its own and writing what it finds into a
+//  buffer of its own, so no two threads ever write the same memory. The buffers are then joined and sorted by
+//  pair, which makes the touching list the same no matter how many threads ran or which range finished first.
+/
+*/
+
+#pragma once
+#include "BoxBatch.h"
+
+namespace Entities
+{
+  class Entity;
+}
+
+namespace Jobs
+{
+  class JobSystem;
+}
+
+namespace World
+{
+
+  // a mover and a candidate whose boxes overlap
+  struct Touch
+  {
+    std::uint64_t pair; // lower registry slot in the high half, the other in the low half
+    Entities::Entity* mover;
+    Entities::Entity* other;
+    Penetration penetration;
+  };
+
+  class Narrowphase
+  {
+
+  public:
+
+    // forget last frame's boxes and movers
+    void clear();
+    // a collider's box this frame; every candidate handed to addMover needs one
+    void addBox(Entities::Entity* entity, const float min[3], const float max[3]);
+    // a moving collider, which needs a box too, and the entities near it
+    void addMover(Entities::Entity* entity, const std::vector<Entities::Entity*>& nearby);
+
+    // test every mover against its candidates, over the job system when one is given
+    void run(Jobs::JobSystem* jobs = nullptr);
+
+    // every overlap the last run found, ordered by pair and then by mover; two movers touching are in it twice
+    const std::vector<Touch>& getTouching() const { return touching; }
+    int getMoverCount() const { return (int)movers.size(); }
+    int getCandidateCount() const { return (int)candidates.size(); }
+
+    // the pair id two entities share whichever way round they are
+    static std::uint64_t PairOf(const Entities::Entity* a, const Entities::Entity* b);
+
+  private:
+
+    struct Mover
+    {
+      Entities::Entity* entity;
+      int first; // index of the mover's first candidate
+      int count;
+    };
+
+    // what one range of movers needs to itself
+    struct Range
+    {
+      BoxBatch nearby;
+      std::vector<BoxBatch::Hit> hits;
+      std::vector<Touch> found;
+    };
+
+    void test(Range& range, int begin, int end);
+
+    BoxBatch bounds;
+    std::vector<int> boundsOf; // registry slot to index in bounds
+    std::vector<Mover> movers;
+    std::vector<Entities::Entity*> candidates; // every mover's candidates back to back
+    std::vector<Range> ranges;
+    std::vector<Touch> touching;
+
+  };
+
+}
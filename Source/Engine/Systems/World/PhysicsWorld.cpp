@@ -0,0 +1,374 @@
+/*
+/
+// filename: PhysicsWorld.cpp
+// author: Callen Betts
+// brief: implements PhysicsWorld.h
+/
+*/
+
+#include "stdafx.h"
+#include "PhysicsWorld.h"
+#include "SpatialIndex.h"
+#include "Engine/Entity/Entity.h"
+#include "Engine/Systems/Jobs/JobSystem.h"
+
+namespace
+{
+  // bodies per job; integrating one is a few multiplies, so ranges have to be long to be worth a job
+  constexpr int MinBodies = 1024;
+
+  template <typename T>
+  void SwapPop(std::vector<T>& values, int index)
+  {
+    values[index] = values.back();
+    values.pop_back();
+  }
+}
+
+World::PhysicsWorld::~PhysicsWorld()
+{
+  detachAll();
+}
+
+void World::PhysicsWorld::sync(const std::vector<Entities::Entity*>& bodies)
+{
+  stamp++;
+
+  for (Entities::Entity* entity : bodies)
+  {
+    Components::Physics* physics = entity->physics;
+    if (!physics)
+      continue;
+
+    int body = physics->world == this ? physics->body : attach(entity, physics);
+    seen[body] = stamp;
+  }
+
+  // back to front so swapping the last body in never skips one we haven't looked at
+  for (int body = getCount() - 1; body >= 0; --body)
+  {
+    if (seen[body] != stamp)
+    {
+      detach(body);
+    }
+  }
+}
+
+void World::PhysicsWorld::detachAll()
+{
+  for (int body = getCount() - 1; body >= 0; --body)
+  {
+    detach(body);
+  }
+}
+
+void World::PhysicsWorld::clear()
+{
+  for (std::vector<float>* values : { &velocityX, &velocityY, &velocityZ, &accelerationX, &accelerationY, &accelerationZ,
+    &gravity, &restTime, &sleepX, &sleepY, &sleepZ, &moveX, &moveY, &moveZ })
+  {
+    values->clear();
+  }
+
+  for (std::vector<std::uint8_t>* values : { &anchored, &grounded, &canSleep, &sleeping, &active })
+  {
+    values->clear();
+  }
+
+  entities.clear();
+  handles.clear();
+  seen.clear();
+  activeCount = 0;
+}
+
+void World::PhysicsWorld::step(float dt, const SpatialIndex* world, Jobs::JobSystem* jobs)
+{
+  const int count = getCount();
+
+  // the arrays are dense, so a body's fields for the whole step sit in a few cache lines across the arrays
+  auto run = [this, dt, world](int begin, int end) {
+    integrate(begin, end, dt);
+    move(begin, end, world);
+  };
+
+  if (jobs)
+  {
+    jobs->parallelFor(count, (std::max)(MinBodies, count / (jobs->getThreadCount() * 4)), run);
+  }
+  else
+  {
+    run(0, count);
+  }
+
+  activeCount = 0;
+  for (int body = 0; body < count; ++body)
+  {
+    activeCount += active[body];
+  }
+}
+
+World::BodyState World::PhysicsWorld::getState(int body) const
+{
+  BodyState state;
+  state.velocity = getVelocity(body);
+  state.acceleration = getAcceleration(body);
+  state.gravity = gravity[body];
+  state.anchored = anchored[body];
+  state.grounded = grounded[body];
+  state.canSleep = canSleep[body];
+  state.sleeping = sleeping[body];
+  state.restTime = restTime[body];
+  state.sleepPosition = { sleepX[body], sleepY[body], sleepZ[body] };
+  return state;
+}
+
+void World::PhysicsWorld::setVelocity(int body, const Vector3D& velocity)
+{
+  velocityX[body] = velocity.x;
+  velocityY[body] = velocity.y;
+  velocityZ[body] = velocity.z;
+}
+
+void World::PhysicsWorld::setAcceleration(int body, const Vector3D& acceleration)
+{
+  accelerationX[body] = acceleration.x;
+  accelerationY[body] = acceleration.y;
+  accelerationZ[body] = acceleration.z;
+}
+
+void World::PhysicsWorld::setCanSleep(int body, bool value)
+{
+  canSleep[body] = value;
+
+  if (!value)
+    wake(body);
+}
+
+void World::PhysicsWorld::sleep(int body)
+{
+  if (sleeping[body] || !canSleep[body])
+    return;
+
+  Components::Transform* transform = entities[body]->transform;
+  if (transform)
+  {
+    const Vector3D position = transform->getPosition();
+    sleepX[body] = position.x;
+    sleepY[body] = position.y;
+    sleepZ[body] = position.z;
+  }
+
+  // whatever drift was left would be added all at once when we wake
+  setVelocity(body, { 0,0,0 });
+  setAcceleration(body, { 0,0,0 });
+  sleeping[body] = true;
+}
+
+void World::PhysicsWorld::wake(int body)
+{
+  sleeping[body] = false;
+  restTime[body] = 0;
+}
+
+int World::PhysicsWorld::attach(Entities::Entity* entity, Components::Physics* physics)
+{
+  const BodyState& state = physics->state;
+  const int body = getCount();
+
+  entities.push_back(entity);
+  handles.push_back(entity->getHandle());
+  velocityX.push_back(state.velocity.x);
+  velocityY.push_back(state.velocity.y);
+  velocityZ.push_back(state.velocity.z);
+  accelerationX.push_back(state.acceleration.x);
+  accelerationY.push_back(state.acceleration.y);
+  accelerationZ.push_back(state.acceleration.z);
+  gravity.push_back(state.gravity);
+  restTime.push_back(state.restTime);
+  sleepX.push_back(state.sleepPosition.x);
+  sleepY.push_back(state.sleepPosition.y);
+  sleepZ.push_back(state.sleepPosition.z);
+  anchored.push_back(state.anchored);
+  grounded.push_back(state.grounded);
+  canSleep.push_back(state.canSleep);
+  sleeping.push_back(state.sleeping);
+  moveX.push_back(0);
+  moveY.push_back(0);
+  moveZ.push_back(0);
+  active.push_back(0);
+  seen.push_back(stamp);
+
+  physics->world = this;
+  physics->body = body;
+  return body;
+}
+
+void World::PhysicsWorld::detach(int body)
+{
+  // the entity may be gone, or have lost its physics component, in which case there's nobody to hand the state to
+  Entities::Entity* entity = handles[body].get();
+  Components::Physics* physics = entity ? entity->physics : nullptr;
+  if (physics && physics->world == this && physics->body == body)
+  {
+    physics->state = getState(body);
+    physics->world = nullptr;
+    physics->body = -1;
+  }
+
+  const int last = getCount() - 1;
+  if (body != last)
+  {
+    // the last body's entity may be gone too when everything is being detached
+    Entities::Entity* moved = handles[last].get();
+    if (moved && moved->physics && moved->physics->world == this)
+    {
+      moved->physics->body = body;
+    }
+  }
+
+  for (std::vector<float>* values : { &velocityX, &velocityY, &velocityZ, &accelerationX, &accelerationY, &accelerationZ,
+    &gravity, &restTime, &sleepX, &sleepY, &sleepZ, &moveX, &moveY, &moveZ })
+  {
+    SwapPop(*values, body);
+  }
+
+  for (std::vector<std::uint8_t>* values : { &anchored, &grounded, &canSleep, &sleeping, &active })
+  {
+    SwapPop(*values, body);
+  }
+
+  SwapPop(entities, body);
+  SwapPop(handles, body);
+  SwapPop(seen, body);
+}
+
+void World::PhysicsWorld::integrate(int begin, int end, float dt)
+{
+  for (int i = begin; i < end; ++i)
+  {
+    // anchored objects don't move, sleeping ones are checked for edits in move
+    active[i] = !anchored[i] && !sleeping[i];
+
+    // on the ground we stop falling, in the air gravity adds to the acceleration
+    const float air = grounded[i] ? 0.f : 1.f;
+    const float fallen = (accelerationY[i] - gravity[i] * dt) * air;
+
+    accelerationY[i] = active[i] ? fallen : accelerationY[i];
+    velocityY[i] = active[i] ? velocityY[i] * air : velocityY[i];
+
+    const float motionX = velocityX[i] + accelerationX[i];
+    const float motionY = velocityY[i] + accelerationY[i];
+    const float motionZ = velocityZ[i] + accelerationZ[i];
+
+    moveX[i] = motionX * dt;
+    moveY[i] = motionY * dt;
+    moveZ[i] = motionZ * dt;
+
+    // gravity keeps adding to the acceleration of anything not on the ground, so only resting bodies stay slow
+    const float speed = motionX * motionX + motionY * motionY + motionZ * motionZ;
+    const float rest = speed < SleepVelocity * SleepVelocity ? restTime[i] + dt : 0.f;
+    restTime[i] = active[i] ? rest : restTime[i];
+  }
+}
+
+void World::PhysicsWorld::move(int begin, int end, const SpatialIndex* world)
+{
+  for (int i = begin; i < end; ++i)
+  {
+    if (anchored[i])
+      continue;
+
+    Components::Transform* transform = entities[i]->transform;
+    if (!transform)
+      continue;
+
+    Vector3D position = transform->getPosition();
+
+    // something moved us while we slept, a script, the editor or a body resolving against us; we start next step
+    if (sleeping[i])
+    {
+      if (position.x != sleepX[i] || position.y != sleepY[i] || position.z != sleepZ[i])
+      {
+        wake(i);
+      }
+      continue;
+    }
+
+    if (world)
+    {
+      sweep(i, *world);
+    }
+
+    transform->setOldPosition(position);
+    transform->setPosition({ position.x + moveX[i], position.y + moveY[i], position.z + moveZ[i] });
+  }
+}
+
+void World::PhysicsWorld::sweep(int body, const SpatialIndex& world)
+{
+  Entities::Entity* entity = entities[body];
+  Components::Collider* collider = entity->get<Components::Collider>();
+  if (!collider)
+    return;
+
+  AABB box;
+  collider->getBounds(box.min, box.max);
+
+  // past half our size the narrowphase can push us out the far side of a thin collider, or miss it entirely
+  float remaining[3] = { moveX[body], moveY[body], moveZ[body] };
+  bool fast = false;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    fast |= std::abs(remaining[axis]) > (box.max[axis] - box.min[axis]) * 0.5f;
+  }
+
+  if (!fast)
+    return;
+
+  // every other body is moving on another thread right now, only static colliders we don't integrate hold still
+  // for us; a static flag on a body that isn't anchored doesn't stop it moving this step
+  const World::CollisionFilter filter = collider->getFilter();
+  const QueryFilter blocks = [this, entity, &filter](Entities::Entity* other) {
+    Components::Collider* otherCollider = other != entity ? other->get<Components::Collider>() : nullptr;
+    if (!otherCollider || !otherCollider->isStatic() || !filter.accepts(otherCollider->getFilter()))
+      return false;
+
+    const Components::Physics* physics = other->physics;
+    return !physics || physics->world != this || anchored[physics->body];
+  };
+
+  float moved[3] = { 0, 0, 0 };
+  float* velocity[3] = { &velocityX[body], &velocityY[body], &velocityZ[body] };
+  float* acceleration[3] = { &accelerationX[body], &accelerationY[body], &accelerationZ[body] };
+
+  for (int i = 0; i < MaxSweeps; ++i)
+  {
+    SweepHit hit;
+    if (!world.sweep(box, remaining, hit, blocks))
+    {
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        moved[axis] += remaining[axis];
+      }
+      break;
+    }
+
+    // advance to where we touch, then spend the rest of the step sliding along the face we hit
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const float advance = remaining[axis] * hit.time;
+      moved[axis] += advance;
+      box.min[axis] += advance;
+      box.max[axis] += advance;
+      remaining[axis] -= advance;
+    }
+
+    remaining[hit.axis] = 0;
+    *velocity[hit.axis] = 0;
+    *acceleration[hit.axis] = 0;
+  }
+
+  moveX[body] = moved[0];
+  moveY[body] = moved[1];
+  moveZ[body] = moved[2];
+}
@@ -0,0 +1,132 @@
+/*
+/
+// filename: PhysicsWorld.h
+// author: Callen Betts
+// brief: defines the store of rigid body state that integrates every body of a scene in one pass
+//
+// description: While the game runs, each body's velocity, acceleration, gravity and flags live here, one dense
+//  array per field, rather than in its Physics component. The component becomes a handle holding this world and
+//  its index, and every getter and setter reaches through it. A step first works out every active body's
+//  displacement straight down the arrays, then moves the transforms, sweeping the few that move fast through
+//  the spatial index. Bodies are split over the job system by range.
+//
+//  In the editor nothing is simulated, so the scene detaches every body and the state goes back into the
+//  components, where the inspector, saving and prefabs find it.
+/
+*/
+
+#pragma once
+#include "Engine/Entity/EntityHandle.h"
+#include <cstdint>
+
+namespace Jobs
+{
+  class JobSystem;
+}
+
+namespace Components
+{
+  class Physics;
+}
+
+namespace World
+{
+
+  class SpatialIndex;
+
+  // what a body holds, kept in its component while it isn't in a world
+  struct BodyState
+  {
+    Vector3D velocity;
+    Vector3D acceleration;
+    float gravity = 35.f;
+    bool anchored = false; // we can't move no matter what
+    bool grounded = false; // we are on the ground
+    bool canSleep = true;
+    bool sleeping = false;
+    float restTime = 0; // seconds we've been moving slower than SleepVelocity
+    Vector3D sleepPosition; // where we fell asleep, moving us from here wakes us up
+  };
+
+  class PhysicsWorld
+  {
+
+  public:
+
+    // a body moving slower than this for SleepDelay seconds is ready to sleep
+    static constexpr float SleepVelocity = 0.05f;
+    static constexpr float SleepDelay = 0.5f;
+    // a sweep can stop, slide and stop again this many times in one step
+    static constexpr int MaxSweeps = 3;
+
+    ~PhysicsWorld();
+
+    // take in every entity with physics that isn't here yet and let go of the ones that are gone
+    void sync(const std::vector<Entities::Entity*>& bodies);
+    // give every body's state back to its component and empty the world
+    void detachAll();
+    // forget every body without touching components, for when the entities are already gone
+    void clear();
+
+    // integrate every active body; bodies moving further than half their size sweep through world's static colliders
+    void step(float dt, const SpatialIndex* world = nullptr, Jobs::JobSystem* jobs = nullptr);
+
+    int getCount() const { return (int)entities.size(); }
+    // bodies that moved in the last step
+    int getActiveCount() const { return activeCount; }
+
+    BodyState getState(int body) const;
+
+    Vector3D getVelocity(int body) const { return { velocityX[body], velocityY[body], velocityZ[body] }; }
+    void setVelocity(int body, const Vector3D& velocity);
+    Vector3D getAcceleration(int body) const { return { accelerationX[body], accelerationY[body], accelerationZ[body] }; }
+    void setAcceleration(int body, const Vector3D& acceleration);
+    float getGravity(int body) const { return gravity[body]; }
+    void setGravity(int body, float value) { gravity[body] = value; }
+
+    bool isAnchored(int body) const { return anchored[body]; }
+    void setAnchored(int body, bool value) { anchored[body] = value; }
+    bool isGrounded(int body) const { return grounded[body]; }
+    void setGrounded(int body, bool value) { grounded[body] = value; }
+
+    bool isSleeping(int body) const { return sleeping[body]; }
+    bool isRestful(int body) const { return canSleep[body] && restTime[body] >= SleepDelay; }
+    bool getCanSleep(int body) const { return canSleep[body]; }
+    void setCanSleep(int body, bool value);
+    void sleep(int body);
+    void wake(int body);
+
+  private:
+
+    int attach(Entities::Entity* entity, Components::Physics* physics);
+    // swap the last body into the gap, handing the state back to the component if it is still around
+    void detach(int body);
+
+    // work out the displacement of a range of bodies from their velocity, acceleration and gravity
+    void integrate(int begin, int end, float dt);
+    // move the transforms of a range of bodies by their displacement
+    void move(int begin, int end, const SpatialIndex* world);
+    // how far a body's box gets along its displacement before static colliders stop it, sliding along whatever it hits
+    void sweep(int body, const SpatialIndex& world);
+
+    std::vector<Entities::Entity*> entities;
+    std::vector<Entities::EntityHandle> handles;
+
+    std::vector<float> velocityX, velocityY, velocityZ;
+    std::vector<float> accelerationX, accelerationY, accelerationZ;
+    std::vector<float> gravity;
+    std::vector<float> restTime;
+    std::vector<float> sleepX, sleepY, sleepZ;
+    std::vector<std::uint8_t> anchored, grounded, canSleep, sleeping;
+
+    // this step's displacement and whether the body takes part at all
+    std::vector<float> moveX, moveY, moveZ;
+    std::vector<std::uint8_t> active;
+
+    std::vector<std::uint32_t> seen; // the sync each body was last found in
+    std::uint32_t stamp = 0;
+    int activeCount = 0;
+
+  };
+
+}
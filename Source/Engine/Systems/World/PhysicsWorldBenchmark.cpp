@@ -0,0 +1,111 @@
+/*
+/
+// filename: PhysicsWorldBenchmark.cpp
+// author: Callen Betts
+// brief: measures integrating every body of a physics world on one thread against every thread
+//
+// description: Bodies are spread over a wide field, each one falling with its own sideways velocity so none of them
+//  settle and every one is integrated every step. The world is stepped on a single threaded job system and on one
+//  with every hardware thread, and the time to take the bodies in the first time is reported too since a scene
+//  pays it when play starts. Both runs start from the same positions and have to end in exactly the same place.
+//  "-benchmark PhysicsWorld 1000000" steps a million bodies.
+/
+*/
+
+#include "stdafx.h"
+#include "PhysicsWorld.h"
+#include "Engine/Entity/Entity.h"
+#include "Engine/Systems/Jobs/JobSystem.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+
+namespace
+{
+  constexpr int Steps = 60;
+  constexpr float Dt = 1.f / 60.f;
+  constexpr float Spacing = 2.f;
+
+  // put every body back where it started, moving
+  void Reset(const std::vector<Entities::Entity*>& bodies, int side)
+  {
+    for (int i = 0; i < (int)bodies.size(); ++i)
+    {
+      bodies[i]->transform->setPosition({ (i % side) * Spacing, 100.f, (i / side) * Spacing });
+
+      Components::Physics* body = bodies[i]->physics;
+      body->setAcceleration({ 0, 0, 0 });
+      body->setVelocity({ (i % 7) - 3.f, 0, (i % 5) - 2.f });
+    }
+  }
+
+  double Run(World::PhysicsWorld& physics, Jobs::JobSystem& jobs)
+  {
+    Benchmark::Stopwatch timer;
+    for (int step = 0; step < Steps; ++step)
+    {
+      physics.step(Dt, nullptr, &jobs);
+    }
+    return timer.elapsed() / Steps;
+  }
+
+  void PhysicsWorldBenchmark(int count)
+  {
+    const int side = (std::max)(1, (int)std::ceil(std::sqrt((float)count)));
+
+    std::vector<Entities::Entity*> bodies;
+    for (int i = 0; i < count; ++i)
+    {
+      Entities::Entity* body = new Entities::Entity();
+      body->addComponent(new Components::Transform({ 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f }, { 0.f, 0.f, 0.f }));
+      body->addComponent(new Components::Physics());
+      body->physics->setCanSleep(false);
+      bodies.push_back(body);
+    }
+
+    World::PhysicsWorld physics;
+    Benchmark::Stopwatch syncTimer;
+    physics.sync(bodies);
+    const double syncTime = syncTimer.elapsed();
+
+    Jobs::JobSystem single(1);
+    Reset(bodies, side);
+    const double singleTime = Run(physics, single);
+
+    std::vector<Vector3D> expected;
+    for (Entities::Entity* body : bodies)
+    {
+      expected.push_back(body->transform->getPosition());
+    }
+
+    Jobs::JobSystem jobs(0);
+    Reset(bodies, side);
+    const double jobsTime = Run(physics, jobs);
+
+    int mismatches = 0;
+    for (int i = 0; i < count; ++i)
+    {
+      const Vector3D position = bodies[i]->transform->getPosition();
+      mismatches += position.x != expected[i].x || position.y != expected[i].y || position.z != expected[i].z;
+    }
+
+    const std::string label = std::to_string(count) + " bodies, ";
+    Benchmark::Report("PhysicsWorld", label + "first sync", syncTime, "ms");
+    Benchmark::Report("PhysicsWorld", label + "1 thread", singleTime, "ms/step");
+    Benchmark::Report("PhysicsWorld", label + std::to_string(jobs.getThreadCount()) + " threads", jobsTime, "ms/step");
+    Benchmark::Report("PhysicsWorld", label + "speedup", jobsTime > 0 ? singleTime / jobsTime : 0, "x");
+    Benchmark::Report("PhysicsWorld", label + "active", (double)physics.getActiveCount(), "bodies");
+
+    if (mismatches)
+    {
+      Logger::error(std::to_string(mismatches) + " of " + std::to_string(count) + " bodies stepped on "
+        + std::to_string(jobs.getThreadCount()) + " threads ended somewhere else than on one thread");
+    }
+
+    physics.clear();
+    for (Entities::Entity* body : bodies)
+    {
+      delete body;
+    }
+  }
+}
+
+REGISTER_BENCHMARK(PhysicsWorld, PhysicsWorldBenchmark);
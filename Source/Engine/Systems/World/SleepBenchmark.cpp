@@ -0,0 +1,199 @@
+/*
+/
+// filename: SleepBenchmark.cpp
+// author: Callen Betts
+// brief: measures what a floor of settled crates costs with and without sleeping
+//
+// description: Crates are laid out two high on a static floor, each one pressed slightly into its neighbours so
+//  the whole floor is one island. Every frame runs the scene's physics and collision step: integrate the bodies,
+//  update the grid, look for contacts around every awake body, send the contact events and update the islands.
+//  Once the crates have settled the same frames are timed twice, once with sleeping switched off on every body
+//  and once with it on. "-benchmark Sleep 100000" runs with 100k crates.
+/
+*/
+
+#include "stdafx.h"
+#include "Grid.h"
+#include "Islands.h"
+#include "PhysicsWorld.h"
+#include "Engine/Entity/Entity.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+
+namespace
+{
+  constexpr int SettleFrames = 90;
+  constexpr int Frames = 60;
+  constexpr float Dt = 1.f / 60.f;
+  constexpr float Spacing = 0.99f; // crates are a unit wide, so neighbours overlap a little
+
+  struct Crates
+  {
+    std::vector<Entities::Entity*> all;
+    std::vector<Entities::Entity*> bodies;
+    World::Grid grid;
+    World::ContactCache contacts;
+    World::Islands islands;
+    World::PhysicsWorld physics;
+    std::vector<Entities::Entity*> candidates;
+  };
+
+  void Spawn(Crates& crates, int count, bool canSleep)
+  {
+    const int side = (std::max)(1, (int)std::ceil(std::sqrt(count / 2.f)));
+    const float extent = side * Spacing;
+
+    // the floor's top is at zero
+    Entities::Entity* floor = new Entities::Entity();
+    floor->addComponent(new Components::Transform({ extent * 0.5f, -0.5f, extent * 0.5f }, { 1.f, 1.f, 1.f }, { 0.f, 0.f, 0.f }));
+    floor->addComponent(new Components::BoxCollider({ extent + 2.f, 1.f, extent + 2.f }, true, false));
+    crates.all.push_back(floor);
+
+    for (int i = 0; i < count; ++i)
+    {
+      const int column = i / 2;
+      const float x = (column % side) * Spacing;
+      const float z = (column / side) * Spacing;
+      const float y = (i % 2) ? 1.48f : 0.49f;
+
+      Entities::Entity* crate = new Entities::Entity();
+      crate->addComponent(new Components::Transform({ x, y, z }, { 1.f, 1.f, 1.f }, { 0.f, 0.f, 0.f }));
+      crate->addComponent(new Components::BoxCollider({ 1.f, 1.f, 1.f }, false, false));
+
+      // configured before it's added, the entity owns it after that
+      Components::Physics* physics = new Components::Physics();
+      physics->setCanSleep(canSleep);
+      crate->addComponent(physics);
+
+      crates.all.push_back(crate);
+      crates.bodies.push_back(crate);
+    }
+
+    crates.physics.sync(crates.bodies);
+  }
+
+  bool IsIdle(const Entities::EntityHandle& handle)
+  {
+    Entities::Entity* entity = handle.get();
+    if (!entity)
+      return false;
+
+    Components::Physics* physics = entity->get<Components::Physics>();
+    return physics ? physics->isSleeping() : entity->get<Components::Collider>()->isStatic();
+  }
+
+  // the same step the scene runs, without the update pipeline or the transform matrices
+  void Step(Crates& crates)
+  {
+    crates.physics.step(Dt);
+
+    float min[3], max[3], otherMin[3], otherMax[3];
+    for (Entities::Entity* entity : crates.all)
+    {
+      entity->get<Components::Collider>()->getBounds(min, max);
+      crates.grid.update(entity, min, max);
+    }
+    crates.grid.removeStale();
+
+    for (Entities::Entity* body : crates.bodies)
+    {
+      if (body->get<Components::Physics>()->isSleeping())
+        continue;
+
+      crates.candidates.clear();
+      crates.grid.query(body, crates.candidates);
+      body->get<Components::Collider>()->getBounds(min, max);
+
+      for (Entities::Entity* other : crates.candidates)
+      {
+        World::Penetration penetration;
+        other->get<Components::Collider>()->getBounds(otherMin, otherMax);
+        if (World::BoxBatch::Overlap(min, max, otherMin, otherMax, penetration))
+        {
+          crates.contacts.touch(body, other, penetration);
+        }
+      }
+    }
+
+    crates.contacts.update([](const World::Contact& contact) { return IsIdle(contact.first) && IsIdle(contact.second); });
+
+    for (const World::Contact& contact : crates.contacts.getBegan())
+    {
+      contact.first.get()->get<Components::Collider>()->enterCollision(contact.second.get()->get<Components::Collider>());
+      contact.second.get()->get<Components::Collider>()->enterCollision(contact.first.get()->get<Components::Collider>());
+    }
+
+    for (const std::vector<World::Contact>* touching : { &crates.contacts.getBegan(), &crates.contacts.getStayed() })
+    {
+      for (const World::Contact& contact : *touching)
+      {
+        Components::Collider* first = contact.first.get()->get<Components::Collider>();
+        Components::Collider* second = contact.second.get()->get<Components::Collider>();
+        Components::Collider::ResolveContact(first, second);
+      }
+    }
+
+    for (const World::Contact& contact : crates.contacts.getEnded())
+    {
+      Components::Collider* first = contact.first.get()->get<Components::Collider>();
+      Components::Collider* second = contact.second.get()->get<Components::Collider>();
+      first->leaveCollision(second);
+      second->leaveCollision(first);
+    }
+
+    crates.islands.update(crates.bodies, crates.contacts);
+  }
+
+  // settle the crates, then time the frames after; returns ms per frame
+  double Run(int count, bool canSleep, int& sleeping, int& contacts)
+  {
+    Crates crates;
+    Spawn(crates, count, canSleep);
+
+    for (int frame = 0; frame < SettleFrames; ++frame)
+    {
+      Step(crates);
+    }
+
+    Benchmark::Stopwatch timer;
+    for (int frame = 0; frame < Frames; ++frame)
+    {
+      Step(crates);
+    }
+    const double time = timer.elapsed() / Frames;
+
+    sleeping = crates.islands.getSleepingCount();
+    contacts = crates.contacts.getCount();
+
+    crates.physics.clear();
+
+    for (Entities::Entity* entity : crates.all)
+    {
+      delete entity;
+    }
+
+    return time;
+  }
+
+  void SleepBenchmark(int count)
+  {
+    int sleeping = 0, contacts = 0;
+    const double awakeTime = Run(count, false, sleeping, contacts);
+    const int awakeContacts = contacts;
+    const double sleepTime = Run(count, true, sleeping, contacts);
+
+    const std::string label = std::to_string(count) + " crates, ";
+    Benchmark::Report("Sleep", label + "always awake", awakeTime, "ms/frame");
+    Benchmark::Report("Sleep", label + "sleeping", sleepTime, "ms/frame");
+    Benchmark::Report("Sleep", label + "speedup", sleepTime > 0 ? awakeTime / sleepTime : 0, "x");
+    Benchmark::Report("Sleep", label + "asleep", (double)sleeping, "bodies");
+
+    // sleeping pairs are kept rather than found, the crates should be touching the same things either way
+    if (sleeping != count || contacts != awakeContacts)
+    {
+      Logger::error("Settled crates didn't all sleep: " + std::to_string(sleeping) + " of " + std::to_string(count)
+        + " asleep, " + std::to_string(contacts) + " contacts against " + std::to_string(awakeContacts) + " awake");
+    }
+  }
+}
+
+REGISTER_BENCHMARK(Sleep, SleepBenchmark);
@@ -0,0 +1,201 @@
+/*
+/
+// filename: SpatialBenchmark.cpp
+// author: Callen Betts
+// brief: measures the spatial index's trees against scanning every entity
+//
+// description: Box colliders are scattered through a cube that grows with their count, and a tenth of them have
+//  physics so they go in the dynamic tree instead of being baked. Each size times the bake, random ray picks and
+//  nearest neighbour queries against a scan of every box, a few frames of moving the dynamic tenth and syncing,
+//  and the same rays cast as one batch on one thread and over the job system. The tree's hits are checked against
+//  the scan. Sizes go from 1k up by ten times to the given count, so "-benchmark Spatial 100000" runs 1k, 10k and
+//  100k.
+/
+*/
+
+#include "stdafx.h"
+#include "SpatialIndex.h"
+#include "Engine/Entity/Entity.h"
+#include "Engine/Entity/EntityList/QueryIndex.h"
+#include "Engine/Systems/Jobs/JobSystem.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+
+namespace
+{
+  constexpr int Frames = 10;
+  constexpr int Queries = 1000;
+  constexpr int Neighbors = 8;
+  constexpr float SpacePerEntity = 64.f; // cubic units of world per entity
+
+  std::vector<Entities::Entity*> Spawn(int count, float extent, std::mt19937& random)
+  {
+    std::uniform_real_distribution<float> position(0.f, extent);
+    std::uniform_real_distribution<float> size(1.f, 3.f);
+
+    std::vector<Entities::Entity*> entities;
+    entities.reserve(count);
+
+    for (int i = 0; i < count; ++i)
+    {
+      const bool isMoving = i % 10 == 0;
+
+      Entities::Entity* entity = new Entities::Entity();
+      entity->addComponent(new Components::Transform({ position(random), position(random), position(random) }, { 1.f, 1.f, 1.f }, { 0.f, 0.f, 0.f }));
+      entity->addComponent(new Components::BoxCollider({ size(random), size(random), size(random) }, !isMoving, false));
+      if (isMoving)
+      {
+        entity->addComponent(new Components::Physics());
+      }
+
+      entities.push_back(entity);
+    }
+
+    return entities;
+  }
+
+  // the closest box every ray hits, looking at every entity
+  World::RayHit ScanRaycast(const std::vector<Entities::Entity*>& entities, const World::Ray& ray)
+  {
+    World::RayHit hit;
+    World::AABB box;
+    float distance;
+
+    for (Entities::Entity* entity : entities)
+    {
+      World::SpatialIndex::GetBounds(entity, box);
+      if (box.raycast(ray, hit.distance, distance) && distance < hit.distance)
+      {
+        hit.entity = entity;
+        hit.distance = distance;
+      }
+    }
+
+    return hit;
+  }
+
+  void RunSize(int count)
+  {
+    std::mt19937 random(1234);
+    const float extent = std::cbrt(count * SpacePerEntity);
+
+    Entities::QueryIndex index;
+    std::vector<Entities::Entity*> entities = Spawn(count, extent, random);
+    for (Entities::Entity* entity : entities)
+    {
+      index.add(entity);
+    }
+    const Entities::QueryView& located = index.view(Entities::Query().with<Components::Transform>());
+    index.flush();
+
+    World::SpatialIndex spatial;
+    Benchmark::Stopwatch timer;
+    spatial.bake(located);
+    const double bakeTime = timer.elapsed();
+
+    // rays start anywhere in the cube and point anywhere
+    std::uniform_real_distribution<float> position(0.f, extent);
+    std::uniform_real_distribution<float> direction(-1.f, 1.f);
+    std::vector<World::Ray> rays;
+    std::vector<Vector3D> points;
+    rays.reserve(Queries);
+    for (int i = 0; i < Queries; ++i)
+    {
+      rays.emplace_back(Vector3D(position(random), position(random), position(random)), Vector3D(direction(random), direction(random), direction(random)));
+      points.push_back({ position(random), position(random), position(random) });
+    }
+
+    timer.start();
+    std::vector<World::RayHit> scanHits;
+    for (const World::Ray& ray : rays)
+    {
+      scanHits.push_back(ScanRaycast(entities, ray));
+    }
+    const double scanTime = timer.elapsed();
+
+    timer.start();
+    std::vector<World::RayHit> treeHits;
+    for (const World::Ray& ray : rays)
+    {
+      treeHits.push_back(spatial.raycast(ray));
+    }
+    const double treeTime = timer.elapsed();
+
+    // two boxes can tie, so compare the distance rather than the entity
+    int mismatches = 0;
+    for (int i = 0; i < Queries; ++i)
+    {
+      mismatches += (scanHits[i].entity == nullptr) != (treeHits[i].entity == nullptr) || scanHits[i].distance != treeHits[i].distance;
+    }
+
+    timer.start();
+    std::vector<World::Neighbor> nearest;
+    for (const Vector3D& point : points)
+    {
+      spatial.nearest(point, Neighbors, nearest);
+    }
+    const double nearestTime = timer.elapsed();
+
+    // move the dynamic tenth a little every frame
+    std::uniform_real_distribution<float> step(-0.5f, 0.5f);
+    double syncTime = 0;
+    int reinserts = 0;
+    for (int frame = 0; frame < Frames; ++frame)
+    {
+      for (int i = 0; i < count; i += 10)
+      {
+        Vector3D at = entities[i]->transform->getPosition();
+        entities[i]->transform->setPosition({ at.x + step(random), at.y + step(random), at.z + step(random) });
+      }
+
+      timer.start();
+      spatial.sync(located);
+      syncTime += timer.elapsed();
+      reinserts += spatial.getDynamicTree().getReinsertCount();
+    }
+
+    std::vector<World::RayHit> batchHits;
+    timer.start();
+    spatial.raycast(rays, batchHits);
+    const double batchTime = timer.elapsed();
+
+    Jobs::JobSystem jobs(0);
+    timer.start();
+    spatial.raycast(rays, batchHits, nullptr, &jobs);
+    const double jobsTime = timer.elapsed();
+
+    const std::string label = std::to_string(count) + " entities, ";
+    const std::string per = std::to_string(Queries) + " ";
+
+    Benchmark::Report("Spatial", label + "bake", bakeTime, "ms");
+    Benchmark::Report("Spatial", label + "static tree nodes", spatial.getStaticTree().getNodeCount(), "");
+    Benchmark::Report("Spatial", label + "dynamic tree height", spatial.getDynamicTree().getHeight(), "");
+    Benchmark::Report("Spatial", label + per + "rays, scan", scanTime, "ms");
+    Benchmark::Report("Spatial", label + per + "rays, trees", treeTime, "ms");
+    Benchmark::Report("Spatial", label + "ray speedup over scan", treeTime > 0 ? scanTime / treeTime : 0, "x");
+    Benchmark::Report("Spatial", label + per + std::to_string(Neighbors) + "-nearest", nearestTime, "ms");
+    Benchmark::Report("Spatial", label + "sync, 10% moving", syncTime / Frames, "ms/frame");
+    Benchmark::Report("Spatial", label + "reinserts", (double)reinserts / Frames, "per frame");
+    Benchmark::Report("Spatial", label + per + "rays batched, 1 thread", batchTime, "ms");
+    Benchmark::Report("Spatial", label + per + "rays batched, " + std::to_string(jobs.getThreadCount()) + " threads", jobsTime, "ms");
+
+    if (mismatches)
+    {
+      Logger::error("Spatial index disagreed with the scan on " + std::to_string(mismatches) + " of " + std::to_string(Queries) + " rays");
+    }
+
+    for (Entities::Entity* entity : entities)
+    {
+      delete entity;
+    }
+  }
+
+  void SpatialBenchmark(int count)
+  {
+    for (int size = 1000; size <= count; size *= 10)
+    {
+      RunSize(size);
+    }
+  }
+}
+
+REGISTER_BENCHMARK(Spatial, SpatialBenchmark);
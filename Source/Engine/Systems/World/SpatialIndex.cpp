@@ -0,0 +1,229 @@
+/*
+/
+// filename: SpatialIndex.cpp
+// author: Callen Betts
+// brief: implements SpatialIndex.h
+/
+*/
+
+#include "stdafx.h"
+#include "SpatialIndex.h"
+#include "Engine/Entity/Entity.h"
+#include "Engine/Entity/EntityList/QueryIndex.h"
+#include "Engine/Systems/Jobs/JobSystem.h"
+
+bool World::SpatialIndex::GetBounds(Entities::Entity* entity, AABB& box)
+{
+  Components::BoundingBox* boundingBox = entity->get<Components::BoundingBox>();
+
+  // a bounding box that was never computed is all zeros
+  if (boundingBox && !(boundingBox->min == 0 && boundingBox->max == 0))
+  {
+    box.min[0] = boundingBox->min.x; box.min[1] = boundingBox->min.y; box.min[2] = boundingBox->min.z;
+    box.max[0] = boundingBox->max.x; box.max[1] = boundingBox->max.y; box.max[2] = boundingBox->max.z;
+    return true;
+  }
+
+  if (Components::Collider* collider = entity->get<Components::Collider>())
+  {
+    collider->getBounds(box.min, box.max);
+    return true;
+  }
+
+  // a sprite with neither, use its transform as a unit model scaled into the world
+  if (entity->sprite && entity->transform)
+  {
+    const Vector3D position = entity->transform->getWorldPosition();
+    const Vector3D scale = entity->transform->getScale();
+    const float center[3] = { position.x, position.y, position.z };
+    const float half[3] = { scale.x * 0.5f, scale.y * 0.5f, scale.z * 0.5f };
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      box.min[axis] = center[axis] - half[axis];
+      box.max[axis] = center[axis] + half[axis];
+    }
+    return true;
+  }
+
+  return false;
+}
+
+bool World::SpatialIndex::GetHitbox(Entities::Entity* entity, AABB& box)
+{
+  if (Components::Collider* collider = entity->get<Components::Collider>())
+  {
+    collider->getBounds(box.min, box.max);
+    return true;
+  }
+
+  return GetBounds(entity, box);
+}
+
+bool World::SpatialIndex::GetTreeBounds(Entities::Entity* entity, AABB& box)
+{
+  if (!GetBounds(entity, box))
+    return false;
+
+  // a drawn box and a hitbox can disagree, the tree has to cover both
+  AABB hitbox;
+  if (entity->has<Components::Collider>() && GetHitbox(entity, hitbox))
+  {
+    box = AABB::Union(box, hitbox);
+  }
+  return true;
+}
+
+bool World::SpatialIndex::IsStatic(Entities::Entity* entity)
+{
+  return entity->hasFlag(Entities::StaticCollider) || !entity->has<Components::Physics>();
+}
+
+void World::SpatialIndex::bake(const Entities::QueryView& entities)
+{
+  clear();
+
+  std::vector<StaticTree::Item> items;
+  items.reserve(entities.size());
+
+  for (Entities::Entity* entity : entities)
+  {
+    AABB box;
+    if (!GetTreeBounds(entity, box))
+      continue;
+
+    if (IsStatic(entity))
+    {
+      items.push_back({ box, entity, entity->getHandle() });
+    }
+    else
+    {
+      dynamicTree.update(entity, box);
+    }
+  }
+
+  staticTree.build(std::move(items));
+  dynamicTree.removeStale();
+
+  Logger::write("Baked " + std::to_string(staticTree.getCount()) + " static and " + std::to_string(dynamicTree.getCount()) + " dynamic entities");
+}
+
+void World::SpatialIndex::sync(const Entities::QueryView& entities)
+{
+  for (Entities::Entity* entity : entities)
+  {
+    AABB box;
+    if (!GetTreeBounds(entity, box))
+      continue;
+
+    // baked entities that haven't moved cost one compare
+    if (const AABB* baked = staticTree.find(entity))
+    {
+      if (*baked == box)
+      {
+        staticTree.markSeen(entity);
+        continue;
+      }
+
+      staticTree.disable(entity);
+    }
+
+    dynamicTree.update(entity, box);
+  }
+
+  staticTree.removeStale();
+  dynamicTree.removeStale();
+}
+
+void World::SpatialIndex::clear()
+{
+  dynamicTree.clear();
+  staticTree.clear();
+}
+
+World::RayHit World::SpatialIndex::raycast(const Ray& ray, const QueryFilter& filter) const
+{
+  RayHit hit = staticTree.raycast(ray, filter);
+
+  // the dynamic tree only has to beat what the static tree found
+  Ray closer = ray;
+  if (hit.entity)
+  {
+    closer.maxDistance = hit.distance;
+  }
+
+  RayHit moving = dynamicTree.raycast(closer, filter);
+  return moving.entity ? moving : hit;
+}
+
+void World::SpatialIndex::raycast(const std::vector<Ray>& rays, std::vector<RayHit>& hits, const QueryFilter& filter, Jobs::JobSystem* jobs) const
+{
+  hits.resize(rays.size());
+
+  // queries only read the trees, so rays can be cast from any thread
+  auto castRange = [&](int begin, int end) {
+    for (int i = begin; i < end; ++i)
+    {
+      hits[i] = raycast(rays[i], filter);
+    }
+  };
+
+  if (jobs)
+    jobs->parallelFor((int)rays.size(), 16, castRange);
+  else
+    castRange(0, (int)rays.size());
+}
+
+void World::SpatialIndex::overlap(const AABB& box, std::vector<Entities::Entity*>& results, const QueryFilter& filter) const
+{
+  staticTree.overlap(box, results, filter);
+  dynamicTree.overlap(box, results, filter);
+}
+
+void World::SpatialIndex::overlapSphere(Vector3D center, float radius, std::vector<Entities::Entity*>& results, const QueryFilter& filter) const
+{
+  const float point[3] = { center.x, center.y, center.z };
+  staticTree.overlapSphere(point, radius, results, filter);
+  dynamicTree.overlapSphere(point, radius, results, filter);
+}
+
+bool World::SpatialIndex::sweep(const AABB& box, const float displacement[3], SweepHit& hit, const QueryFilter& filter) const
+{
+  // everything the box could touch on the way is inside the box around where it starts and where it ends
+  AABB moved = box;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    moved.min[axis] += displacement[axis];
+    moved.max[axis] += displacement[axis];
+  }
+
+  std::vector<Entities::Entity*> candidates;
+  overlap(AABB::Union(box, moved), candidates, filter);
+
+  hit = SweepHit();
+  AABB bounds;
+  float time;
+  int axis;
+
+  for (Entities::Entity* entity : candidates)
+  {
+    if (GetHitbox(entity, bounds) && box.sweep(bounds, displacement, time, axis) && time < hit.time)
+    {
+      hit.entity = entity;
+      hit.time = time;
+      hit.axis = axis;
+    }
+  }
+
+  return hit.entity != nullptr;
+}
+
+void World::SpatialIndex::nearest(Vector3D point, int k, std::vector<Neighbor>& results, const QueryFilter& filter) const
+{
+  const float position[3] = { point.x, point.y, point.z };
+
+  // both trees merge into the same sorted list, so the second one prunes against the first one's results
+  results.clear();
+  staticTree.nearest(position, k, results, filter);
+  dynamicTree.nearest(position, k, results, filter);
+}
@@ -0,0 +1,76 @@
+/*
+/
+// filename: SpatialIndex.h
+// author: Callen Betts
+// brief: defines the scene's spatial queries over a baked static tree and a dynamic tree
+//
+// description: When a scene loads, every entity that isn't expected to move (a static collider, or no physics at
+//  all) is baked into the static tree and everything else goes into the dynamic tree. Each frame the index is
+//  synced with the scene: moving entities refit the dynamic tree, and a static entity that moved anyway is
+//  switched off in the static tree and handed to the dynamic one. Queries ask both trees, so ray picks,
+//  line of sight checks and "what is near me" cost a walk down two trees instead of a look at every entity.
+/
+*/
+
+#pragma once
+#include "AABBTree.h"
+#include "StaticTree.h"
+
+namespace Entities
+{
+  class QueryView;
+}
+
+namespace Jobs
+{
+  class JobSystem;
+}
+
+namespace World
+{
+
+  class SpatialIndex
+  {
+
+  public:
+
+    // the box queries use: an entity's bounding box, else its collider, else its transform; false if it has none
+    static bool GetBounds(Entities::Entity* entity, AABB& box);
+    // the box an entity collides with: its collider's hitbox, else the same as GetBounds
+    static bool GetHitbox(Entities::Entity* entity, AABB& box);
+    // if an entity is baked into the static tree
+    static bool IsStatic(Entities::Entity* entity);
+
+    // rebuild both trees from a set of entities
+    void bake(const Entities::QueryView& entities);
+    // bring both trees up to date with the entities' current boxes; entities no longer in the set are removed
+    void sync(const Entities::QueryView& entities);
+    void clear();
+
+    // the closest entity a ray hits
+    RayHit raycast(const Ray& ray, const QueryFilter& filter = nullptr) const;
+    // cast many rays at once, split over the job system when one is given
+    void raycast(const std::vector<Ray>& rays, std::vector<RayHit>& hits, const QueryFilter& filter = nullptr, Jobs::JobSystem* jobs = nullptr) const;
+    // entities whose box overlaps a box or a sphere
+    void overlap(const AABB& box, std::vector<Entities::Entity*>& results, const QueryFilter& filter = nullptr) const;
+    void overlapSphere(Vector3D center, float radius, std::vector<Entities::Entity*>& results, const QueryFilter& filter = nullptr) const;
+    // the first entity a box moving by displacement runs into, tested against their hitboxes; false if it gets all
+    // the way, and entities the box already overlaps are skipped
+    bool sweep(const AABB& box, const float displacement[3], SweepHit& hit, const QueryFilter& filter = nullptr) const;
+    // the k entities closest to a point, nearest first
+    void nearest(Vector3D point, int k, std::vector<Neighbor>& results, const QueryFilter& filter = nullptr) const;
+
+    const AABBTree& getDynamicTree() const { return dynamicTree; }
+    const StaticTree& getStaticTree() const { return staticTree; }
+
+  private:
+
+    // what the trees hold, big enough for both GetBounds and GetHitbox so either kind of query finds the entity
+    static bool GetTreeBounds(Entities::Entity* entity, AABB& box);
+
+    AABBTree dynamicTree;
+    StaticTree staticTree;
+
+  };
+
+}
@@ -0,0 +1,384 @@
+/*
+/
+// filename: StaticTree.cpp
+// author: Callen Betts
+// brief: implements StaticTree.h
+/
+*/
+
+#include "stdafx.h"
+#include "StaticTree.h"
+#include "Engine/Entity/Entity.h"
+#include <queue>
+
+namespace
+{
+  // split candidates tried along an axis
+  constexpr int Bins = 12;
+
+  float Center(const World::AABB& box, int axis)
+  {
+    return (box.min[axis] + box.max[axis]) * 0.5f;
+  }
+}
+
+void World::StaticTree::build(std::vector<Item> newItems)
+{
+  items = std::move(newItems);
+  nodes.clear();
+  nodes.reserve(items.size() * 2 / LeafSize + 1);
+
+  if (!items.empty())
+  {
+    buildNode(0, (int)items.size());
+  }
+
+  // items were reordered by the build
+  itemOf.clear();
+  seen.assign(items.size(), sweep);
+  for (int i = 0; i < (int)items.size(); ++i)
+  {
+    const std::uint32_t slot = items[i].handle.index;
+    if (slot >= itemOf.size())
+    {
+      itemOf.resize(slot + 1, -1);
+    }
+    itemOf[slot] = i;
+  }
+
+  count = (int)items.size();
+}
+
+void World::StaticTree::clear()
+{
+  nodes.clear();
+  items.clear();
+  seen.clear();
+  itemOf.clear();
+  count = 0;
+}
+
+const World::AABB* World::StaticTree::find(const Entities::Entity* entity) const
+{
+  int item = findItem(entity);
+  return item >= 0 ? &items[item].box : nullptr;
+}
+
+void World::StaticTree::disable(const Entities::Entity* entity)
+{
+  int item = findItem(entity);
+  if (item < 0)
+    return;
+
+  seen[item] = 0;
+  count--;
+}
+
+void World::StaticTree::markSeen(const Entities::Entity* entity)
+{
+  int item = findItem(entity);
+  if (item >= 0)
+  {
+    seen[item] = sweep;
+  }
+}
+
+void World::StaticTree::removeStale()
+{
+  for (size_t i = 0; i < items.size(); ++i)
+  {
+    if (seen[i] != 0 && seen[i] != sweep)
+    {
+      seen[i] = 0;
+      count--;
+    }
+  }
+
+  sweep++;
+}
+
+World::RayHit World::StaticTree::raycast(const Ray& ray, const QueryFilter& filter) const
+{
+  RayHit hit;
+  hit.distance = ray.maxDistance;
+
+  if (nodes.empty())
+    return hit;
+
+  std::vector<int> stack;
+  stack.push_back(0);
+
+  while (!stack.empty())
+  {
+    const int index = stack.back();
+    const Node& node = nodes[index];
+    stack.pop_back();
+
+    float distance;
+    if (!node.box.raycast(ray, hit.distance, distance))
+      continue;
+
+    if (node.itemCount == 0)
+    {
+      stack.push_back(node.right);
+      stack.push_back(index + 1);
+      continue;
+    }
+
+    for (int i = node.first; i < node.first + node.itemCount; ++i)
+    {
+      const Item& item = items[i];
+      if (seen[i] && item.box.raycast(ray, hit.distance, distance) && distance < hit.distance && (!filter || filter(item.entity)))
+      {
+        hit.entity = item.entity;
+        hit.distance = distance;
+      }
+    }
+  }
+
+  if (!hit.entity)
+  {
+    hit.distance = FLT_MAX;
+  }
+  return hit;
+}
+
+void World::StaticTree::overlap(const AABB& box, std::vector<Entities::Entity*>& results, const QueryFilter& filter) const
+{
+  if (nodes.empty())
+    return;
+
+  std::vector<int> stack;
+  stack.push_back(0);
+
+  while (!stack.empty())
+  {
+    const int index = stack.back();
+    const Node& node = nodes[index];
+    stack.pop_back();
+
+    if (!node.box.overlaps(box))
+      continue;
+
+    if (node.itemCount == 0)
+    {
+      stack.push_back(node.right);
+      stack.push_back(index + 1);
+      continue;
+    }
+
+    for (int i = node.first; i < node.first + node.itemCount; ++i)
+    {
+      if (seen[i] && items[i].box.overlaps(box) && (!filter || filter(items[i].entity)))
+      {
+        results.push_back(items[i].entity);
+      }
+    }
+  }
+}
+
+void World::StaticTree::overlapSphere(const float center[3], float radius, std::vector<Entities::Entity*>& results, const QueryFilter& filter) const
+{
+  if (nodes.empty())
+    return;
+
+  const float radiusSquared = radius * radius;
+
+  std::vector<int> stack;
+  stack.push_back(0);
+
+  while (!stack.empty())
+  {
+    const int index = stack.back();
+    const Node& node = nodes[index];
+    stack.pop_back();
+
+    if (node.box.distanceSquared(center) > radiusSquared)
+      continue;
+
+    if (node.itemCount == 0)
+    {
+      stack.push_back(node.right);
+      stack.push_back(index + 1);
+      continue;
+    }
+
+    for (int i = node.first; i < node.first + node.itemCount; ++i)
+    {
+      if (seen[i] && items[i].box.distanceSquared(center) <= radiusSquared && (!filter || filter(items[i].entity)))
+      {
+        results.push_back(items[i].entity);
+      }
+    }
+  }
+}
+
+void World::StaticTree::nearest(const float point[3], int k, std::vector<Neighbor>& nearest, const QueryFilter& filter) const
+{
+  if (nodes.empty() || k <= 0)
+    return;
+
+  using Entry = std::pair<float, int>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+  open.push({ nodes[0].box.distanceSquared(point), 0 });
+
+  while (!open.empty())
+  {
+    auto [distance, index] = open.top();
+    open.pop();
+
+    if ((int)nearest.size() == k && distance >= nearest.back().distanceSquared)
+      break;
+
+    const Node& node = nodes[index];
+
+    if (node.itemCount == 0)
+    {
+      open.push({ nodes[index + 1].box.distanceSquared(point), index + 1 });
+      open.push({ nodes[node.right].box.distanceSquared(point), node.right });
+      continue;
+    }
+
+    for (int i = node.first; i < node.first + node.itemCount; ++i)
+    {
+      if (seen[i] && (!filter || filter(items[i].entity)))
+      {
+        KeepNearest(nearest, k, { items[i].entity, items[i].box.distanceSquared(point) });
+      }
+    }
+  }
+}
+
+int World::StaticTree::buildNode(int start, int end)
+{
+  const int index = (int)nodes.size();
+  nodes.emplace_back();
+
+  AABB box = items[start].box;
+  AABB centers;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    centers.min[axis] = centers.max[axis] = Center(items[start].box, axis);
+  }
+
+  for (int i = start + 1; i < end; ++i)
+  {
+    box = AABB::Union(box, items[i].box);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const float center = Center(items[i].box, axis);
+      centers.min[axis] = (std::min)(centers.min[axis], center);
+      centers.max[axis] = (std::max)(centers.max[axis], center);
+    }
+  }
+
+  nodes[index].box = box;
+  const int itemCount = end - start;
+
+  auto makeLeaf = [&]() {
+    nodes[index].first = start;
+    nodes[index].itemCount = itemCount;
+    return index;
+  };
+
+  if (itemCount <= LeafSize)
+    return makeLeaf();
+
+  // split along the axis the centers spread over the most
+  int axis = 0;
+  for (int i = 1; i < 3; ++i)
+  {
+    if (centers.max[i] - centers.min[i] > centers.max[axis] - centers.min[axis])
+      axis = i;
+  }
+
+  const float extent = centers.max[axis] - centers.min[axis];
+  int middle = start;
+
+  if (extent > 0)
+  {
+    // sort the centers into bins and pick the boundary where the two sides cost the least to visit
+    int binCount[Bins] = {};
+    AABB binBox[Bins];
+    const float scale = Bins / extent;
+
+    auto binOf = [&](const Item& item) {
+      return (std::min)(Bins - 1, (int)((Center(item.box, axis) - centers.min[axis]) * scale));
+    };
+
+    for (int i = start; i < end; ++i)
+    {
+      const int bin = binOf(items[i]);
+      binBox[bin] = binCount[bin] ? AABB::Union(binBox[bin], items[i].box) : items[i].box;
+      binCount[bin]++;
+    }
+
+    float rightArea[Bins] = {};
+    int rightCount[Bins] = {};
+    AABB sweepBox;
+    int sweepCount = 0;
+    for (int bin = Bins - 1; bin > 0; --bin)
+    {
+      if (binCount[bin])
+      {
+        sweepBox = sweepCount ? AABB::Union(sweepBox, binBox[bin]) : binBox[bin];
+        sweepCount += binCount[bin];
+      }
+      rightArea[bin] = sweepCount ? sweepBox.area() : 0;
+      rightCount[bin] = sweepCount;
+    }
+
+    float bestCost = FLT_MAX;
+    int bestSplit = -1;
+    sweepCount = 0;
+    for (int bin = 0; bin < Bins - 1; ++bin)
+    {
+      if (binCount[bin])
+      {
+        sweepBox = sweepCount ? AABB::Union(sweepBox, binBox[bin]) : binBox[bin];
+        sweepCount += binCount[bin];
+      }
+
+      if (sweepCount == 0 || rightCount[bin + 1] == 0)
+        continue;
+
+      const float cost = sweepBox.area() * sweepCount + rightArea[bin + 1] * rightCount[bin + 1];
+      if (cost < bestCost)
+      {
+        bestCost = cost;
+        bestSplit = bin;
+      }
+    }
+
+    if (bestSplit >= 0)
+    {
+      auto it = std::partition(items.begin() + start, items.begin() + end, [&](const Item& item) { return binOf(item) <= bestSplit; });
+      middle = (int)(it - items.begin());
+    }
+  }
+
+  // every center in one spot, or nothing to gain from the bins; split in half by position
+  if (middle == start || middle == end)
+  {
+    middle = start + itemCount / 2;
+    std::nth_element(items.begin() + start, items.begin() + middle, items.begin() + end, [axis](const Item& a, const Item& b) {
+      return Center(a.box, axis) < Center(b.box, axis);
+    });
+  }
+
+  buildNode(start, middle);
+  const int right = buildNode(middle, end);
+  nodes[index].right = right;
+  return index;
+}
+
+int World::StaticTree::findItem(const Entities::Entity* entity) const
+{
+  const Entities::EntityHandle handle = entity->getHandle();
+
+  if (handle.index >= itemOf.size() || itemOf[handle.index] < 0)
+    return -1;
+
+  const int item = itemOf[handle.index];
+  return (items[item].handle == handle && seen[item]) ? item : -1;
+}
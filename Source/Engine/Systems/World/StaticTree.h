@@ -0,0 +1,85 @@
+/*
+/
+// filename: StaticTree.h
+// author: Callen Betts
+// brief: defines a bounding volume tree baked once from entities that don't move
+//
+// description: The static tree is built top down in one go when a scene loads. Each branch splits its boxes
+//  where the surface area heuristic says rays and overlaps will visit the fewest boxes, and nodes are laid out in
+//  one array with the left child right after its parent, so walking it stays in cache.
+//
+//  The tree is never changed after it is baked. An entity that moves or is deleted is switched off in place;
+//  the scene's spatial index puts it in the dynamic tree instead until the next bake.
+/
+*/
+
+#pragma once
+#include "AABB.h"
+#include "Engine/Entity/EntityHandle.h"
+
+namespace World
+{
+
+  class StaticTree
+  {
+
+  public:
+
+    struct Item
+    {
+      AABB box;
+      Entities::Entity* entity;
+      Entities::EntityHandle handle;
+    };
+
+    // most boxes a leaf holds
+    static constexpr int LeafSize = 4;
+
+    // rebuild the tree from scratch
+    void build(std::vector<Item> newItems);
+    void clear();
+
+    // the baked box of an entity that is still switched on, nullptr otherwise
+    const AABB* find(const Entities::Entity* entity) const;
+    // switch an entity off, queries skip it from now on
+    void disable(const Entities::Entity* entity);
+    // keep an entity switched on through the next removeStale
+    void markSeen(const Entities::Entity* entity);
+    // switch off every entity not marked seen since the last call
+    void removeStale();
+
+    // the same queries as the dynamic tree
+    RayHit raycast(const Ray& ray, const QueryFilter& filter = nullptr) const;
+    void overlap(const AABB& box, std::vector<Entities::Entity*>& results, const QueryFilter& filter = nullptr) const;
+    void overlapSphere(const float center[3], float radius, std::vector<Entities::Entity*>& results, const QueryFilter& filter = nullptr) const;
+    void nearest(const float point[3], int k, std::vector<Neighbor>& nearest, const QueryFilter& filter = nullptr) const;
+
+    // entities still switched on
+    int getCount() const { return count; }
+    int getDisabledCount() const { return (int)items.size() - count; }
+    int getNodeCount() const { return (int)nodes.size(); }
+
+  private:
+
+    struct Node
+    {
+      AABB box;
+      int right = -1; // the left child is the next node
+      int first = 0; // first item of a leaf
+      int itemCount = 0; // 0 for branches
+    };
+
+    // build the node for items [start, end), returns its index
+    int buildNode(int start, int end);
+    int findItem(const Entities::Entity* entity) const;
+
+    std::vector<Node> nodes;
+    std::vector<Item> items;
+    std::vector<std::uint32_t> seen; // per item, the sweep it was last seen in, 0 once disabled
+    std::vector<int> itemOf; // registry slot to item
+    int count = 0;
+    std::uint32_t sweep = 1;
+
+  };
+
+}
@@ -0,0 +1,128 @@
+/*
+/
+// filename: SweepBenchmark.cpp
+// author: Callen Betts
+// brief: measures swept integration of fast bodies against thin static platforms at a coarse step
+//
+// description: Every body is a unit crate above its own half unit thick static platform, falling fast enough and
+//  sideways enough that one 20 Hz step carries it past the platform. The step is taken once without the spatial
+//  index, the way bodies moved before, and once sweeping through it. Each run reports its time and how many
+//  crates ended up under their platform; swept bodies should land on top and slide, none of them tunnelling.
+//  "-benchmark Sweep 100000" drops 100k crates.
+/
+*/
+
+#include "stdafx.h"
+#include "SpatialIndex.h"
+#include "PhysicsWorld.h"
+#include "Engine/Entity/Entity.h"
+#include "Engine/Entity/EntityList/QueryIndex.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+
+namespace
+{
+  constexpr float Dt = 1.f / 20.f;
+  constexpr float Spacing = 4.f;
+  constexpr float PlatformTop = 0.25f;
+
+  // put every crate back above its platform, falling
+  void Reset(const std::vector<Entities::Entity*>& crates, int side)
+  {
+    for (int i = 0; i < (int)crates.size(); ++i)
+    {
+      crates[i]->transform->setPosition({ (i % side) * Spacing, 3.f, (i / side) * Spacing });
+
+      Components::Physics* physics = crates[i]->get<Components::Physics>();
+      physics->setAcceleration({ 0, 0, 0 });
+      physics->setVelocity({ 10.f, -120.f, 0 });
+    }
+  }
+
+  int CountTunnelled(const std::vector<Entities::Entity*>& crates)
+  {
+    int tunnelled = 0;
+    float min[3], max[3];
+
+    for (Entities::Entity* crate : crates)
+    {
+      crate->get<Components::Collider>()->getBounds(min, max);
+      tunnelled += min[1] < PlatformTop - 0.001f;
+    }
+
+    return tunnelled;
+  }
+
+  double Step(World::PhysicsWorld& physics, const World::SpatialIndex* world)
+  {
+    Benchmark::Stopwatch timer;
+    physics.step(Dt, world);
+    return timer.elapsed();
+  }
+
+  void SweepBenchmark(int count)
+  {
+    const int side = (std::max)(1, (int)std::ceil(std::sqrt((float)count)));
+
+    std::vector<Entities::Entity*> entities;
+    std::vector<Entities::Entity*> crates;
+    Entities::QueryIndex index;
+
+    for (int i = 0; i < count; ++i)
+    {
+      const float x = (i % side) * Spacing;
+      const float z = (i / side) * Spacing;
+
+      Entities::Entity* platform = new Entities::Entity();
+      platform->addComponent(new Components::Transform({ x, 0.f, z }, { 1.f, 1.f, 1.f }, { 0.f, 0.f, 0.f }));
+      platform->addComponent(new Components::BoxCollider({ 3.f, PlatformTop * 2.f, 3.f }, true, false));
+      entities.push_back(platform);
+
+      Entities::Entity* crate = new Entities::Entity();
+      crate->addComponent(new Components::Transform({ x, 3.f, z }, { 1.f, 1.f, 1.f }, { 0.f, 0.f, 0.f }));
+      crate->addComponent(new Components::BoxCollider({ 1.f, 1.f, 1.f }, false, false));
+      crate->addComponent(new Components::Physics());
+      entities.push_back(crate);
+      crates.push_back(crate);
+    }
+
+    for (Entities::Entity* entity : entities)
+    {
+      index.add(entity);
+    }
+    const Entities::QueryView& located = index.view(Entities::Query().with<Components::Transform>());
+    index.flush();
+
+    World::SpatialIndex spatial;
+    spatial.bake(located);
+
+    World::PhysicsWorld physics;
+    physics.sync(crates);
+
+    Reset(crates, side);
+    const double discreteTime = Step(physics, nullptr);
+    const int discreteTunnelled = CountTunnelled(crates);
+
+    Reset(crates, side);
+    const double sweptTime = Step(physics, &spatial);
+    const int sweptTunnelled = CountTunnelled(crates);
+
+    const std::string label = std::to_string(count) + " crates at 20 Hz, ";
+    Benchmark::Report("Sweep", label + "discrete step", discreteTime, "ms");
+    Benchmark::Report("Sweep", label + "swept step", sweptTime, "ms");
+    Benchmark::Report("Sweep", label + "discrete tunnelled", (double)discreteTunnelled, "crates");
+    Benchmark::Report("Sweep", label + "swept tunnelled", (double)sweptTunnelled, "crates");
+
+    if (sweptTunnelled)
+    {
+      Logger::error(std::to_string(sweptTunnelled) + " of " + std::to_string(count) + " swept crates went through their platform");
+    }
+
+    physics.clear();
+    for (Entities::Entity* entity : entities)
+    {
+      delete entity;
+    }
+  }
+}
+
+REGISTER_BENCHMARK(Sweep, SweepBenchmark);
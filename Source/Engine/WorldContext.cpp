@@ -0,0 +1,79 @@
+/*
+/
+// filename: WorldContext.cpp
+// author: Callen Betts
+// brief: implements WorldContext.h
+/
+*/
+
+#include "stdafx.h"
+#include "WorldContext.h"
+#include "Game/Scene/Scene.h"
+#include "Engine/GlowEngine.h"
+#include "Engine/Entity/Components/Visual/Models/ModelLibrary.h"
+
+Engine::WorldContext::WorldContext(const std::string& name)
+{
+  // the engine locks its model library once it has loaded, this makes sure of it before any world reads it
+  Engine::GlowEngine* engine = EngineInstance::getEngine();
+  if (engine && engine->getModelLibrary())
+  {
+    engine->getModelLibrary()->lock();
+  }
+
+  Binding binding(this);
+  scene = new Scene::Scene();
+  scene->setName(name);
+}
+
+Engine::WorldContext::~WorldContext()
+{
+  Binding binding(this);
+
+  // the scene deletes its entities, which go back to our pools and registry, so it's deleted while we're bound
+  delete scene;
+}
+
+bool Engine::WorldContext::load(const std::string& map)
+{
+  const std::string mapPath = "Data/Maps/" + map + "_MapData.json";
+  if (!std::ifstream(mapPath).is_open())
+  {
+    Logger::error("No map at " + mapPath);
+    return false;
+  }
+
+  Binding binding(this);
+  scene->setName(map);
+  scene->LoadScene();
+  return true;
+}
+
+void Engine::WorldContext::step()
+{
+  Binding binding(this);
+
+  clock.beginStep();
+
+  Memory::PoolAllocator::Scope scope(scene->getArena());
+  scene->update();
+  scene->updateEntities();
+}
+
+Engine::WorldContext::Binding::Binding(WorldContext* world) :
+  previous(current),
+  allocator(world->allocator),
+  registry(Entities::EntityRegistry::bound),
+  clock(Systems::FrameClock::bound)
+{
+  current = world;
+  Entities::EntityRegistry::bound = &world->registry;
+  Systems::FrameClock::bound = &world->clock;
+}
+
+Engine::WorldContext::Binding::~Binding()
+{
+  current = previous;
+  Entities::EntityRegistry::bound = registry;
+  Systems::FrameClock::bound = clock;
+}
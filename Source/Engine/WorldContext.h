@@ -0,0 +1,104 @@
+/*
+/
+// filename: WorldContext.h
+// author: Callen Betts
+// brief: defines a world that owns its own scene and entity state and can step on any thread
+//
+// description: The engine's scene shares the process's pools, entity registry and clock with
+//  everything else, so only one of it can run at a time. A world context has its own of each, along with a scene
+//  of its own, and stepping it binds them to the calling thread; the singletons' instance() hands back the bound
+//  ones for as long as the step runs. Dozens of worlds can then step side by side on different threads, each
+//  one only ever touching its own entities.
+//
+//  Prefabs, collision layers, component types and the model, texture and material libraries stay shared and are
+//  only read by a world, so they have to be loaded before any world steps. The model library is locked once the
+//  engine has loaded (and again when a world is made), so a sprite naming a model that isn't there logs and keeps
+//  its model instead of loading one, and texture and material lookups never add entries. Prefab instances are
+//  copies of the archetype, which nothing changes after the factory loads it.
+//
+//  Each world is single threaded. run(), step(), load() and the destructor bind it to the calling thread, and
+//  only one thread may be inside them at a time; different worlds can be on different threads. Everything a world
+//  owns updates on that thread, never on the job system. Worlds don't render, take input or run systems, and a
+//  world is always playing.
+/
+*/
+
+#pragma once
+#include "Engine/Systems/Memory/PoolAllocator.h"
+#include "Engine/Entity/EntityHandle.h"
+#include "Engine/Systems/Update/FrameClock.h"
+
+namespace Scene
+{
+  class Scene;
+}
+
+namespace Engine
+{
+
+  class WorldContext
+  {
+
+  public:
+
+    WorldContext(const std::string& name = "World");
+    ~WorldContext();
+
+    WorldContext(const WorldContext&) = delete;
+    WorldContext& operator=(const WorldContext&) = delete;
+
+    // load Data/Maps/<map>_MapData.json into our scene; returns false if there's no such map
+    bool load(const std::string& map);
+
+    // call func(scene) with this world bound to the calling thread, for building or reading a world from code
+    template <typename Func>
+    void run(Func&& func)
+    {
+      Binding binding(this);
+      func(*scene);
+    }
+
+    // advance the world one fixed step on the calling thread; not thread safe, see the description above
+    void step();
+
+    Scene::Scene* getScene() { return scene; }
+    float getDeltaTime() const { return clock.getStep(); }
+    std::uint32_t getStepCount() const { return clock.getStepCount(); }
+    int getEntityCount() const { return registry.getCount(); }
+
+    // the world bound to the calling thread, nullptr when the engine's own scene is running here
+    static WorldContext* Current() { return current; }
+
+  private:
+
+    // binds a world to the calling thread while it lives, putting back whatever was bound before
+    class Binding
+    {
+
+    public:
+
+      Binding(WorldContext* world);
+      ~Binding();
+
+    private:
+
+      // what was bound before us
+      WorldContext* previous;
+      Memory::PoolAllocator::Scope allocator;
+      Entities::EntityRegistry* registry;
+      Systems::FrameClock* clock;
+
+    };
+
+    // declared first so they outlive the scene and the entities in it
+    Memory::PoolAllocator allocator;
+    Entities::EntityRegistry registry;
+    Systems::FrameClock clock;
+
+    Scene::Scene* scene = nullptr;
+
+    static inline thread_local WorldContext* current = nullptr;
+
+  };
+
+}
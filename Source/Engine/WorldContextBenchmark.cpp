@@ -0,0 +1,146 @@
+/*
+/
+// filename: WorldContextBenchmark.cpp
+// author: Callen Betts
+// brief: measures many isolated worlds stepping one after another against stepping side by side
+//
+// description: Every world gets a static floor and its own scatter of crates dropping onto it, the way a batch
+//  of training or server shards would each hold their own copy of a map. The worlds are stepped once on a single
+//  threaded job system and once with a world per job across every hardware thread. Each world only ever touches
+//  its own entities, so both runs have to leave every crate in exactly the same place, and none of the worlds'
+//  entities may show up in the process's registry. "-benchmark Worlds 100000" splits 100k crates over the worlds.
+/
+*/
+
+#include "stdafx.h"
+#include "WorldContext.h"
+#include "Game/Scene/Scene.h"
+#include "Engine/Systems/Jobs/JobSystem.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+
+namespace
+{
+  constexpr int Worlds = 16;
+  constexpr int Steps = 120;
+  constexpr float Spacing = 2.5f;
+
+  // crates fall from different heights in every world, so no two worlds are the same
+  void Build(Engine::WorldContext& world, int index, int crates)
+  {
+    world.run([index, crates](Scene::Scene& scene) {
+      const int side = (std::max)(1, (int)std::ceil(std::sqrt((float)crates)));
+      const float extent = side * Spacing;
+
+      // the floor's top is at zero
+      Entities::Entity* floor = new Entities::Entity();
+      floor->addComponent(new Components::Transform({ extent * 0.5f, -0.5f, extent * 0.5f }, { 1.f, 1.f, 1.f }, { 0.f, 0.f, 0.f }));
+      floor->addComponent(new Components::BoxCollider({ extent + 2.f, 1.f, extent + 2.f }, true, false));
+      scene.add(floor);
+
+      std::mt19937 random(1234 + index);
+      std::uniform_real_distribution<float> height(1.f, 8.f);
+
+      for (int i = 0; i < crates; ++i)
+      {
+        Entities::Entity* crate = new Entities::Entity();
+        crate->addComponent(new Components::Transform({ (i % side) * Spacing, height(random), (i / side) * Spacing }, { 1.f, 1.f, 1.f }, { 0.f, 0.f, 0.f }));
+        crate->addComponent(new Components::BoxCollider({ 1.f, 1.f, 1.f }, false, false));
+        crate->addComponent(new Components::Physics());
+        scene.add(crate);
+      }
+    });
+  }
+
+  // every world steps on whichever thread picks it up, one world per job
+  double Run(std::vector<Engine::WorldContext*>& worlds, Jobs::JobSystem& jobs)
+  {
+    Benchmark::Stopwatch timer;
+    jobs.parallelFor((int)worlds.size(), 1, [&worlds](int begin, int end) {
+      for (int i = begin; i < end; ++i)
+      {
+        for (int step = 0; step < Steps; ++step)
+        {
+          worlds[i]->step();
+        }
+      }
+      });
+    return timer.elapsed() / Steps;
+  }
+
+  // where every crate in every world ended up
+  std::vector<Vector3D> Positions(std::vector<Engine::WorldContext*>& worlds)
+  {
+    std::vector<Vector3D> positions;
+    for (Engine::WorldContext* world : worlds)
+    {
+      world->run([&positions](Scene::Scene& scene) {
+        for (Entities::Entity* entity : scene.getRootList()->getEntities())
+        {
+          positions.push_back(entity->transform->getPosition());
+        }
+      });
+    }
+    return positions;
+  }
+
+  // build the worlds, step them all and take them down again; returns ms per step of every world
+  double Simulate(Jobs::JobSystem& jobs, int crates, std::vector<Vector3D>& positions, int& leaked)
+  {
+    const int processEntities = Entities::EntityRegistry::instance().getCount();
+
+    std::vector<Engine::WorldContext*> worlds;
+    for (int i = 0; i < Worlds; ++i)
+    {
+      Engine::WorldContext* world = new Engine::WorldContext("World " + std::to_string(i));
+      Build(*world, i, crates);
+      worlds.push_back(world);
+    }
+
+    const double time = Run(worlds, jobs);
+    positions = Positions(worlds);
+    leaked += Entities::EntityRegistry::instance().getCount() - processEntities;
+
+    for (Engine::WorldContext* world : worlds)
+    {
+      delete world;
+    }
+
+    return time;
+  }
+
+  void WorldContextBenchmark(int count)
+  {
+    const int crates = (std::max)(1, count / Worlds);
+    std::vector<Vector3D> expected, positions;
+    int leaked = 0;
+
+    Jobs::JobSystem single(1);
+    const double singleTime = Simulate(single, crates, expected, leaked);
+
+    Jobs::JobSystem jobs(0);
+    const double jobsTime = Simulate(jobs, crates, positions, leaked);
+
+    int mismatches = (int)(expected.size() != positions.size());
+    for (size_t i = 0; !mismatches && i < positions.size(); ++i)
+    {
+      mismatches += expected[i].x != positions[i].x || expected[i].y != positions[i].y || expected[i].z != positions[i].z;
+    }
+
+    const std::string label = std::to_string(Worlds) + " worlds of " + std::to_string(crates) + " crates, ";
+    Benchmark::Report("Worlds", label + "1 thread", singleTime, "ms/step");
+    Benchmark::Report("Worlds", label + std::to_string(jobs.getThreadCount()) + " threads", jobsTime, "ms/step");
+    Benchmark::Report("Worlds", label + "speedup", jobsTime > 0 ? singleTime / jobsTime : 0, "x");
+
+    if (mismatches)
+    {
+      Logger::error("Worlds stepped on " + std::to_string(jobs.getThreadCount()) + " threads didn't end where they did on one");
+    }
+
+    if (leaked)
+    {
+      Logger::error(std::to_string(leaked) + " world entities were made in the process's registry");
+    }
+  }
+}
+
+REGISTER_BENCHMARK(Worlds, WorldContextBenchmark);
@@ -8,16 +8,29 @@
 
 #include "stdafx.h"
 #include "Engine/GlowEngine.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+#include "Engine/Systems/Jobs/JobSystem.h"
 
 // create engine
 static Engine::GlowEngine* engine = new Engine::GlowEngine();
 
-int main()
+int main(int argc, char** argv)
 {
+  // benchmarks run headless and exit without ever opening a window
+  if (Benchmark::RunFromCommandLine(argc, argv))
+  {
+    return 0;
+  }
+
+  // -threads 1 runs everything on the main thread for debugging
+  engine->SetThreadCount(Jobs::ThreadCountFromCommandLine(argc, argv));
+  // -headless steps a map with no window, renderer or editor, for batch runs, servers and CI
+  engine->SetHeadlessFromCommandLine(argc, argv);
+
   // start the engine
   if (engine->start())
   {
-    return engine->run();
+    return engine->IsHeadless() ? engine->runHeadless() : engine->run();
   }
 
   return -1; // catastrophic engine failiure
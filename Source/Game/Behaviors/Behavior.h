@@ -17,6 +17,8 @@ namespace Game
 
   public:
 
+    static constexpr Components::Component::ComponentType StaticType = Components::Component::ComponentType::Behavior;
+
     Behavior();
 
     virtual void update() {};
@@ -32,8 +32,8 @@ Game::PlayerBehavior::PlayerBehavior() : Behavior()
 void Game::PlayerBehavior::update()
 {
   // get the components we need to move
-  Components::Transform* transform = getComponentOfType(Transform, parent);
-  Components::Physics* physics = getComponentOfType(Physics, parent);
+  Components::Transform* transform = parent->get<Components::Transform>();
+  Components::Physics* physics = parent->get<Components::Physics>();
 
   if (!physics || !transform)
     return;
@@ -73,7 +73,7 @@ void Game::PlayerBehavior::update()
     targetVelocity.z -= rightVelocity.z;
   }
 
-  if (input->keyDown(VK_SPACE) && physics->isGrounded())
+  if (input->keyDown(Input::Key::Space) && physics->isGrounded())
   {
     physics->setVelocityY(jumpSpeed);
     transform->setPosition(transform->getPosition() + Vector3D(0.f, 0.1f, 0.f));
@@ -18,6 +18,9 @@ namespace Game
 
   public:
 
+    static constexpr Components::Component::ComponentType StaticType = Components::Component::ComponentType::PlayerBehavior;
+    COMPONENT_POOL(PlayerBehavior)
+
     PlayerBehavior();
 
     virtual void update();
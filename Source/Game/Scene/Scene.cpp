@@ -10,18 +10,79 @@
 #include "Scene.h"
 #include "Engine/Graphics/Renderer.h"
 #include "Engine/Graphics/Camera/Camera.h"
+#include "Engine/WorldContext.h"
+
+namespace
+{
+  // the collider of a contact's entity, nullptr if the entity or its collider is gone
+  Components::Collider* ColliderOf(const Entities::EntityHandle& handle)
+  {
+    Entities::Entity* entity = handle.get();
+    return entity ? entity->get<Components::Collider>() : nullptr;
+  }
+
+  // sleeping bodies and static colliders don't look for contacts, so a pair between two of them isn't found
+  // because nobody looked, not because it came apart
+  bool IsIdle(const Entities::EntityHandle& handle)
+  {
+    Entities::Entity* entity = handle.get();
+    if (!entity)
+      return false;
+
+    Components::Physics* physics = entity->get<Components::Physics>();
+    if (physics && physics->isSleeping())
+      return true;
+
+    Components::Collider* collider = entity->get<Components::Collider>();
+    return collider && collider->isStatic();
+  }
+}
 
 // base scene constructor
 Scene::Scene::Scene()
 {
+  // worlds can be made without an engine
   engine = EngineInstance::getEngine();
-  input = engine->getInputSystem();
-  factory = engine->getEntityFactory();
-  globalList = new Entities::EntityList();
+  input = engine ? engine->getInputSystem() : nullptr;
+  factory = engine ? engine->getEntityFactory() : nullptr;
+  arena.markArena();
   rootList = new Entities::EntityList();
-  rootList->add(engine->getCamera());
+  rootList->setIndices(&names, &queries);
+  rootList->setScene(this);
+
+  // the camera belongs to the engine's own scene
+  if (engine && !Engine::WorldContext::Current())
+  {
+    rootList->add(engine->getCamera());
+  }
   rootList->SetName("Root");
   name = "Scene";
+
+  // children need their parent's final world matrix before colliders and sprites use it
+  pipeline.after("Transforms", [this]() { hierarchy.update(); });
+  // every body moves at once, after behaviors have set their velocities and before transforms rebuild their matrices
+  pipeline.after("Physics", [this]() { physicsWorld.step(EngineInstance::GetDeltaTime(), &spatial, EngineInstance::GetJobSystem()); });
+
+  colliders = &queries.view(Entities::Query().with<Components::Collider>());
+  movingColliders = &queries.view(Entities::Query().with<Components::Collider>().withoutFlags(Entities::StaticCollider));
+  located = &queries.view(Entities::Query().with<Components::Transform>());
+  bodies = &queries.view(Entities::Query().with<Components::Physics>());
+}
+
+// our entities' blocks live in the arena, so they're deleted before it goes away with us
+Scene::Scene::~Scene()
+{
+  clear();
+
+#ifdef _DEBUG
+  // whatever is still live was pooled from our arena by something we don't own, and is about to dangle
+  if (arena.getStats().liveBytes != 0)
+  {
+    Logger::error("Scene " + name + " is going away with " + std::to_string(arena.getStats().liveBytes) + " bytes still live in its arena");
+  }
+#endif
+
+  delete rootList;
 }
 
 /// <summary>
@@ -79,14 +140,21 @@ void Scene::Scene::LoadSnapshot(std::string filePath)
   }
   file.seekg(0, std::ios::beg);
 
-  // Destroy every single entity in existence (clean slate)
+  Memory::PoolAllocator::Scope scope(arena);
+
+  // Destroy every single entity in existence (clean slate), then give their slabs back before loading
   rootList->DeleteAllEntities();
+  rootList->sync();
+  arena.trim();
 
   // Load everything from the snapshot
   nlohmann::json sceneData;
 
   file >> sceneData;
 
+  // parents may load after their children, so links are made once everything exists
+  std::vector<std::pair<Entities::Entity*, int>> parentLinks;
+
   // Iterate over every entity in scene and load it back in
   for (const auto& [entryName, fileData] : sceneData.items())
   {
@@ -99,18 +167,48 @@ void Scene::Scene::LoadSnapshot(std::string filePath)
         // Add each entity within the list
         for (const auto& [entity, entityData] : entityListData.items())
         {
-          // Construct the entity
-          Entities::Entity* newEntity = new Entities::Entity(entity);
+          // Construct the entity; prefab instances start from their prefab and load their overrides on top
+          Entities::Entity* newEntity = nullptr;
+          if (entityData.contains("Prefab") && factory)
+          {
+            newEntity = factory->createEntity(entityData["Prefab"].get<std::string>(), { 0 });
+            newEntity->setName(entity);
+          }
+          else
+          {
+            newEntity = new Entities::Entity(entity);
+          }
           newEntity->Load(entityData);
           
           // Try to find the list associated with it (TODO)
           rootList->add(newEntity);
+
+          if (entityData.contains("Parent"))
+          {
+            parentLinks.push_back({ newEntity, entityData["Parent"].get<int>() });
+          }
         }
       }
     }
   }
 
+  for (const auto& [child, parentId] : parentLinks)
+  {
+    Entities::Entity* parent = Entities::EntityRegistry::instance().findByStableId(parentId).get();
+    if (!parent)
+    {
+      Logger::write("Missing parent " + std::to_string(parentId) + " for " + child->getName());
+      continue;
+    }
+
+    hierarchy.setParent(child, parent);
+  }
+
+  // bake once the loaded transforms have been through an update
+  bakePending = true;
+
   Logger::write("Loaded snapshot from " + filePath);
+  arena.logStats("Entity pools");
 }
 
 /// <summary>
@@ -140,6 +238,8 @@ void Scene::Scene::exit()
 void Scene::Scene::restart()
 {
   clear();
+
+  Memory::PoolAllocator::Scope scope(arena);
   init();
 }
 
@@ -152,11 +252,185 @@ void Scene::Scene::render()
 // update a scene's given entities
 void Scene::Scene::updateEntities()
 {
-  // update all of our entity lists; entity lists recursively update their sublists
+  // anything spawned during the update comes from our arena
+  Memory::PoolAllocator::Scope scope(arena);
+
+  // update all of our entity lists; entity lists recursively update their sublists and gather components
   rootList->update();
 
-  // we have a separate list for handling collisions
-  globalList->updateColliders();
+  // bodies live in the physics world while the game runs; in the editor their components hold them so they can be edited
+  if (EngineInstance::IsPaused())
+  {
+    physicsWorld.detachAll();
+  }
+  else
+  {
+    queries.flush();
+    physicsWorld.sync(bodies->getEntities());
+  }
+
+  // update the gathered components one type at a time
+  pipeline.run();
+
+  // bring the views up to date with this frame's component and flag changes, then collide
+  queries.flush();
+  checkCollisions();
+
+  // sync point; apply everything that was queued during the update, then compact the lists
+  commands.playback();
+  rootList->sync();
+
+  // bring the spatial index up to date with where everything ended the frame
+  queries.flush();
+  if (bakePending)
+  {
+    spatial.bake(*located);
+    fitGrid();
+    bakePending = false;
+  }
+  else
+  {
+    spatial.sync(*located);
+  }
+}
+
+// moving colliders are tested against the colliders near them on layers they collide with; static pairs are never tested
+// and sleeping bodies don't look, anything awake that runs into one still finds it
+void Scene::Scene::checkCollisions()
+{
+  const World::StaticTree& staticTree = spatial.getStaticTree();
+
+  // move every collider's box in the grid, the ones that left the view since last frame are dropped; level
+  // geometry baked into the static tree stays out of it, so big floors and walls aren't in every query
+  float min[3], max[3];
+  narrowphase.clear();
+  for (Entities::Entity* entity : *colliders)
+  {
+    if (!entity->transform)
+      continue;
+
+    Components::Collider* collider = entity->get<Components::Collider>();
+    collider->getBounds(min, max);
+    narrowphase.addBox(entity, min, max);
+
+    if (!(collider->isStatic() && staticTree.find(entity)))
+    {
+      grid.update(entity, min, max, collider->getFilter());
+    }
+  }
+  grid.removeStale();
+
+  // the grid isn't safe to query from several threads, so the candidates are gathered here first
+  for (Entities::Entity* ent1 : *movingColliders)
+  {
+    Components::Collider* collider1 = ent1->get<Components::Collider>();
+
+    // the collider turned static since the views were flushed, it leaves the view next frame
+    if (collider1->isStatic() || !ent1->transform)
+      continue;
+
+    Components::Physics* physics1 = ent1->get<Components::Physics>();
+    if (physics1 && physics1->isSleeping())
+      continue;
+
+    // every candidate has a box from above; box colliders are the only collider type
+    candidates.clear();
+    grid.query(ent1, candidates);
+
+    // baked static colliders are whatever the grid left out; their baked box is where they were at the end of
+    // last frame, the narrowphase tests the box they have now
+    const World::CollisionFilter filter = collider1->getFilter();
+    World::AABB box;
+    collider1->getBounds(box.min, box.max);
+    staticTree.overlap(box, candidates, [&filter](Entities::Entity* other) {
+      Components::Collider* collider = other->get<Components::Collider>();
+      return collider && collider->isStatic() && other->transform && !other->isDestroyed() && filter.accepts(collider->getFilter());
+    });
+
+    narrowphase.addMover(ent1, candidates);
+  }
+
+  // the box tests run across the job system and come back sorted by pair, so the cache is filled in the same
+  // order however many threads there are; two moving colliders find each other twice, the cache keeps the pair once
+  narrowphase.run(EngineInstance::GetJobSystem());
+  for (const World::Touch& touch : narrowphase.getTouching())
+  {
+    contacts.touch(touch.mover, touch.other, touch.penetration);
+  }
+
+  // pairs we were touching and didn't find this frame have ended, unless neither side looked
+  contacts.update([](const World::Contact& contact) { return IsIdle(contact.first) && IsIdle(contact.second); });
+  dispatchContacts();
+
+  // sleep or wake islands now that the contacts are resolved
+  islands.update(bodies->getEntities(), contacts);
+}
+
+void Scene::Scene::fitGrid()
+{
+  std::vector<float> widths;
+  widths.reserve(movingColliders->size());
+
+  float min[3], max[3];
+  for (Entities::Entity* entity : *movingColliders)
+  {
+    if (!entity->transform)
+      continue;
+
+    entity->get<Components::Collider>()->getBounds(min, max);
+    widths.push_back((std::max)({ max[0] - min[0], max[1] - min[1], max[2] - min[2] }));
+  }
+
+  grid.setCellSize(World::Grid::FitCellSize(std::move(widths), grid.getCellSize()));
+}
+
+void Scene::Scene::dispatchContacts()
+{
+  for (const World::Contact& contact : contacts.getBegan())
+  {
+    Components::Collider* first = ColliderOf(contact.first);
+    Components::Collider* second = ColliderOf(contact.second);
+    if (!first || !second)
+      continue;
+
+    first->enterCollision(second);
+    second->enterCollision(first);
+  }
+
+  // pairs that just began get resolved along with the ones that stayed
+  for (const std::vector<World::Contact>* touching : { &contacts.getBegan(), &contacts.getStayed() })
+  {
+    for (const World::Contact& contact : *touching)
+    {
+      Components::Collider* first = ColliderOf(contact.first);
+      Components::Collider* second = ColliderOf(contact.second);
+      if (!first || !second)
+        continue;
+
+      Components::Collider::ResolveContact(first, second);
+    }
+  }
+
+  // one side may have been deleted, the other still has to let go of it
+  for (const World::Contact& contact : contacts.getEnded())
+  {
+    Components::Collider* first = ColliderOf(contact.first);
+    Components::Collider* second = ColliderOf(contact.second);
+
+    if (first && second)
+    {
+      first->leaveCollision(second);
+      second->leaveCollision(first);
+    }
+    else if (first)
+    {
+      first->forgetCollision(contact.second);
+    }
+    else if (second)
+    {
+      second->forgetCollision(contact.first);
+    }
+  }
 }
 
 // render a scene's entities
@@ -174,6 +448,7 @@ Entities::Actor* Scene::Scene::createEntity(
   std::string modelName, 
   std::string textureName)
 {
+  Memory::PoolAllocator::Scope scope(arena);
   Entities::Actor* actor = new Entities::Actor();
   actor->setPosition(pos);
   actor->setScale(scale);
@@ -188,6 +463,7 @@ Entities::Actor* Scene::Scene::createEntity(
 // lets you fully customize your entity with different complexity levels
 Entities::Entity* Scene::Scene::instanceCreate(std::string name, Vector3D position)
 {
+  Memory::PoolAllocator::Scope scope(arena);
   Entities::Entity* actor = factory->createEntity(name, position);
   actor->transform->setPosition(position);
   add(actor);
@@ -196,17 +472,19 @@ Entities::Entity* Scene::Scene::instanceCreate(std::string name, Vector3D positi
 
 Entities::Entity* Scene::Scene::instanceCreateExt(std::string name, Vector3D position, Vector3D scale, Vector3D rotation)
 {
+  Memory::PoolAllocator::Scope scope(arena);
   Entities::Entity* actor = factory->createEntity(name, position);
   actor->transform->setScale(scale);
   actor->transform->setRotation(rotation);
   actor->transform->setPosition(position);
-  actor->sprite->setModel(name);
+  actor->get<Components::Sprite3D>()->setModel(name);
   add(actor);
   return actor;
 }
 
 Entities::Actor* Scene::Scene::instanceCreateGeneral(std::string name, std::string model, std::string texture, Vector3D position, Vector3D scale, Vector3D rotation)
 {
+  Memory::PoolAllocator::Scope scope(arena);
   Entities::Actor* actor = factory->createActor(name, position);
   actor->setScale(scale);
   actor->setRotation(rotation);
@@ -220,44 +498,41 @@ Entities::Actor* Scene::Scene::instanceCreateGeneral(std::string name, std::stri
 void Scene::Scene::add(Entities::Entity* entity)
 {
   rootList->add(entity);
-  entity->SetId(rootList->getSize());
 }
 
 void Scene::Scene::clear()
 {
-  globalList->clear();
+  // anything still queued never made it into the scene
+  commands.clear();
+
+  // entities are only deleted at the sync point, so flush them before anything they reference goes away
+  rootList->DeleteAllEntities();
+  rootList->sync();
+
   rootList->clear();
+  physicsWorld.clear();
+  names.clear();
+  queries.clear();
+  grid.clear();
+  contacts.clear();
+  islands.clear();
+  spatial.clear();
+  hierarchy.clear();
+
+  // whatever init creates gets baked on the first update
+  bakePending = true;
+
+  // everything we spawned is gone now, so give back the slabs of any pool that has nothing live left
+  arena.trim();
 }
 
 // pick an entity from a scene given an origin vector and a direction, finds the first one
 Entities::Entity* Scene::Scene::RayPick(Vector3D origin, Vector3D dir)
 {
-  float closestDistance = FLT_MAX;
-  Entities::Entity* closestEntity = nullptr;
-
-  for (const auto& entity : rootList->getEntities())
-  {
-    if (!entity->isVisible())
-      continue;
-
-    Components::BoundingBox* box = getComponentOfType(BoundingBox,entity);
-    if (!box)
-      continue;
-
-    if ((box->min == 0 && box->max == 0))
-      continue;
+  // the editor picks while paused, so pick up anything spawned, moved or deleted since the last update
+  queries.flush();
+  spatial.sync(*located);
 
-    float distance;
-    if (Vector3D::RayIntersectsBoundingBox(origin, dir, box, distance))
-    {
-      if (distance < closestDistance)
-      {
-        closestDistance = distance;
-        closestEntity = entity;
-      }
-    }
-  }
-
-  return closestEntity;
+  World::RayHit hit = spatial.raycast(World::Ray(origin, dir), [](Entities::Entity* entity) { return entity->isVisible(); });
+  return hit.entity;
 }
-
@@ -8,6 +8,17 @@
 
 #pragma once
 #include "Engine/Entity/EntityList/EntityList.h"
+#include "Engine/Entity/EntityList/CommandBuffer.h"
+#include "Engine/Entity/EntityList/NameIndex.h"
+#include "Engine/Entity/EntityList/QueryIndex.h"
+#include "Engine/Entity/Hierarchy/TransformHierarchy.h"
+#include "Engine/Systems/Update/UpdatePipeline.h"
+#include "Engine/Systems/World/Grid.h"
+#include "Engine/Systems/World/Narrowphase.h"
+#include "Engine/Systems/World/ContactCache.h"
+#include "Engine/Systems/World/Islands.h"
+#include "Engine/Systems/World/PhysicsWorld.h"
+#include "Engine/Systems/World/SpatialIndex.h"
 #include "Engine/Entity/Entity.h"
 #include "Engine/Entity/EntityFactory.h"
 #include "Engine/GlowEngine.h"
@@ -21,6 +32,7 @@ namespace Scene
   public:
 
     Scene();
+    virtual ~Scene();
 
     virtual void init() {};
     virtual void update() {};
@@ -40,6 +52,8 @@ namespace Scene
     void renderEntities();
 
     std::string getName() { return name; }
+    // the map LoadScene and SaveScene use is named after us
+    void setName(const std::string& val) { name = val; }
 
     // create an entity directly to this scene with already made components
     Entities::Actor* createEntity(Vector3D pos, Vector3D scale, Vector3D rotation, std::string modelName, std::string textureName = "");
@@ -54,28 +68,89 @@ namespace Scene
     // clear all entities
     void clear();
 
-    // get our global list
-    Entities::EntityList* getGlobalList() { return globalList; }
     Entities::EntityList* getRootList() { return rootList; }
     int getEntityCount() { return (int)rootList->getEntities().size(); }
+    // queue spawns, destroys, moves and component changes here while entities are updating
+    Entities::CommandBuffer& getCommandBuffer() { return commands; }
+    // the per component type update passes and their timings
+    Systems::UpdatePipeline& getUpdatePipeline() { return pipeline; }
+
+    // find an entity anywhere in the scene by name
+    Entities::Entity* find(const std::string& entityName) { return names.find(entityName); }
+    // unique names of every entity in the scene
+    Entities::NameIndex& getNameIndex() { return names; }
+    // cached views of every entity in the scene matching a component and flag signature
+    const Entities::QueryView& query(const Entities::Query& signature) { return queries.view(signature); }
+    Entities::QueryIndex& getQueryIndex() { return queries; }
+    // broadphase of every collider in the scene
+    World::Grid& getGrid() { return grid; }
+    // every pair of colliders touching this frame
+    const World::ContactCache& getContacts() const { return contacts; }
+    // groups of touching bodies that sleep and wake together
+    const World::Islands& getIslands() const { return islands; }
+    // velocity, acceleration and flags of every body while the game runs
+    World::PhysicsWorld& getPhysicsWorld() { return physicsWorld; }
+    // ray, overlap and nearest queries over every entity with bounds
+    World::SpatialIndex& getSpatialIndex() { return spatial; }
+    // parent/child relationships between entity transforms
+    Entities::TransformHierarchy& getHierarchy() { return hierarchy; }
+    // pools the scene's entities and components come from; bind it with a PoolAllocator::Scope to spawn into it
+    // entities from it die with the scene, so one moving to another scene has to be copied with that scene's bound
+    Memory::PoolAllocator& getArena() { return arena; }
 
     // cast a ray and grab an entity from our scene
     Entities::Entity* RayPick(Vector3D origin, Vector3D dir);
 
   protected:
 
+    // declared first so it outlives anything below that could still hand a block back
+    Memory::PoolAllocator arena;
+
+    // test every moving collider against the colliders the grid and the static tree find near it
+    void checkCollisions();
+    // size the grid's cells to the colliders that move, called when the static tree is baked
+    void fitGrid();
+    // send this frame's began, stayed and ended contacts to the colliders, one kind at a time
+    void dispatchContacts();
+
     // system pointers
     Engine::GlowEngine* engine;
     Input::InputSystem* input;
 
     std::string name;
 
-    // entity list of all colliders
-    Entities::EntityList* globalList;
     // dummy list that contains all entities for statistics
     Entities::EntityList* rootList;
     // entity factory
     Entities::EntityFactory* factory;
+    // structural changes recorded during the frame, applied after every list has updated
+    Entities::CommandBuffer commands;
+    // updates every gathered component one type at a time
+    Systems::UpdatePipeline pipeline;
+    // name to entity for every list under the root list
+    Entities::NameIndex names;
+    // views over every list under the root list, updated as entities change instead of rebuilt each frame
+    Entities::QueryIndex queries;
+    const Entities::QueryView* colliders;
+    const Entities::QueryView* movingColliders;
+    const Entities::QueryView* located;
+    const Entities::QueryView* bodies;
+    // integrates every body in one pass; only holds them while the game runs
+    World::PhysicsWorld physicsWorld;
+    // finds the moving colliders, and static ones that aren't baked, each moving collider could be touching
+    World::Grid grid;
+    std::vector<Entities::Entity*> candidates;
+    // tests moving colliders against their candidates over the job system
+    World::Narrowphase narrowphase;
+    // pairs the narrowphase found touching, remembered across frames to tell when they begin and end
+    World::ContactCache contacts;
+    // puts bodies that have stopped moving to sleep, a touching group at a time
+    World::Islands islands;
+    // entities that don't move are baked once the scene is loaded, the rest are kept in a dynamic tree
+    World::SpatialIndex spatial;
+    bool bakePending = true;
+    // propagates parent world matrices to children after the transform pass
+    Entities::TransformHierarchy hierarchy;
 
   };
 
@@ -13,6 +13,14 @@
 Scene::SceneSystem::SceneSystem(std::string systemName) 
   : System(systemName)
 {
+  // entities read input, move the camera and play sounds; behaviors can touch any component
+  readsResource(Systems::Resource::Input);
+  readsResource(Systems::Resource::Assets);
+  writesResource(Systems::Resource::Scene);
+  writesResource(Systems::Resource::Renderer);
+  writesResource(Systems::Resource::Audio);
+  writesAllComponents();
+
   addScene("ForestScene");
   currentScene = nullptr;
 }
@@ -20,6 +28,7 @@ Scene::SceneSystem::SceneSystem(std::string systemName)
 // update all entities within the scene
 void Scene::SceneSystem::update()
 {
+  Memory::PoolAllocator::Scope scope(currentScene->getArena());
   currentScene->update();
   currentScene->updateEntities();
 
@@ -21,3 +21,20 @@ Systems::System::System(std::string systemName)
   input = engine->getInputSystem();
   SystemInstance::addSystem(this);
 }
+
+bool Systems::SystemAccess::conflictsWith(const SystemAccess& other) const
+{
+  // we don't know what they touch, so assume the worst
+  if (!declared || !other.declared)
+    return true;
+
+  // write/write
+  if ((writeComponents & other.writeComponents) || (writeResources & other.writeResources))
+    return true;
+
+  // read/write in either direction
+  if ((writeComponents & other.readComponents) || (readComponents & other.writeComponents))
+    return true;
+
+  return (writeResources & other.readResources) || (readResources & other.writeResources);
+}
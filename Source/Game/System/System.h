@@ -7,6 +7,7 @@
 */
 
 #pragma once
+#include <cstdint>
 
 namespace Input { class InputSystem; }
 namespace Scene { class Scene; class SceneSystem; }
@@ -14,6 +15,31 @@ namespace Scene { class Scene; class SceneSystem; }
 namespace Systems
 {
 
+  // shared engine state a system can touch besides components
+  enum class Resource
+  {
+    Input,
+    Audio,
+    Renderer,
+    Scene,
+    Assets,
+    Count
+  };
+
+  // what a system reads and writes; the scheduler orders systems that conflict and runs the rest side by side
+  struct SystemAccess
+  {
+    std::uint32_t readComponents = 0; // one bit per component type
+    std::uint32_t writeComponents = 0;
+    std::uint32_t readResources = 0; // one bit per resource
+    std::uint32_t writeResources = 0;
+    bool declared = false; // a system that never declares anything is treated as touching everything
+    bool mainThread = true; // windows, d3d and imgui calls have to stay on the main thread
+
+    // if running the two systems at the same time could race
+    bool conflictsWith(const SystemAccess& other) const;
+  };
+
   class System
   {
 
@@ -32,6 +58,13 @@ namespace Systems
     bool IsSimulation() { return isSimulation; }
     void SetAsSimulation(bool val) { isSimulation = val; }
 
+    // fixed step systems update once per simulation step, the rest once per frame
+    bool IsFixedStep() { return isFixedStep; }
+    void SetFixedStep(bool val) { isFixedStep = val; }
+
+    // what this system touches, declared in its constructor
+    const SystemAccess& getAccess() const { return access; }
+
     // all systems have access to core engine and other important systems
     Engine::GlowEngine* engine;
     Input::InputSystem* input;
@@ -39,8 +72,24 @@ namespace Systems
 
   protected:
 
+    // declare the component classes we read or write
+    template <typename... T>
+    void readsComponents() { access.readComponents |= ((std::uint32_t(1) << T::SlotOf(T::StaticType)) | ...); access.declared = true; }
+    template <typename... T>
+    void writesComponents() { access.writeComponents |= ((std::uint32_t(1) << T::SlotOf(T::StaticType)) | ...); access.declared = true; }
+    void writesAllComponents() { access.writeComponents = ~std::uint32_t(0); access.declared = true; }
+
+    // declare the engine resources we read or write
+    void readsResource(Resource resource) { access.readResources |= std::uint32_t(1) << (int)resource; access.declared = true; }
+    void writesResource(Resource resource) { access.writeResources |= std::uint32_t(1) << (int)resource; access.declared = true; }
+
+    // let the scheduler run us on a worker thread
+    void SetMainThreadOnly(bool val) { access.mainThread = val; }
+
     std::string name;
     bool isSimulation = false;
+    bool isFixedStep = false;
+    SystemAccess access;
 
   };
 
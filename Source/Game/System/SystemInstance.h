@@ -19,7 +19,7 @@ public:
   static void addSystem(Systems::System* system);
 
   // get the systems vector
-  static std::vector<Systems::System*> getSystems() { return systems; }
+  static const std::vector<Systems::System*>& getSystems() { return systems; }
 
 private:
 
@@ -0,0 +1,215 @@
+/*
+/
+// filename: SystemScheduler.cpp
+// author: Callen Betts
+// brief: implements SystemScheduler.h
+/
+*/
+
+#include "stdafx.h"
+#include "SystemScheduler.h"
+#include "Engine/Systems/Jobs/JobSystem.h"
+#include "Engine/Systems/Benchmark/Benchmark.h"
+
+Systems::SystemScheduler::SystemScheduler(Jobs::JobSystem* jobs)
+  :
+  jobs(jobs)
+{
+}
+
+void Systems::SystemScheduler::build()
+{
+  const std::vector<Systems::System*>& systems = SystemInstance::getSystems();
+
+  nodes.clear();
+  nodes.resize(systems.size());
+  remaining = std::make_unique<std::atomic<int>[]>(systems.size());
+  levelCount = 0;
+
+  // every system waits on the earlier systems it conflicts with; registration order breaks the tie
+  for (int i = 0; i < (int)systems.size(); ++i)
+  {
+    Node& node = nodes[i];
+    node.system = systems[i];
+
+    for (int j = 0; j < i; ++j)
+    {
+      if (systems[i]->getAccess().conflictsWith(systems[j]->getAccess()))
+      {
+        node.dependencies.push_back(j);
+        nodes[j].dependents.push_back(i);
+        node.level = (std::max)(node.level, nodes[j].level + 1);
+      }
+    }
+
+    levelCount = (std::max)(levelCount, node.level + 1);
+  }
+
+  Logger::write("Scheduled " + std::to_string(nodes.size()) + " systems in " + std::to_string(levelCount) + " levels");
+  for (const Node& node : nodes)
+  {
+    Logger::write("  " + std::to_string(node.level) + ": " + node.system->getName() + (node.system->getAccess().mainThread ? " (main thread)" : ""));
+  }
+}
+
+void Systems::SystemScheduler::run(bool paused_, bool fixedStep_)
+{
+  // a system was added since the last build
+  if (nodes.size() != SystemInstance::getSystems().size())
+  {
+    build();
+  }
+
+  paused = paused_;
+  fixedStep = fixedStep_;
+  unfinished = (int)nodes.size();
+
+  for (int i = 0; i < (int)nodes.size(); ++i)
+  {
+    remaining[i] = (int)nodes[i].dependencies.size();
+  }
+
+  for (int i = 0; i < (int)nodes.size(); ++i)
+  {
+    if (nodes[i].dependencies.empty())
+    {
+      dispatch(i);
+    }
+  }
+
+  // main thread join; run our own systems in registration order and help the workers with the rest
+  while (unfinished.load(std::memory_order_acquire) > 0)
+  {
+    int next = -1;
+    {
+      std::lock_guard<std::mutex> lock(readyMutex);
+      if (!mainReady.empty())
+      {
+        auto it = std::min_element(mainReady.begin(), mainReady.end());
+        next = *it;
+        mainReady.erase(it);
+      }
+    }
+
+    if (next >= 0)
+    {
+      execute(next);
+    }
+    else if (!jobs || !jobs->help())
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void Systems::SystemScheduler::dispatch(int index)
+{
+  if (!jobs || nodes[index].system->getAccess().mainThread)
+  {
+    std::lock_guard<std::mutex> lock(readyMutex);
+    mainReady.push_back(index);
+    return;
+  }
+
+  jobs->run([this, index]() { execute(index); });
+}
+
+void Systems::SystemScheduler::execute(int index)
+{
+  Node& node = nodes[index];
+
+  // systems of the other kind aren't part of this run, they only release whoever depends on them
+  const bool inRun = node.system->IsFixedStep() == fixedStep;
+
+  // systems that are simulations still run when paused
+  if (inRun)
+  {
+    node.skipped = paused && !node.system->IsSimulation();
+  }
+
+  if (inRun && !node.skipped)
+  {
+#ifdef _DEBUG
+    // a system waiting on jobs can pick up another system's node, so put back whoever was running
+    Node* previous = running;
+    running = &node;
+#endif
+
+    Benchmark::Stopwatch timer;
+    node.system->update();
+    node.time = timer.elapsed();
+    node.averageTime += (node.time - node.averageTime) * 0.05;
+
+#ifdef _DEBUG
+    running = previous;
+#endif
+  }
+  else if (inRun)
+  {
+    node.time = 0;
+  }
+
+  // release whoever was only waiting on us
+  for (int dependent : node.dependents)
+  {
+    if (remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      dispatch(dependent);
+    }
+  }
+
+  unfinished.fetch_sub(1, std::memory_order_release);
+}
+
+#ifdef _DEBUG
+void Systems::SystemScheduler::CheckWrite(int type)
+{
+  // writes made outside of a system, like loading or a world stepping, aren't scheduled
+  if (!running || type < 0 || type >= 32)
+    return;
+
+  const std::uint32_t bit = std::uint32_t(1) << type;
+  if ((running->system->getAccess().writeComponents & bit) || (running->reportedWrites & bit))
+    return;
+
+  running->reportedWrites |= bit;
+  Logger::error("Undeclared write: " + running->system->getName() + " writes component type " + std::to_string(type)
+    + " without declaring it, so it can race with the systems scheduled next to it");
+}
+#endif
+
+bool Systems::SystemScheduler::exportTimings(const std::string& filePath) const
+{
+  nlohmann::json data;
+  data["levels"] = levelCount;
+
+  for (const Node& node : nodes)
+  {
+    nlohmann::json nodeData;
+    nodeData["name"] = node.system->getName();
+    nodeData["level"] = node.level;
+    nodeData["mainThread"] = node.system->getAccess().mainThread;
+    nodeData["lastMs"] = node.time;
+    nodeData["averageMs"] = node.averageTime;
+
+    nlohmann::json dependencies = nlohmann::json::array();
+    for (int dependency : node.dependencies)
+    {
+      dependencies.push_back(nodes[dependency].system->getName());
+    }
+    nodeData["dependsOn"] = dependencies;
+
+    data["systems"].push_back(nodeData);
+  }
+
+  std::ofstream file(filePath);
+  if (!file.is_open())
+  {
+    Logger::error("Failed to export system schedule to " + filePath);
+    return false;
+  }
+
+  file << data.dump(4);
+  Logger::write("Exported system schedule to " + filePath);
+  return true;
+}
@@ -0,0 +1,108 @@
+/*
+/
+// filename: SystemScheduler.h
+// author: Callen Betts
+// brief: defines the scheduler that runs the engine's systems as a dependency graph
+//
+// description: Every system declares the component types and engine resources it reads and writes. The
+//  scheduler builds a graph once: a system depends on every earlier registered system it conflicts with, so the
+//  registration order is kept wherever it matters. Each run a system starts as soon as everything it depends on
+//  has finished. Systems that don't need the main thread run on the job system alongside the ones that do.
+//
+//  The engine runs the graph twice over: once a frame for input, audio and the like, and once per fixed step for
+//  the scene simulation. Each run only updates the systems of its own kind; the others count as already done.
+//
+//  Since conflicting declarations are always ordered, two systems can only race on something one of them never
+//  declared. Debug builds remember which system is running on each thread, and the places that write components
+//  (the update passes, adding and removing components) report a write to a component type the running system
+//  didn't declare.
+/
+*/
+
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace Jobs
+{
+  class JobSystem;
+}
+
+namespace Systems
+{
+  class System;
+
+  class SystemScheduler
+  {
+
+  public:
+
+    // a system in the graph
+    struct Node
+    {
+      Systems::System* system = nullptr;
+      std::vector<int> dependencies; // nodes that have to finish before us
+      std::vector<int> dependents; // nodes waiting on us
+      int level = 0; // longest chain of dependencies before us, nodes on the same level can run together
+      double time = 0; // last frame in milliseconds
+      double averageTime = 0;
+      bool skipped = false; // didn't run last frame because we are paused
+#ifdef _DEBUG
+      std::uint32_t reportedWrites = 0; // undeclared component writes already logged, so each is only logged once
+#endif
+    };
+
+    SystemScheduler(Jobs::JobSystem* jobs);
+
+    // build the graph from the registered systems
+    void build();
+    // run every fixed step system, or every per frame one, once; when paused, only simulation systems update
+    void run(bool paused, bool fixedStep);
+
+    const std::vector<Node>& getNodes() const { return nodes; }
+    int getLevelCount() const { return levelCount; }
+
+    // write the graph and the latest timings as json
+    bool exportTimings(const std::string& filePath = "Data/Temp/SystemSchedule.json") const;
+
+#ifdef _DEBUG
+    // report a write to a component type the system running on this thread never declared
+    static void CheckWrite(int type);
+#endif
+
+  private:
+
+    // hand a node whose dependencies are done to a thread
+    void dispatch(int index);
+    void execute(int index);
+
+#ifdef _DEBUG
+    // the node executing on this thread, nullptr outside of a system's update
+    static inline thread_local Node* running = nullptr;
+#endif
+
+    Jobs::JobSystem* jobs;
+
+    std::vector<Node> nodes;
+    std::unique_ptr<std::atomic<int>[]> remaining; // dependencies left this frame
+    int levelCount = 0;
+
+    bool paused = false;
+    bool fixedStep = false;
+    std::atomic<int> unfinished{ 0 };
+
+    // nodes that are ready but have to run on the main thread
+    std::mutex readyMutex;
+    std::vector<int> mainReady;
+
+  };
+
+}
+
+// put where a component type gets written; debug builds report it if the running system didn't declare the write
+#ifdef _DEBUG
+#define CHECK_COMPONENT_WRITE(TYPE) Systems::SystemScheduler::CheckWrite(TYPE)
+#else
+#define CHECK_COMPONENT_WRITE(TYPE) ((void)0)
+#endif